@@ -0,0 +1,90 @@
+#include "bench_util.h"
+#include "../include/map.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Compares string hash throughput across key lengths: byte-at-a-time
+ * FNV-1a and Bernstein against the word-at-a-time wyhash-style hash, both
+ * on C strings and on byte ranges of known length.
+ *
+ * Usage: bench_hash [key_bytes ...]   (default: 8 16 32 64 256 1024 4096)
+ */
+
+#define BENCH_HASH_KEYS 64
+#define BENCH_HASH_BYTES (256L * 1024L * 1024L)
+
+static uint64_t hash_fnv1a64(const char *key, size_t len) {
+    (void)len;
+    return fnv1a_hash64(key);
+}
+
+static uint64_t hash_bernstein(const char *key, size_t len) {
+    (void)len;
+    return (uint64_t)bernstein_hash((void *)(uintptr_t)key, INT_MAX);
+}
+
+static uint64_t hash_wyhash64(const char *key, size_t len) {
+    (void)len;
+    return wyhash64(key);
+}
+
+static uint64_t hash_bytes(const char *key, size_t len) {
+    return hash_bytes64(key, len, 0);
+}
+
+static void run_hash(const char *name, uint64_t (*hash)(const char *, size_t), char **keys, long len) {
+    long rounds = BENCH_HASH_BYTES / (len * BENCH_HASH_KEYS);
+    if (rounds < 1) {
+        rounds = 1;
+    }
+
+    uint64_t sink = 0;
+    double t0 = bench_now();
+    for (long r = 0; r < rounds; r++) {
+        for (int k = 0; k < BENCH_HASH_KEYS; k++) {
+            sink += hash(keys[k], (size_t)len);
+        }
+    }
+    double t1 = bench_now();
+
+    long ops = rounds * BENCH_HASH_KEYS;
+    double seconds = t1 - t0;
+    double gbps = seconds > 0.0 ? (double)ops * (double)len / seconds / 1e9 : 0.0;
+    printf("%-12s %6ld B  %8.2f Mhash/s  %7.2f GB/s  (sink %016llx)\n", name, len,
+           bench_mops(ops, seconds), gbps, (unsigned long long)sink);
+}
+
+int main(int argc, char **argv) {
+    static const long defaults[] = {8, 16, 32, 64, 256, 1024, 4096};
+    long sizes[16];
+    int count = bench_parse_sizes(argc, argv, defaults, 7, sizes, 16);
+
+    for (int s = 0; s < count; s++) {
+        long len = sizes[s];
+        char *storage = malloc((size_t)BENCH_HASH_KEYS * (size_t)(len + 1));
+        if (!storage) {
+            printf("skipping %ld-byte keys: out of memory\n", len);
+            continue;
+        }
+
+        char *keys[BENCH_HASH_KEYS];
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (int k = 0; k < BENCH_HASH_KEYS; k++) {
+            keys[k] = storage + (size_t)k * (size_t)(len + 1);
+            for (long i = 0; i < len; i++) {
+                keys[k][i] = (char)('a' + bench_rand(&state) % 26);
+            }
+            keys[k][len] = '\0';
+        }
+
+        run_hash("fnv1a_hash64", hash_fnv1a64, keys, len);
+        run_hash("bernstein", hash_bernstein, keys, len);
+        run_hash("wyhash64", hash_wyhash64, keys, len);
+        run_hash("hash_bytes64", hash_bytes, keys, len);
+        free(storage);
+    }
+    return 0;
+}
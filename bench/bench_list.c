@@ -0,0 +1,71 @@
+#include "bench_util.h"
+#include "../include/list.h"
+
+#include <stdint.h>
+
+/*
+ * Builds ARRAY_LIST, LINKED_LIST and UNROLLED_LIST by appending, scans them
+ * in order with get(i), then times a fixed number of inserts and removes at
+ * random positions. Random updates walk LINKED_LIST node by node, so it is
+ * skipped above 200000 elements, where it takes minutes.
+ *
+ * Usage: bench_list [elements...]
+ *        (defaults: 10000 100000 1000000)
+ */
+
+#define LINKED_LIMIT 200000L
+#define RANDOM_OPS 20000L
+
+static void run(const char *name, ListType type, long n) {
+    static int payload;
+    list *lst = create_list(type, 16, NULL);
+    if (!lst) {
+        return;
+    }
+    for (long i = 0; i < n; i++) {
+        lst->insert(lst, &payload, (int)i);
+    }
+
+    double t0 = bench_now();
+    for (long i = 0; i < n; i++) {
+        (void)lst->get(lst, (int)i);
+    }
+    double scan = bench_now() - t0;
+
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    t0 = bench_now();
+    for (long i = 0; i < RANDOM_OPS; i++) {
+        int size = lst->size(lst);
+        lst->insert(lst, &payload, (int)(bench_rand(&state) % (uint64_t)(size + 1)));
+    }
+    double insert = bench_now() - t0;
+
+    t0 = bench_now();
+    for (long i = 0; i < RANDOM_OPS; i++) {
+        int size = lst->size(lst);
+        lst->remove(lst, (int)(bench_rand(&state) % (uint64_t)size));
+    }
+    double remove = bench_now() - t0;
+
+    printf("%-14s %10ld %14.2f %14.2f %14.2f\n", name, n, bench_mops(n, scan), bench_mops(RANDOM_OPS, insert),
+           bench_mops(RANDOM_OPS, remove));
+    lst->free(lst);
+}
+
+int main(int argc, char **argv) {
+    static const long defaults[] = {10000L, 100000L, 1000000L};
+    long sizes[8];
+    int count = bench_parse_sizes(argc, argv, defaults, 3, sizes, 8);
+
+    printf("%-14s %10s %14s %14s %14s\n", "backend", "elements", "scan Mops/s", "insert Mops/s",
+           "remove Mops/s");
+    for (int c = 0; c < count; c++) {
+        long n = sizes[c];
+        run("ARRAY_LIST", ARRAY_LIST, n);
+        if (n <= LINKED_LIMIT) {
+            run("LINKED_LIST", LINKED_LIST, n);
+        }
+        run("UNROLLED_LIST", UNROLLED_LIST, n);
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "bench_util.h"
+#include "../include/int_map.h"
+#include "../include/map.h"
+
+#include <stdint.h>
+
+/*
+ * Compares get/put/remove throughput of the chained map (with malloc'd and
+ * slab-pooled entries), the flat map, and the integer-keyed int_map, which
+ * stores the same keys inline without hash or comparator callbacks.
+ *
+ * Usage: bench_map [n ...]   (default: 1000000 10000000 50000000)
+ */
+
+static int u64_compare(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static int u64_hash(void *key, int capacity) {
+    uint64_t x = *(const uint64_t *)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (int)(x % (uint64_t)capacity);
+}
+
+static void run_backend(const char *name, map_type type, int pooled, uint64_t *keys, long n) {
+    map *m = pooled ? create_map_with_pool(type, 16, u64_hash, u64_compare, NULL)
+                    : create_map(type, 16, u64_hash, u64_compare);
+    if (!m) {
+        printf("%-8s %12ld  create failed\n", name, n);
+        return;
+    }
+
+    double t0 = bench_now();
+    for (long i = 0; i < n; i++) {
+        m->put(m, &keys[i], &keys[i]);
+    }
+    double t1 = bench_now();
+
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        hits += m->get(m, &keys[(i * 7919) % n]) != NULL;
+    }
+    double t2 = bench_now();
+
+    enum { BATCH = 1024 };
+    void *batch_keys[BATCH];
+    void *batch_values[BATCH];
+    long bulk_hits = 0;
+    for (long base = 0; base < n; base += BATCH) {
+        int count = n - base < BATCH ? (int)(n - base) : BATCH;
+        for (int j = 0; j < count; j++) {
+            batch_keys[j] = &keys[((base + j) * 7919) % n];
+        }
+        m->get_bulk(m, batch_keys, batch_values, count);
+        for (int j = 0; j < count; j++) {
+            bulk_hits += batch_values[j] != NULL;
+        }
+    }
+    double t2b = bench_now();
+
+    for (long i = 0; i < n; i++) {
+        m->remove(m, &keys[i]);
+    }
+    double t3 = bench_now();
+
+    printf("%-8s %12ld  put %8.2f Mops/s  get %8.2f Mops/s  get_bulk %8.2f Mops/s  "
+           "remove %8.2f Mops/s  (hits %ld/%ld)\n",
+           name, n, bench_mops(n, t1 - t0), bench_mops(n, t2 - t1), bench_mops(n, t2b - t2),
+           bench_mops(n, t3 - t2b), hits, bulk_hits);
+    m->free(m);
+}
+
+static void run_int_map(uint64_t *keys, long n) {
+    int_map *m = create_int_map(16);
+    if (!m) {
+        printf("%-8s %12ld  create failed\n", "int_map", n);
+        return;
+    }
+
+    double t0 = bench_now();
+    for (long i = 0; i < n; i++) {
+        int_map_put(m, keys[i], &keys[i]);
+    }
+    double t1 = bench_now();
+
+    long hits = 0;
+    for (long i = 0; i < n; i++) {
+        hits += int_map_contains(m, keys[(i * 7919) % n]);
+    }
+    double t2 = bench_now();
+
+    for (long i = 0; i < n; i++) {
+        int_map_remove(m, keys[i], NULL);
+    }
+    double t3 = bench_now();
+
+    printf("%-8s %12ld  put %8.2f Mops/s  get %8.2f Mops/s  get_bulk %8s        "
+           "remove %8.2f Mops/s  (hits %ld/%ld)\n",
+           "int_map", n, bench_mops(n, t1 - t0), bench_mops(n, t2 - t1), "-", bench_mops(n, t3 - t2),
+           hits, n);
+    int_map_free(m);
+}
+
+int main(int argc, char **argv) {
+    static const long defaults[] = {1000000L, 10000000L, 50000000L};
+    long sizes[16];
+    int count = bench_parse_sizes(argc, argv, defaults, 3, sizes, 16);
+
+    for (int s = 0; s < count; s++) {
+        long n = sizes[s];
+        uint64_t *keys = malloc((size_t)n * sizeof(uint64_t));
+        if (!keys) {
+            printf("skipping n=%ld: out of memory\n", n);
+            continue;
+        }
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (long i = 0; i < n; i++) {
+            keys[i] = bench_rand(&state);
+        }
+
+        run_backend("chained", HASH_MAP, 0, keys, n);
+        run_backend("pooled", HASH_MAP, 1, keys, n);
+        run_backend("flat", HASH_MAP_FLAT, 0, keys, n);
+        run_int_map(keys, n);
+        free(keys);
+    }
+    return 0;
+}
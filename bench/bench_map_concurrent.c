@@ -0,0 +1,118 @@
+#include "bench_util.h"
+#include "../include/map.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+/*
+ * Reports map throughput as the thread count grows from 1 to N for a
+ * configurable read/write mix, comparing the single-mutex HASH_TABLE with
+ * the segmented HASH_MAP_CONCURRENT backend.
+ *
+ * Usage: bench_map_concurrent [max_threads] [read_percent] [keys] [ops_per_thread]
+ *        (defaults: online CPUs, 90, 1000000, 2000000)
+ */
+
+typedef struct {
+    map *m;
+    uint64_t *keys;
+    long key_count;
+    long ops;
+    int read_percent;
+    uint64_t seed;
+} worker_arg;
+
+static int u64_compare(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static uint64_t u64_hash64(const void *key) {
+    uint64_t x = *(const uint64_t *)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static void *worker(void *arg) {
+    worker_arg *a = (worker_arg *)arg;
+    uint64_t state = a->seed;
+    for (long i = 0; i < a->ops; i++) {
+        uint64_t r = bench_rand(&state);
+        uint64_t *key = &a->keys[(long)(r % (uint64_t)a->key_count)];
+        int roll = (int)((r >> 40) % 100);
+        if (roll < a->read_percent) {
+            (void)a->m->get(a->m, key);
+        } else if (roll & 1) {
+            a->m->put(a->m, key, key);
+        } else {
+            a->m->remove(a->m, key);
+        }
+    }
+    return NULL;
+}
+
+static double run(map_type type, int threads, int read_percent, uint64_t *keys,
+                  long key_count, long ops) {
+    map *m = create_map_hash64(type, (int)key_count, u64_hash64, u64_compare);
+    if (!m) {
+        return 0.0;
+    }
+    for (long i = 0; i < key_count; i += 2) {
+        m->put(m, &keys[i], &keys[i]);
+    }
+
+    pthread_t tids[256];
+    worker_arg args[256];
+    double t0 = bench_now();
+    for (int t = 0; t < threads; t++) {
+        args[t] = (worker_arg){m, keys, key_count, ops, read_percent, 0x1234567ULL + (uint64_t)t * 7919};
+        pthread_create(&tids[t], NULL, worker, &args[t]);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    double elapsed = bench_now() - t0;
+
+    m->free(m);
+    return bench_mops(ops * threads, elapsed);
+}
+
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = argc > 1 ? atoi(argv[1]) : (int)(cpus > 0 ? cpus : 4);
+    int read_percent = argc > 2 ? atoi(argv[2]) : 90;
+    long key_count = argc > 3 ? atol(argv[3]) : 1000000L;
+    long ops = argc > 4 ? atol(argv[4]) : 2000000L;
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > 256) max_threads = 256;
+    if (key_count < 1) key_count = 1;
+
+    uint64_t *keys = malloc((size_t)key_count * sizeof(uint64_t));
+    if (!keys) {
+        return 1;
+    }
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (long i = 0; i < key_count; i++) {
+        keys[i] = bench_rand(&state);
+    }
+
+    printf("keys=%ld ops/thread=%ld reads=%d%%\n", key_count, ops, read_percent);
+    printf("%8s %18s %22s\n", "threads", "HASH_TABLE Mops/s", "HASH_MAP_CONCURRENT Mops/s");
+    for (int t = 1; t <= max_threads; t = (t * 2 <= max_threads || t == max_threads) ? t * 2 : max_threads) {
+        double locked = run(HASH_TABLE, t, read_percent, keys, key_count, ops);
+        double segmented = run(HASH_MAP_CONCURRENT, t, read_percent, keys, key_count, ops);
+        printf("%8d %18.2f %22.2f\n", t, locked, segmented);
+        if (t == max_threads) {
+            break;
+        }
+    }
+
+    free(keys);
+    return 0;
+}
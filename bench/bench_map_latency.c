@@ -0,0 +1,97 @@
+#include "bench_util.h"
+#include "../include/map.h"
+
+#include <stdint.h>
+
+/*
+ * Per-put latency distribution of the stop-the-world and incremental
+ * chained backends. Tail percentiles expose resize pauses that mean
+ * throughput hides.
+ *
+ * Usage: bench_map_latency [n ...]   (default: 1000000 10000000)
+ */
+
+static int u64_compare(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static uint64_t u64_hash64(const void *key) {
+    uint64_t x = *(const uint64_t *)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static int double_compare(const void *a, const void *b) {
+    double lhs = *(const double *)a;
+    double rhs = *(const double *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static double percentile(const double *sorted, long n, double p) {
+    long index = (long)(p * (double)(n - 1));
+    return sorted[index];
+}
+
+static void run_backend(const char *name, map_type type, uint64_t *keys, double *lat, long n) {
+    /* Untimed warm-up: the allocator pays for recycling the previous run's
+     * nodes here rather than inside the first timed put. */
+    map *warm = create_map_hash64(type, 16, u64_hash64, u64_compare);
+    if (warm) {
+        for (long i = 0; i < n && i < 4096; i++) {
+            warm->put(warm, &keys[i], &keys[i]);
+        }
+        warm->free(warm);
+    }
+
+    map *m = create_map_hash64(type, 16, u64_hash64, u64_compare);
+    if (!m) {
+        printf("%-12s %10ld  create failed\n", name, n);
+        return;
+    }
+
+    double start = bench_now();
+    for (long i = 0; i < n; i++) {
+        double t0 = bench_now();
+        m->put(m, &keys[i], &keys[i]);
+        lat[i] = bench_now() - t0;
+    }
+    double total = bench_now() - start;
+
+    qsort(lat, (size_t)n, sizeof(double), double_compare);
+    printf("%-12s %10ld  put %7.2f Mops/s  p50 %7.0f ns  p99 %7.0f ns  p99.9 %9.0f ns  max %12.0f ns\n",
+           name, n, bench_mops(n, total), percentile(lat, n, 0.50) * 1e9,
+           percentile(lat, n, 0.99) * 1e9, percentile(lat, n, 0.999) * 1e9, lat[n - 1] * 1e9);
+    m->free(m);
+}
+
+int main(int argc, char **argv) {
+    static const long defaults[] = {1000000L, 10000000L};
+    long sizes[16];
+    int count = bench_parse_sizes(argc, argv, defaults, 2, sizes, 16);
+
+    for (int s = 0; s < count; s++) {
+        long n = sizes[s];
+        uint64_t *keys = malloc((size_t)n * sizeof(uint64_t));
+        double *lat = malloc((size_t)n * sizeof(double));
+        if (!keys || !lat) {
+            fprintf(stderr, "allocation failed for n=%ld\n", n);
+            free(keys);
+            free(lat);
+            return 1;
+        }
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (long i = 0; i < n; i++) {
+            keys[i] = bench_rand(&state);
+        }
+
+        run_backend("chained", HASH_MAP, keys, lat, n);
+        run_backend("incremental", HASH_MAP_INCREMENTAL, keys, lat, n);
+        free(keys);
+        free(lat);
+    }
+    return 0;
+}
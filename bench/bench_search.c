@@ -0,0 +1,82 @@
+#include "bench_util.h"
+#include "../include/sort.h"
+
+#include <stdint.h>
+
+/*
+ * Looks up random keys (about half present) in a sorted list, one
+ * binary_search() call per key against a single binary_search_batch() call,
+ * and times min_max() over the same list.
+ *
+ * Usage: bench_search [elements...]
+ *        (defaults: 10000 1000000 10000000)
+ */
+
+static int u64_compare(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+int main(int argc, char **argv) {
+    static const long defaults[] = {10000L, 1000000L, 10000000L};
+    long sizes[8];
+    int count = bench_parse_sizes(argc, argv, defaults, 3, sizes, 8);
+    const long probes = 2000000L;
+
+    sorter *s = create_sorter(u64_compare);
+    uint64_t *wanted = malloc((size_t)probes * sizeof(uint64_t));
+    void **keys = malloc((size_t)probes * sizeof(void *));
+    int *out = malloc((size_t)probes * sizeof(int));
+    if (!s || !wanted || !keys || !out) {
+        return 1;
+    }
+
+    printf("%12s %14s %14s %14s\n", "elements", "single Mops/s", "batch Mops/s", "min_max ms");
+    for (int c = 0; c < count; c++) {
+        long n = sizes[c];
+        uint64_t *values = malloc((size_t)n * sizeof(uint64_t));
+        list *lst = create_list(ARRAY_LIST, (int)n, NULL);
+        if (!values || !lst) {
+            return 1;
+        }
+        /* Even keys only, so odd probes miss. */
+        for (long i = 0; i < n; i++) {
+            values[i] = (uint64_t)i * 2;
+            lst->insert(lst, &values[i], (int)i);
+        }
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (long i = 0; i < probes; i++) {
+            wanted[i] = bench_rand(&state) % ((uint64_t)n * 2);
+            keys[i] = &wanted[i];
+        }
+
+        long hits = 0;
+        double t0 = bench_now();
+        for (long i = 0; i < probes; i++) {
+            hits += s->binary_search(s, lst, keys[i]) >= 0;
+        }
+        double single = bench_now() - t0;
+
+        t0 = bench_now();
+        int found = s->binary_search_batch(s, lst, keys, (int)probes, out);
+        double batch = bench_now() - t0;
+
+        void *min = NULL;
+        void *max = NULL;
+        t0 = bench_now();
+        s->min_max(s, lst, &min, &max);
+        double min_max = bench_now() - t0;
+
+        printf("%12ld %14.2f %14.2f %14.3f%s\n", n, bench_mops(probes, single), bench_mops(probes, batch),
+               min_max * 1e3, hits == found ? "" : "  (hit counts differ)");
+        lst->free(lst);
+        free(values);
+    }
+
+    free(out);
+    free(keys);
+    free(wanted);
+    s->free(s);
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "bench_util.h"
+#include "../include/sort.h"
+
+#include <stdint.h>
+#include <unistd.h>
+
+/*
+ * Reports sort time for a list of random 64-bit keys as the thread count of
+ * create_parallel_sorter grows from 1 to N, next to the single-threaded
+ * quicksort, merge sort and radix sorters.
+ *
+ * Usage: bench_sort [max_threads] [elements]
+ *        (defaults: online CPUs, 5000000)
+ */
+
+static int u64_compare(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static uint64_t u64_key(const void *item) {
+    return *(const uint64_t *)item;
+}
+
+/* Seconds to sort a fresh copy of @p keys with @p s. */
+static double run(sorter *s, uint64_t *keys, long n) {
+    list *lst = create_list(ARRAY_LIST, (int)n, NULL);
+    if (!lst) {
+        return 0.0;
+    }
+    for (long i = 0; i < n; i++) {
+        lst->insert(lst, &keys[i], (int)i);
+    }
+
+    double t0 = bench_now();
+    s->sort(s, lst);
+    double elapsed = bench_now() - t0;
+
+    lst->free(lst);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = argc > 1 ? atoi(argv[1]) : (int)(cpus > 0 ? cpus : 4);
+    long n = argc > 2 ? atol(argv[2]) : 5000000L;
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > 256) max_threads = 256;
+    if (n < 2) n = 2;
+
+    uint64_t *keys = malloc((size_t)n * sizeof(uint64_t));
+    if (!keys) {
+        return 1;
+    }
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (long i = 0; i < n; i++) {
+        keys[i] = bench_rand(&state);
+    }
+
+    sorter *quick = create_sorter(u64_compare);
+    sorter *merge = create_merge_sorter(u64_compare);
+    sorter *radix = create_radix_sorter(u64_compare, u64_key);
+    if (!quick || !merge || !radix) {
+        return 1;
+    }
+    printf("elements=%ld\n", n);
+    printf("%-22s %10.3f s\n", "create_sorter", run(quick, keys, n));
+    double base = run(merge, keys, n);
+    printf("%-22s %10.3f s\n", "create_merge_sorter", base);
+    printf("%-22s %10.3f s\n", "create_radix_sorter", run(radix, keys, n));
+    quick->free(quick);
+    merge->free(merge);
+    radix->free(radix);
+
+    printf("%8s %12s %10s\n", "threads", "seconds", "speedup");
+    for (int t = 1; t <= max_threads; t = (t * 2 <= max_threads || t == max_threads) ? t * 2 : max_threads) {
+        sorter *parallel = create_parallel_sorter(u64_compare, t);
+        if (!parallel) {
+            break;
+        }
+        double elapsed = run(parallel, keys, n);
+        printf("%8d %12.3f %9.2fx\n", t, elapsed, elapsed > 0.0 ? base / elapsed : 0.0);
+        parallel->free(parallel);
+        if (t == max_threads) {
+            break;
+        }
+    }
+
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "bench_util.h"
+#include "../include/sort.h"
+
+#include <stdint.h>
+
+/*
+ * Sorts inputs that defeat naive quicksort pivots (sorted, reversed,
+ * sawtooth, all-equal, few distinct keys) and partially sorted inputs that
+ * adaptive sorts exploit (concatenated sorted batches, sorted with a few
+ * random swaps) next to a random baseline, with create_sorter,
+ * create_merge_sorter and create_tim_sorter.
+ *
+ * Usage: bench_sort_patterns [elements...]
+ *        (default: 1000000)
+ */
+
+typedef enum {
+    PATTERN_RANDOM,
+    PATTERN_SORTED,
+    PATTERN_REVERSED,
+    PATTERN_SAWTOOTH,
+    PATTERN_ALL_EQUAL,
+    PATTERN_FEW_UNIQUE,
+    PATTERN_SORTED_BATCHES,
+    PATTERN_NEARLY_SORTED,
+    PATTERN_COUNT
+} pattern;
+
+static const char *const pattern_names[PATTERN_COUNT] = {
+    "random", "sorted", "reversed", "sawtooth", "all-equal", "few-unique",
+    "batches", "nearly-sorted",
+};
+
+static int u64_compare(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static void fill(uint64_t *keys, long n, pattern p) {
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    long tooth = n / 16 > 0 ? n / 16 : 1;
+    for (long i = 0; i < n; i++) {
+        switch (p) {
+            case PATTERN_SORTED:
+                keys[i] = (uint64_t)i;
+                break;
+            case PATTERN_REVERSED:
+                keys[i] = (uint64_t)(n - i);
+                break;
+            case PATTERN_SAWTOOTH:
+                keys[i] = (uint64_t)(i % tooth);
+                break;
+            case PATTERN_ALL_EQUAL:
+                keys[i] = 7;
+                break;
+            case PATTERN_FEW_UNIQUE:
+                keys[i] = bench_rand(&state) % 16;
+                break;
+            case PATTERN_SORTED_BATCHES:
+                /* 16 sorted batches whose key ranges interleave. */
+                keys[i] = (uint64_t)(i % tooth) * 16 + (uint64_t)(i / tooth);
+                break;
+            case PATTERN_NEARLY_SORTED:
+                keys[i] = (uint64_t)i;
+                break;
+            case PATTERN_RANDOM:
+            case PATTERN_COUNT:
+            default:
+                keys[i] = bench_rand(&state);
+                break;
+        }
+    }
+    if (p == PATTERN_NEARLY_SORTED) {
+        for (long swaps = n / 100; swaps > 0; swaps--) {
+            size_t a = (size_t)(bench_rand(&state) % (uint64_t)n);
+            size_t b = (size_t)(bench_rand(&state) % (uint64_t)n);
+            uint64_t tmp = keys[a];
+            keys[a] = keys[b];
+            keys[b] = tmp;
+        }
+    }
+}
+
+/* Seconds to sort @p keys through @p s. */
+static double run(sorter *s, uint64_t *keys, long n) {
+    list *lst = create_list(ARRAY_LIST, (int)n, NULL);
+    if (!lst) {
+        return 0.0;
+    }
+    for (long i = 0; i < n; i++) {
+        lst->insert(lst, &keys[i], (int)i);
+    }
+
+    double t0 = bench_now();
+    s->sort(s, lst);
+    double elapsed = bench_now() - t0;
+
+    lst->free(lst);
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    static const long defaults[] = {1000000L};
+    long sizes[8];
+    int count = bench_parse_sizes(argc, argv, defaults, 1, sizes, 8);
+
+    sorter *quick = create_sorter(u64_compare);
+    sorter *merge = create_merge_sorter(u64_compare);
+    sorter *tim = create_tim_sorter(u64_compare);
+    if (!quick || !merge || !tim) {
+        return 1;
+    }
+
+    for (int s = 0; s < count; s++) {
+        long n = sizes[s];
+        uint64_t *keys = malloc((size_t)n * sizeof(uint64_t));
+        if (!keys) {
+            return 1;
+        }
+        printf("elements=%ld\n", n);
+        printf("%-14s %16s %22s %20s\n", "pattern", "create_sorter s", "create_merge_sorter s",
+               "create_tim_sorter s");
+        for (int p = 0; p < PATTERN_COUNT; p++) {
+            fill(keys, n, (pattern)p);
+            double q = run(quick, keys, n);
+            double m = run(merge, keys, n);
+            double t = run(tim, keys, n);
+            printf("%-14s %16.3f %22.3f %20.3f\n", pattern_names[p], q, m, t);
+        }
+        free(keys);
+    }
+
+    quick->free(quick);
+    merge->free(merge);
+    tim->free(tim);
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "bench_util.h"
+#include "../include/list.h"
+
+#include <stdint.h>
+
+/*
+ * Builds SORTED_LIST and SORTED_BLOCK_LIST from keys in random order, then
+ * reads them back in order with get(i) and removes every item at random
+ * positions. The flat backend shifts its tail on every insert and remove, so
+ * it is skipped above 200000 elements, where it takes minutes. The
+ * "SORTED_LIST bulk" row instead ingests the same keys through insert_bulk
+ * in unsorted batches of 100000 (no removes).
+ *
+ * Usage: bench_sorted_list [elements...]
+ *        (defaults: 10000 100000 1000000 10000000)
+ */
+
+#define FLAT_LIMIT 200000L
+#define BULK_BATCH 100000L
+
+static int u64_compare(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static void run(const char *name, ListType type, uint64_t *keys, long n) {
+    list *lst = create_list(type, 16, u64_compare);
+    if (!lst) {
+        return;
+    }
+
+    double t0 = bench_now();
+    for (long i = 0; i < n; i++) {
+        lst->insert(lst, &keys[i], 0);
+    }
+    double insert = bench_now() - t0;
+
+    t0 = bench_now();
+    for (long i = 0; i < n; i++) {
+        (void)lst->get(lst, (int)i);
+    }
+    double scan = bench_now() - t0;
+
+    uint64_t state = 0xD1B54A32D192ED03ULL;
+    t0 = bench_now();
+    for (long left = n; left > 0; left--) {
+        lst->remove(lst, (int)(bench_rand(&state) % (uint64_t)left));
+    }
+    double remove = bench_now() - t0;
+
+    printf("%-18s %10ld %14.2f %14.2f %14.2f\n", name, n, bench_mops(n, insert), bench_mops(n, scan),
+           bench_mops(n, remove));
+    lst->free(lst);
+}
+
+static void run_bulk(uint64_t *keys, long n) {
+    list *lst = create_list(SORTED_LIST, 16, u64_compare);
+    void **batch = malloc((size_t)BULK_BATCH * sizeof(void *));
+    if (!lst || !batch) {
+        free(batch);
+        return;
+    }
+
+    double t0 = bench_now();
+    for (long first = 0; first < n; first += BULK_BATCH) {
+        long count = n - first < BULK_BATCH ? n - first : BULK_BATCH;
+        for (long i = 0; i < count; i++) {
+            batch[i] = &keys[first + i];
+        }
+        lst->insert_bulk(lst, batch, (int)count);
+    }
+    double insert = bench_now() - t0;
+
+    t0 = bench_now();
+    for (long i = 0; i < n; i++) {
+        (void)lst->get(lst, (int)i);
+    }
+    double scan = bench_now() - t0;
+
+    printf("%-18s %10ld %14.2f %14.2f %14s\n", "SORTED_LIST bulk", n, bench_mops(n, insert),
+           bench_mops(n, scan), "-");
+    lst->free(lst);
+    free(batch);
+}
+
+int main(int argc, char **argv) {
+    static const long defaults[] = {10000L, 100000L, 1000000L, 10000000L};
+    long sizes[8];
+    int count = bench_parse_sizes(argc, argv, defaults, 4, sizes, 8);
+
+    printf("%-18s %10s %14s %14s %14s\n", "backend", "elements", "insert Mops/s", "get Mops/s",
+           "remove Mops/s");
+    for (int c = 0; c < count; c++) {
+        long n = sizes[c];
+        uint64_t *keys = malloc((size_t)n * sizeof(uint64_t));
+        if (!keys) {
+            return 1;
+        }
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (long i = 0; i < n; i++) {
+            keys[i] = bench_rand(&state);
+        }
+        if (n <= FLAT_LIMIT) {
+            run("SORTED_LIST", SORTED_LIST, keys, n);
+        }
+        run("SORTED_BLOCK_LIST", SORTED_BLOCK_LIST, keys, n);
+        run_bulk(keys, n);
+        free(keys);
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief Small helpers shared by the benchmark programs.
+ *
+ * Benchmarks are standalone programs; sizes come from the command line so a
+ * quick run and a full run use the same binary.
+ */
+
+/**
+ * @brief Return a monotonic timestamp in seconds.
+ */
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Return millions of operations per second.
+ */
+static inline double bench_mops(long ops, double seconds) {
+    return seconds > 0.0 ? (double)ops / seconds / 1e6 : 0.0;
+}
+
+/**
+ * @brief Deterministic xorshift64* generator so runs are comparable.
+ */
+static inline uint64_t bench_rand(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Parse positive sizes from argv, falling back to @p defaults.
+ *
+ * @return Number of sizes written to @p out (at most @p max).
+ */
+static inline int bench_parse_sizes(int argc, char **argv, const long *defaults,
+                                    int default_count, long *out, int max) {
+    int n = 0;
+    for (int i = 1; i < argc && n < max; i++) {
+        long v = strtol(argv[i], NULL, 10);
+        if (v > 0) {
+            out[n++] = v;
+        }
+    }
+    if (n == 0) {
+        for (int i = 0; i < default_count && i < max; i++) {
+            out[n++] = defaults[i];
+        }
+    }
+    return n;
+}
+
+#endif /* BENCH_UTIL_H */
@@ -0,0 +1,161 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include "types.h"
+
+#include <stdint.h>
+
+/**
+ * @file bitset.h
+ * @brief Growable bitset for sets of non-negative integers.
+ *
+ * One bit per possible member, stored in 64-bit words. Bulk union,
+ * intersection and difference run a word (or SIMD vector) at a time, the
+ * member count is kept current through popcounts, and rank/select queries use
+ * a per-block popcount index that is rebuilt lazily after mutation.
+ *
+ * A bitset is not thread-safe; rank and select update the index cache even
+ * though they take a const bitset.
+ */
+
+/**
+ * @brief Opaque bitset type.
+ */
+typedef struct bitset bitset;
+
+/**
+ * @brief Create an empty bitset.
+ *
+ * @param nbits Number of bits to preallocate; the set grows on demand.
+ * @return New bitset, or NULL on allocation failure.
+ */
+bitset *create_bitset(size_t nbits);
+
+/**
+ * @brief Create an independent copy of @p bs.
+ *
+ * @return New bitset, or NULL for a NULL input or allocation failure.
+ */
+bitset *bitset_clone(const bitset *bs);
+
+/**
+ * @brief Release the bitset.
+ *
+ * @param bs Bitset, or NULL.
+ */
+void bitset_free(bitset *bs);
+
+/**
+ * @brief Set @p bit, growing the bitset if needed.
+ *
+ * @return true when the bit was newly set; false when it was already set or
+ *         growing failed.
+ */
+bool bitset_add(bitset *bs, size_t bit);
+
+/**
+ * @brief Clear @p bit.
+ *
+ * @return true when the bit was set before the call.
+ */
+bool bitset_remove(bitset *bs, size_t bit);
+
+/**
+ * @brief Return true when @p bit is set.
+ */
+bool bitset_contains(const bitset *bs, size_t bit);
+
+/**
+ * @brief Return the number of set bits.
+ */
+size_t bitset_size(const bitset *bs);
+
+/**
+ * @brief Return how many bits are addressable without growing.
+ */
+size_t bitset_capacity(const bitset *bs);
+
+/**
+ * @brief Make bits [0, @p nbits) addressable without further growth.
+ *
+ * @return ::OVA_SUCCESS, ::OVA_ERROR_INVALID_ARG for a NULL bitset, or
+ *         ::OVA_ERROR_MEMORY.
+ */
+ova_error_code bitset_reserve(bitset *bs, size_t nbits);
+
+/**
+ * @brief Clear every bit, keeping the capacity.
+ */
+void bitset_clear(bitset *bs);
+
+/**
+ * @brief Set every bit of @p src in @p dst, growing @p dst if needed.
+ *
+ * @return ::OVA_SUCCESS, ::OVA_ERROR_INVALID_ARG for NULL arguments, or
+ *         ::OVA_ERROR_MEMORY.
+ */
+ova_error_code bitset_union_into(bitset *dst, const bitset *src);
+
+/**
+ * @brief Clear every bit of @p dst that is not set in @p src.
+ */
+void bitset_intersect_into(bitset *dst, const bitset *src);
+
+/**
+ * @brief Clear every bit of @p dst that is set in @p src.
+ */
+void bitset_difference_into(bitset *dst, const bitset *src);
+
+/**
+ * @brief Return the number of set bits strictly below @p bit.
+ */
+size_t bitset_rank(const bitset *bs, size_t bit);
+
+/**
+ * @brief Find the position of the set bit with rank @p k (0-based).
+ *
+ * @param bs Bitset.
+ * @param k Rank to look up; must be below bitset_size().
+ * @param out Receives the bit position.
+ * @return true when such a bit exists.
+ */
+bool bitset_select(const bitset *bs, size_t k, size_t *out);
+
+/**
+ * @brief Find the first set bit at or after @p from.
+ *
+ * @param bs Bitset.
+ * @param from First position to examine.
+ * @param out Receives the bit position.
+ * @return true when a set bit was found.
+ */
+bool bitset_next(const bitset *bs, size_t from, size_t *out);
+
+/**
+ * @brief Return the number of bytes bitset_serialize() writes for @p bs.
+ */
+size_t bitset_serialized_size(const bitset *bs);
+
+/**
+ * @brief Write @p bs to @p buf in a compact, endian-independent format.
+ *
+ * The encoder stores either the raw words up to the highest set bit or the
+ * varint-coded gaps between set bits, whichever is smaller.
+ *
+ * @param bs Bitset.
+ * @param buf Destination buffer.
+ * @param capacity Size of @p buf in bytes.
+ * @return Bytes written, or 0 when @p buf is too small or an argument is NULL.
+ */
+size_t bitset_serialize(const bitset *bs, void *buf, size_t capacity);
+
+/**
+ * @brief Rebuild a bitset from bitset_serialize() output.
+ *
+ * @param buf Serialized bytes.
+ * @param len Number of bytes in @p buf.
+ * @return New bitset, or NULL for malformed input or allocation failure.
+ */
+bitset *bitset_deserialize(const void *buf, size_t len);
+
+#endif // BITSET_H
@@ -127,4 +127,21 @@ typedef struct deque {
  */
 deque *create_deque(int capacity);
 
+/**
+ * @brief Create a deque that stores fixed-size values inline.
+ *
+ * Elements live in one ring buffer instead of behind one pointer each. The
+ * element pointers passed to push_front() and push_back() are read from:
+ * @p element_size bytes are copied out of each. get() and the peek methods
+ * return pointers into the deque's storage; the pop methods return a
+ * pointer to the removed value, which stays readable until the next push.
+ * clone_deep() copies values like clone_shallow() without calling the
+ * copier.
+ *
+ * @param element_size Size in bytes of each element; must be non-zero.
+ * @param capacity Initial capacity hint. Non-positive values use a default.
+ * @return New deque instance, or NULL on failure.
+ */
+deque *create_deque_of(size_t element_size, int capacity);
+
 #endif // DEQUE_H
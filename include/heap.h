@@ -138,4 +138,22 @@ typedef struct heap {
  */
 heap *create_heap(HeapType type, int capacity, comparator compare_function);
 
+/**
+ * @brief Create a heap that stores fixed-size values inline.
+ *
+ * put() copies @p element_size bytes from its item pointer into one
+ * contiguous array, and the comparator receives pointers to the stored
+ * values, as qsort's does. peek() returns a pointer into the array; pop()
+ * returns a pointer to the removed value, readable until the next put().
+ * Handle-based operations are not available.
+ *
+ * @param type The type of heap; only BINARY_HEAP is supported.
+ * @param element_size Size in bytes of each element; must be non-zero.
+ * @param capacity Initial capacity in elements.
+ * @param compare_function Comparator function used to order heap elements.
+ * @return A pointer to the new heap, or NULL on failure or an unsupported
+ *         @p type.
+ */
+heap *create_heap_of(HeapType type, size_t element_size, int capacity, comparator compare_function);
+
 #endif // HEAP_H
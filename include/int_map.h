@@ -0,0 +1,138 @@
+#ifndef INT_MAP_H
+#define INT_MAP_H
+
+#include "types.h"
+
+#include <stdint.h>
+
+/**
+ * @file int_map.h
+ * @brief Hash maps keyed by 64-bit integers.
+ *
+ * Keys are stored inline and compared by value, and buckets are chosen with a
+ * fixed integer mixer, so unlike ::map there is no key boxing and no hash or
+ * comparator call through a function pointer. The table is open-addressed
+ * with linear probing over a power-of-two slot array and deletes by shifting
+ * later entries back, so it never accumulates tombstones.
+ *
+ * Two specializations are generated from one template:
+ * - ::int_map maps `uint64_t` keys to `void *` values.
+ * - ::u64_map maps `uint64_t` keys to `uint64_t` values.
+ *
+ * Every `uint64_t`, including 0, is a valid key. Neither map is thread-safe.
+ */
+
+/**
+ * @brief Opaque map from `uint64_t` keys to `void *` values.
+ */
+typedef struct int_map int_map;
+
+/**
+ * @brief Create an integer-keyed map.
+ *
+ * @param capacity Number of entries to size for; values below 1 use a small
+ *                 default.
+ * @return New map, or NULL on allocation failure.
+ */
+int_map *create_int_map(int capacity);
+
+/**
+ * @brief Release the map. Values are not freed.
+ *
+ * @param m Map instance, or NULL.
+ */
+void int_map_free(int_map *m);
+
+/**
+ * @brief Insert or update the value stored under @p key.
+ *
+ * @param m Map instance.
+ * @param key Key.
+ * @param value Value to store.
+ * @return ::OVA_SUCCESS, ::OVA_ERROR_INVALID_ARG for a NULL map, or
+ *         ::OVA_ERROR_MEMORY if growing the table failed.
+ */
+ova_error_code int_map_put(int_map *m, uint64_t key, void *value);
+
+/**
+ * @brief Look up @p key.
+ *
+ * @param m Map instance.
+ * @param key Key.
+ * @param out Receives the value when found; may be NULL.
+ * @return true when @p key is present.
+ */
+bool int_map_get(const int_map *m, uint64_t key, void **out);
+
+/**
+ * @brief Return true when @p key is present.
+ */
+bool int_map_contains(const int_map *m, uint64_t key);
+
+/**
+ * @brief Remove @p key.
+ *
+ * @param m Map instance.
+ * @param key Key.
+ * @param out Receives the removed value when found; may be NULL.
+ * @return true when an entry was removed.
+ */
+bool int_map_remove(int_map *m, uint64_t key, void **out);
+
+/**
+ * @brief Return the number of entries.
+ */
+int int_map_size(const int_map *m);
+
+/**
+ * @brief Return the number of slots in the table.
+ */
+int int_map_capacity(const int_map *m);
+
+/**
+ * @brief Grow the table so @p n entries fit without another resize.
+ *
+ * @return ::OVA_SUCCESS, ::OVA_ERROR_INVALID_ARG for a NULL map or negative
+ *         @p n, or ::OVA_ERROR_MEMORY.
+ */
+ova_error_code int_map_reserve(int_map *m, int n);
+
+/**
+ * @brief Remove every entry, keeping the table's capacity.
+ */
+void int_map_clear(int_map *m);
+
+/**
+ * @brief Step through the entries in unspecified order.
+ *
+ * Start with `*cursor == 0` and call until it returns false. The map must not
+ * be modified during iteration.
+ *
+ * @param m Map instance.
+ * @param cursor Iteration state.
+ * @param key Receives the entry's key; may be NULL.
+ * @param value Receives the entry's value; may be NULL.
+ * @return true when an entry was produced.
+ */
+bool int_map_next(const int_map *m, size_t *cursor, uint64_t *key, void **value);
+
+/**
+ * @brief Opaque map from `uint64_t` keys to `uint64_t` values.
+ *
+ * The functions below behave exactly like their ::int_map counterparts.
+ */
+typedef struct u64_map u64_map;
+
+u64_map *create_u64_map(int capacity);
+void u64_map_free(u64_map *m);
+ova_error_code u64_map_put(u64_map *m, uint64_t key, uint64_t value);
+bool u64_map_get(const u64_map *m, uint64_t key, uint64_t *out);
+bool u64_map_contains(const u64_map *m, uint64_t key);
+bool u64_map_remove(u64_map *m, uint64_t key, uint64_t *out);
+int u64_map_size(const u64_map *m);
+int u64_map_capacity(const u64_map *m);
+ova_error_code u64_map_reserve(u64_map *m, int n);
+void u64_map_clear(u64_map *m);
+bool u64_map_next(const u64_map *m, size_t *cursor, uint64_t *key, uint64_t *value);
+
+#endif // INT_MAP_H
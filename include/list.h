@@ -4,9 +4,11 @@
 #include "types.h"
 
 typedef enum {
-    ARRAY_LIST,
-    LINKED_LIST,
-    SORTED_LIST
+    ARRAY_LIST,        /**< Contiguous pointer array. */
+    LINKED_LIST,       /**< Doubly linked nodes. */
+    SORTED_LIST,       /**< Kept ordered by a comparator in one flat array. */
+    SORTED_BLOCK_LIST, /**< Kept ordered in fixed-size blocks; O(log n) indexed access and updates. */
+    UNROLLED_LIST      /**< Linked nodes of small item arrays; cheap middle updates, near-array scans. */
 } ListType;
 
 /**
@@ -23,6 +25,8 @@ typedef struct list {
     ListType _type;
     /** @internal Comparator used for sorted-list cloning. */
     comparator _cmp;
+    /** @internal Bytes per element of lists made by create_list_of(), 0 otherwise. */
+    size_t _element_size;
 
     /**
      * @brief Insert an item at the given index.
@@ -44,6 +48,21 @@ typedef struct list {
      */
     ova_error_code (*insert_bulk)(struct list *self, void **elements, int count);
 
+    /**
+     * @brief Insert @p count items before position @p index.
+     *
+     * ARRAY_LIST grows at most once and shifts its tail with a single move.
+     * Sorted variants ignore @p index, as insert() does. @p elements must not
+     * point into this list's own storage.
+     *
+     * @param self List instance.
+     * @param index Zero-based insertion index.
+     * @param elements Array of payload pointers; may be NULL when @p count is 0.
+     * @param count Number of elements in @p elements.
+     * @return OVA_SUCCESS on success, or a negative ova_error_code on failure.
+     */
+    ova_error_code (*insert_range)(struct list *self, int index, void **elements, int count);
+
     /**
      * @brief Retrieve the item at the given index.
      *
@@ -62,6 +81,19 @@ typedef struct list {
      */
     ova_error_code (*remove)(struct list *self, int index);
 
+    /**
+     * @brief Remove the items in positions [@p from, @p to).
+     *
+     * Array-backed variants close the gap with a single move.
+     *
+     * @param self List instance.
+     * @param from First index to remove.
+     * @param to One past the last index to remove.
+     * @return OVA_SUCCESS on success, OVA_ERROR_INDEX_OUT_OF_BOUNDS when the
+     *         range is not inside the list.
+     */
+    ova_error_code (*remove_range)(struct list *self, int from, int to);
+
     /**
      * @brief Return the current element count.
      *
@@ -80,6 +112,32 @@ typedef struct list {
      */
     void (*clear)(struct list *self);
 
+    /**
+     * @brief Make room for at least @p capacity elements in total.
+     *
+     * A no-op for node-based variants.
+     *
+     * @param self List instance.
+     * @param capacity Total number of elements to hold without growing.
+     * @return OVA_SUCCESS on success, or a negative ova_error_code on failure.
+     */
+    ova_error_code (*reserve)(struct list *self, int capacity);
+
+    /**
+     * @brief Expose the contiguous item buffer of array-backed variants.
+     *
+     * The buffer holds size() payload pointers and stays valid until the next
+     * call that changes the list. Entries of a SORTED_LIST may be read but
+     * must not be reordered.
+     *
+     * @param self List instance.
+     * @param items Receives the buffer, or NULL when unsupported.
+     * @param count Receives the number of items, or 0 when unsupported.
+     * @return OVA_SUCCESS, or OVA_ERROR_INVALID_ARG when the variant does not
+     *         store its items contiguously.
+     */
+    ova_error_code (*data_span)(struct list *self, void ***items, int *count);
+
     /**
      * @brief Release the list and its internal allocations.
      *
@@ -116,9 +174,36 @@ typedef struct list {
  *
  * @param type List backend to construct.
  * @param initial_capacity Initial capacity when applicable.
- * @param cmp Comparator used by SORTED_LIST. Ignored for other variants.
+ * @param cmp Comparator used by SORTED_LIST and SORTED_BLOCK_LIST. Ignored for
+ *            other variants.
  * @return New list instance, or NULL on failure.
  */
 list *create_list(ListType type, int initial_capacity, comparator cmp);
 
+/**
+ * @brief Create a list that stores fixed-size values inline.
+ *
+ * Elements live back to back in one buffer instead of behind one pointer
+ * each, so small PODs need no allocation of their own. The item pointers
+ * passed to insert(), insert_bulk() and insert_range() are read from:
+ * @p element_size bytes are copied out of each, and may come from this same
+ * list. get() returns a pointer into the list's storage, valid until the
+ * next call that changes the list; get(self, 0) addresses all size()
+ * elements contiguously. data_span() is not available, and clone_deep()
+ * copies values like clone_shallow() without calling the copier.
+ *
+ * @code
+ * list *xs = create_list_of(ARRAY_LIST, sizeof(double), 64);
+ * double x = 1.5;
+ * xs->insert(xs, &x, 0);
+ * double first = *(double *)xs->get(xs, 0);
+ * @endcode
+ *
+ * @param type List backend; only ARRAY_LIST is supported.
+ * @param element_size Size in bytes of each element; must be non-zero.
+ * @param initial_capacity Initial capacity in elements.
+ * @return New list instance, or NULL on failure or an unsupported @p type.
+ */
+list *create_list_of(ListType type, size_t element_size, int initial_capacity);
+
 #endif // LIST_H
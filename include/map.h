@@ -2,16 +2,44 @@
 #define MAP_H
 
 #include "types.h"
+#include "memory_pool.h"
 
 #define HASH_FUNC_COUNT 5
 #define INITIAL_CAPACITY 20
-#define LOAD_FACTOR 0.75
+#define LOAD_FACTOR 0.75      /**< Default maximum load factor. */
+#define LOAD_FACTOR_MIN 0.10  /**< Smallest accepted maximum load factor. */
+#define LOAD_FACTOR_MAX 0.95  /**< Largest accepted maximum load factor. */
 
 typedef enum {
-    HASH_TABLE,
-    HASH_MAP
+    HASH_TABLE,     /**< Chained buckets guarded by a mutex. */
+    HASH_MAP,       /**< Chained buckets, not thread-safe. */
+    HASH_MAP_FLAT,  /**< Open addressing with inline slots, not thread-safe. */
+    HASH_MAP_CONCURRENT, /**< Independently locked segments; readers share a segment. */
+    HASH_MAP_INCREMENTAL /**< Chained buckets resized a few buckets per write, not thread-safe. */
 } map_type;
 
+/**
+ * @brief Callback invoked by map::for_each for every entry.
+ */
+typedef void (*map_visitor)(void *key, void *value, void *ctx);
+
+/**
+ * @brief Cursor over the entries of a map.
+ *
+ * The cursor lives in caller storage, so iteration allocates nothing. Only
+ * @p key and @p value are meant to be read; the remaining fields belong to
+ * the backend. Any mutation other than map::iter_remove invalidates it.
+ */
+typedef struct map_iterator {
+    void *key;   /**< Key of the entry returned by the last iter_next. */
+    void *value; /**< Value of the entry returned by the last iter_next. */
+    void *entry;
+    void *next_entry;
+    size_t index;
+    size_t start;
+    int segment;
+} map_iterator;
+
 /**
  * @brief Public map object.
  *
@@ -60,6 +88,32 @@ typedef struct map {
      */
     void *(*remove)(struct map *self, void *key);
 
+    /**
+     * @brief Retrieve the values of many keys in one call.
+     *
+     * Keys are hashed and their buckets prefetched in batches before any
+     * entry is compared, so independent cache misses overlap.
+     *
+     * @param self Map instance.
+     * @param keys Array of key pointers.
+     * @param out_values Receives the value for each key, or NULL when missing.
+     * @param count Number of keys.
+     * @return OVA_SUCCESS on success, or a negative ova_error_code on failure.
+     */
+    ova_error_code (*get_bulk)(struct map *self, void **keys, void **out_values, int count);
+
+    /**
+     * @brief Remove many keys in one call.
+     *
+     * @param self Map instance.
+     * @param keys Array of key pointers.
+     * @param out_values Receives each removed value, or NULL when the key was
+     *                   missing. May be NULL when the values are not needed.
+     * @param count Number of keys.
+     * @return OVA_SUCCESS on success, or a negative ova_error_code on failure.
+     */
+    ova_error_code (*remove_bulk)(struct map *self, void **keys, void **out_values, int count);
+
     /**
      * @brief Return the number of stored key/value pairs.
      *
@@ -76,6 +130,96 @@ typedef struct map {
      */
     int (*capacity)(const struct map *self);
 
+    /**
+     * @brief Make room for @p n entries without further growth.
+     *
+     * Grows at most once, straight to the final size, so a bulk load that
+     * reserves first performs no intermediate doublings. ::HASH_MAP_CONCURRENT
+     * splits @p n across its segments, so a segment that receives far more
+     * than its share may still grow.
+     *
+     * @param self Map instance.
+     * @param n Total number of entries the map should hold.
+     * @return OVA_SUCCESS on success, OVA_ERROR_FULL when @p n exceeds the
+     *         largest table the backend can build, or another negative
+     *         ova_error_code on failure.
+     */
+    ova_error_code (*reserve)(struct map *self, int n);
+
+    /**
+     * @brief Shrink the table to the smallest capacity that holds the
+     *        current entries under the maximum load factor.
+     *
+     * A private entry slab is rebuilt around the remaining entries and its
+     * other chunks are freed; a caller-provided pool keeps its blocks.
+     *
+     * @param self Map instance.
+     * @return OVA_SUCCESS on success, or a negative ova_error_code on failure.
+     */
+    ova_error_code (*shrink_to_fit)(struct map *self);
+
+    /**
+     * @brief Set the load factor at which the table grows.
+     *
+     * The table grows immediately if it is already above the new limit.
+     *
+     * @param self Map instance.
+     * @param load_factor Value in [LOAD_FACTOR_MIN, LOAD_FACTOR_MAX].
+     * @return OVA_SUCCESS on success, or a negative ova_error_code on failure.
+     */
+    ova_error_code (*set_max_load_factor)(struct map *self, double load_factor);
+
+    /**
+     * @brief Return the load factor at which the table grows.
+     *
+     * @param self Map instance.
+     * @return Maximum load factor, or 0 for an invalid map.
+     */
+    double (*max_load_factor)(const struct map *self);
+
+    /**
+     * @brief Visit every entry in backend order.
+     *
+     * The fastest way to enumerate a map. @p visit must not mutate the map.
+     *
+     * @param self Map instance.
+     * @param visit Callback receiving each key, value and @p ctx.
+     * @param ctx Caller context passed through to @p visit.
+     */
+    void (*for_each)(const struct map *self, map_visitor visit, void *ctx);
+
+    /**
+     * @brief Position a cursor before the first entry.
+     *
+     * An incremental map finishes any pending resize here so the cursor
+     * sees a single table.
+     *
+     * @param self Map instance.
+     * @param it Cursor to initialise.
+     */
+    void (*iter_begin)(struct map *self, map_iterator *it);
+
+    /**
+     * @brief Advance the cursor to the next entry.
+     *
+     * @param self Map instance.
+     * @param it Cursor from iter_begin.
+     * @return true with @p it->key and @p it->value set, or false at the end.
+     */
+    bool (*iter_next)(struct map *self, map_iterator *it);
+
+    /**
+     * @brief Remove the entry last returned by iter_next.
+     *
+     * Iteration continues with the following entry; every entry is still
+     * visited exactly once.
+     *
+     * @param self Map instance.
+     * @param it Cursor positioned on an entry.
+     * @return Removed value, or NULL when the cursor has no current entry.
+     */
+    void *(*iter_remove)(struct map *self, map_iterator *it);
+
     /**
      * @brief Remove all key/value pairs without destroying the map.
      *
@@ -124,16 +268,94 @@ typedef struct map {
  *
  * @param type Map backend to construct.
  * @param capacity Initial capacity hint.
- * @param hash_func Hash function used to place keys into buckets.
+ * @param hash_func Hash function used to place keys into buckets, or NULL
+ *        for ::wyhash64 on C strings.
  * @param compare Comparator used to test keys for equality.
  * @return New map instance, or NULL on failure.
  */
 map *create_map(map_type type, int capacity, int (*hash_func)(void *, int), comparator compare);
 
+/**
+ * @brief Create a new map driven by a 64-bit hash function.
+ *
+ * Each entry caches the full hash, so resizing never calls @p hash again and
+ * lookups only call @p compare for entries whose cached hash matches. Results
+ * are passed through a 64-bit finalizer before use, so weak hashes such as
+ * the identity on integer ids still spread over buckets and segments.
+ *
+ * @param type Map backend to construct.
+ * @param capacity Initial capacity hint.
+ * @param hash 64-bit hash function, or NULL for ::wyhash64 on C strings.
+ * @param compare Comparator used to test keys for equality.
+ * @return New map instance, or NULL on failure.
+ */
+map *create_map_hash64(map_type type, int capacity, hash64_func_t hash, comparator compare);
+
+/**
+ * @brief Create a map whose entries come from a memory pool.
+ *
+ * With a NULL @p pool the map allocates entries from a private slab, and
+ * `clear` and `free` recycle or release the slab's chunks wholesale instead
+ * of freeing entries one by one. Removed entries go back to the slab for
+ * reuse rather than to the allocator; `shrink_to_fit` releases the slab's
+ * unused chunks. A caller-provided @p pool is not locked and keeps its
+ * blocks until its owner destroys it; share it only among maps used from
+ * one thread. Its block size must be at least the size of a map entry.
+ *
+ * ::HASH_MAP_FLAT stores entries inline and ignores the pool.
+ * ::HASH_MAP_CONCURRENT always gives each segment its own private slab.
+ *
+ * @param type Map backend to construct.
+ * @param capacity Initial capacity hint.
+ * @param hash_func Hash function used to place keys into buckets.
+ * @param compare Comparator used to test keys for equality.
+ * @param pool Entry pool, or NULL for a private slab.
+ * @return New map instance, or NULL on failure or an undersized pool.
+ */
+map *create_map_with_pool(map_type type, int capacity, hash_func_t hash_func, comparator compare,
+                          memory_pool *pool);
+
+/*
+ * Legacy string hashes: each returns an index in [0, capacity), reduced with
+ * a multiply-shift rather than a modulo so no division is needed.
+ */
 int bernstein_hash(void *key, int capacity);
 int fnv1a_hash(void *key, int capacity);
 int xor_hash(void *key, int capacity);
 int rotational_hash(void *key, int capacity);
 int additive_hash(void *key, int capacity);
 
+/**
+ * @brief 64-bit FNV-1a hash of a NUL-terminated string.
+ *
+ * @param key C string, or NULL.
+ * @return Hash value; 0 for NULL.
+ */
+uint64_t fnv1a_hash64(const void *key);
+
+/**
+ * @brief Hash an arbitrary byte range with a wyhash-style mixer.
+ *
+ * Reads the input eight bytes at a time and folds it with 64x64->128-bit
+ * multiplies, so throughput grows with key length instead of paying a
+ * multiply per byte like FNV-1a. Every input bit affects every output bit.
+ * Results are stable within a build but depend on the host's byte order.
+ *
+ * @param data Bytes to hash; may be NULL only when @p len is 0.
+ * @param len Number of bytes.
+ * @param seed Seed; different seeds give independent hash functions.
+ * @return 64-bit hash value.
+ */
+uint64_t hash_bytes64(const void *data, size_t len, uint64_t seed);
+
+/**
+ * @brief 64-bit ::hash_bytes64 of a NUL-terminated string with seed 0.
+ *
+ * This is the default hash of ::create_map and ::create_map_hash64.
+ *
+ * @param key C string, or NULL.
+ * @return Hash value; 0 for NULL.
+ */
+uint64_t wyhash64(const void *key);
+
 #endif // MAP_H
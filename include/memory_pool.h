@@ -60,6 +60,33 @@ void memory_pool_free(memory_pool *pool, void *ptr);
  */
 size_t memory_pool_active_count(const memory_pool *pool);
 
+/**
+ * @brief Return the number of blocks on the free list.
+ *
+ * @param pool Memory pool instance.
+ * @return Number of free blocks, or 0 if pool is NULL.
+ */
+size_t memory_pool_free_count(const memory_pool *pool);
+
+/**
+ * @brief Return every block to the pool at once.
+ *
+ * All outstanding blocks become invalid.  Chunks are kept for reuse, so the
+ * cost is proportional to the number of blocks owned by the pool, with no
+ * calls into the system allocator.
+ *
+ * @param pool Memory pool instance.  NULL is a safe no-op.
+ */
+void memory_pool_reset(memory_pool *pool);
+
+/**
+ * @brief Return the usable size of each block.
+ *
+ * @param pool Memory pool instance.
+ * @return Block size requested at creation, or 0 if pool is NULL.
+ */
+size_t memory_pool_block_size(const memory_pool *pool);
+
 /**
  * @brief Destroy the pool and release all backing memory.
  *
@@ -1,10 +1,12 @@
 #ifndef OVA_LIB_H
 #define OVA_LIB_H
 
+#include "bitset.h"
 #include "bloom_filter.h"
 #include "deque.h"
 #include "graph.h"
 #include "heap.h"
+#include "int_map.h"
 #include "list.h"
 #include "map.h"
 #include "matrix.h"
@@ -102,4 +102,22 @@ typedef struct queue {
  */
 queue *create_queue(queue_type type, int capacity, comparator compare);
 
+/**
+ * @brief Create a queue that stores fixed-size values inline.
+ *
+ * enqueue() copies @p element_size bytes from its data pointer. Normal
+ * queues keep values in one ring buffer and priority queues in one heap
+ * array, whose comparator receives pointers to the stored values. dequeue()
+ * returns a pointer to the removed value, readable until the next enqueue.
+ * clone_deep() copies values like clone_shallow() without calling the
+ * copier.
+ *
+ * @param type Queue backend to construct.
+ * @param element_size Size in bytes of each element; must be non-zero.
+ * @param capacity Initial capacity in elements.
+ * @param compare Comparator used by priority queues.
+ * @return New queue instance, or NULL on failure.
+ */
+queue *create_queue_of(queue_type type, size_t element_size, int capacity, comparator compare);
+
 #endif // QUEUE_H
@@ -2,13 +2,45 @@
 #define SET_H
 
 #include "list.h"
+#include "map.h"
 #include "types.h"
 
 typedef enum {
     SET_HASH,
-    SET_TREE
+    SET_TREE,
+    SET_BITMAP
 } set_type;
 
+/**
+ * @brief Pack a non-negative integer as a SET_BITMAP element.
+ *
+ * SET_BITMAP stores small integers rather than pointers; 0 travels as NULL.
+ */
+#define SET_INT(value) ((void *)(uintptr_t)(value))
+
+/**
+ * @brief Recover the integer carried by a SET_BITMAP element.
+ */
+#define SET_INT_VALUE(element) ((size_t)(uintptr_t)(element))
+
+/**
+ * @brief Callback invoked by set::for_each for every element.
+ */
+typedef void (*set_visitor)(void *element, void *ctx);
+
+/**
+ * @brief Cursor over the elements of a set.
+ *
+ * The cursor lives in caller storage, so iteration allocates nothing. Only
+ * @p element is meant to be read. Any mutation other than set::iter_remove
+ * invalidates it.
+ */
+typedef struct set_iterator {
+    void *element;       /**< Element returned by the last iter_next. */
+    map_iterator cursor; /**< Backend cursor state. */
+    bool started;
+} set_iterator;
+
 /**
  * @brief Public set object.
  *
@@ -65,6 +97,10 @@ typedef struct set {
     /**
      * @brief Create a new set containing the union of two compatible sets.
      *
+     * Hash sets copy the larger operand's table and add the smaller one;
+     * tree sets merge both in order and build the result in linear time;
+     * bitmap sets OR their words together.
+     *
      * @param self Left-hand set instance.
      * @param other Right-hand set instance.
      * @return New set instance, or NULL on incompatibility / allocation failure.
@@ -74,6 +110,10 @@ typedef struct set {
     /**
      * @brief Create a new set containing the intersection of two compatible sets.
      *
+     * Probes the larger operand with each element of the smaller one, except
+     * for tree sets of similar size, which are merged in order instead, and
+     * bitmap sets, which AND their words.
+     *
      * @param self Left-hand set instance.
      * @param other Right-hand set instance.
      * @return New set instance, or NULL on incompatibility / allocation failure.
@@ -83,12 +123,39 @@ typedef struct set {
     /**
      * @brief Create a new set containing the difference of two compatible sets.
      *
+     * Hash sets copy @p self and remove matches probing from the smaller
+     * side; tree sets merge both in order; bitmap sets clear @p other's
+     * bits word by word.
+     *
      * @param self Left-hand set instance.
      * @param other Right-hand set instance.
      * @return New set instance, or NULL on incompatibility / allocation failure.
      */
     struct set *(*difference_with)(const struct set *self, const struct set *other);
 
+    /**
+     * @brief Add every element of @p other to this set in place.
+     *
+     * No intermediate set is built; only new elements allocate storage.
+     *
+     * @param self Set to update.
+     * @param other Compatible set to merge in; may be @p self.
+     * @return ::OVA_SUCCESS, ::OVA_ERROR_INVALID_ARG for incompatible sets, or
+     *         ::OVA_ERROR_MEMORY when a bitmap set cannot grow.
+     */
+    ova_error_code (*union_into)(struct set *self, const struct set *other);
+
+    /**
+     * @brief Remove every element of this set that is not in @p other.
+     *
+     * Works in place without allocating.
+     *
+     * @param self Set to update.
+     * @param other Compatible set to intersect with; may be @p self.
+     * @return ::OVA_SUCCESS, or ::OVA_ERROR_INVALID_ARG for incompatible sets.
+     */
+    ova_error_code (*intersect_into)(struct set *self, const struct set *other);
+
     /**
      * @brief Check whether this set is a subset of another compatible set.
      *
@@ -108,6 +175,45 @@ typedef struct set {
      */
     list *(*to_list)(const struct set *self);
 
+    /**
+     * @brief Visit every element without building a list.
+     *
+     * Tree sets visit in comparator order. @p visit must not mutate the set.
+     *
+     * @param self Set instance.
+     * @param visit Callback receiving each element and @p ctx.
+     * @param ctx Caller context passed through to @p visit.
+     */
+    void (*for_each)(const struct set *self, set_visitor visit, void *ctx);
+
+    /**
+     * @brief Position a cursor before the first element.
+     *
+     * @param self Set instance.
+     * @param it Cursor to initialise.
+     */
+    void (*iter_begin)(const struct set *self, set_iterator *it);
+
+    /**
+     * @brief Advance the cursor to the next element.
+     *
+     * @param self Set instance.
+     * @param it Cursor from iter_begin.
+     * @return true with @p it->element set, or false at the end.
+     */
+    bool (*iter_next)(const struct set *self, set_iterator *it);
+
+    /**
+     * @brief Remove the element last returned by iter_next.
+     *
+     * Iteration continues with the following element.
+     *
+     * @param self Set instance.
+     * @param it Cursor positioned on an element.
+     * @return true when an element was removed.
+     */
+    bool (*iter_remove)(struct set *self, set_iterator *it);
+
     /**
      * @brief Release the set and its internal allocations.
      *
@@ -131,6 +237,8 @@ typedef struct set {
      * @brief Create a deep copy of the set.
      *
      * Copies the set structure and each element using the provided copier.
+     * SET_BITMAP elements are integers rather than pointers, so a bitmap set
+     * ignores @p copier and returns the same copy as clone_shallow().
      *
      * @param self Set instance.
      * @param copier Function used to duplicate each element.
@@ -144,6 +252,9 @@ typedef struct set {
  *
  * For SET_HASH, both @p cmp and @p hash must be provided, or both may be NULL
  * to use default pointer-identity semantics. For SET_TREE, @p hash is ignored.
+ * SET_BITMAP holds integers packed with SET_INT(), iterates in ascending
+ * order, and ignores both @p cmp and @p hash; it suits dense ranges such as
+ * vertex or row ids.
  *
  * @param type Set backend to construct.
  * @param cmp Comparator for set elements.
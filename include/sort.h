@@ -4,6 +4,18 @@
 #include "list.h"
 #include "types.h"
 
+/**
+ * @brief Extracts the unsigned integer key a radix sorter orders an item by.
+ *
+ * Map signed keys with `(uint64_t)x ^ ((uint64_t)1 << 63)` so they keep their order.
+ */
+typedef uint64_t (*sort_key_u64)(const void *item);
+
+/**
+ * @brief Extracts the NUL-terminated key a string radix sorter orders an item by.
+ */
+typedef const char *(*sort_key_string)(const void *item);
+
 /**
  * @brief Public sorter object.
  *
@@ -47,6 +59,23 @@ typedef struct sorter {
      */
     int (*binary_search)(struct sorter *self, list *lst, void *item);
 
+    /**
+     * @brief Look up many keys in one sorted list.
+     *
+     * Probes advance in interleaved groups so their cache misses overlap,
+     * which pays off for large lists and many keys. For each key @p out
+     * receives the index of the first equal item, or -1 when missing.
+     *
+     * @param self Sorter instance.
+     * @param lst Sorted list.
+     * @param keys Keys to search for.
+     * @param count Number of keys.
+     * @param out Output array with room for @p count indices.
+     * @return Number of keys found, or -1 when the arguments are invalid or a
+     *         snapshot of a non-array list cannot be allocated.
+     */
+    int (*binary_search_batch)(struct sorter *self, list *lst, void *const *keys, int count, int *out);
+
     /**
      * @brief Swap two list positions.
      *
@@ -85,6 +114,42 @@ typedef struct sorter {
      */
     void *(*max)(struct sorter *self, list *lst);
 
+    /**
+     * @brief Sort the @p k smallest items into the first @p k positions.
+     *
+     * The order of the remaining items is unspecified. Runs in O(n log k).
+     *
+     * @param self Sorter instance.
+     * @param lst Target list.
+     * @param k Number of leading items to sort; k >= size sorts the list.
+     */
+    void (*partial_sort)(struct sorter *self, list *lst, int k);
+
+    /**
+     * @brief Move the item that belongs at index @p n of the sorted list there.
+     *
+     * Items before @p n compare no greater than it and items after no less.
+     * Runs introselect in expected O(n).
+     *
+     * @param self Sorter instance.
+     * @param lst Target list.
+     * @param n Zero-based index; out-of-range values leave the list unchanged.
+     */
+    void (*nth_element)(struct sorter *self, list *lst, int n);
+
+    /**
+     * @brief Copy the @p k largest items into @p out, largest first.
+     *
+     * The list is not modified. Runs in O(n log k).
+     *
+     * @param self Sorter instance.
+     * @param lst Source list.
+     * @param k Maximum number of items to return.
+     * @param out Output array with room for @p k item pointers.
+     * @return Number of items written, the smaller of @p k and the list size.
+     */
+    int (*top_k)(struct sorter *self, list *lst, int k, void **out);
+
     /**
      * @brief Copy list items from one list to another.
      *
@@ -122,4 +187,65 @@ sorter *create_sorter(comparator cmp);
  */
 sorter *create_merge_sorter(comparator cmp);
 
+/**
+ * @brief Create a new sorter that uses TimSort.
+ *
+ * A stable, adaptive merge sort: it finds the sorted (or strictly
+ * descending) runs already present, extends short ones with binary
+ * insertion sort, and merges them with galloping, so sorted input and
+ * concatenations of sorted batches cost close to O(n) comparisons. Random
+ * input stays O(n log n). The merge buffer is owned by the sorter and
+ * reused across calls, so one instance must not sort from several threads
+ * at once.
+ *
+ * @param cmp Comparator used by the sorting operations.
+ * @return New sorter instance, or NULL on failure.
+ */
+sorter *create_tim_sorter(comparator cmp);
+
+/**
+ * @brief Create a new sorter whose sort runs on several threads.
+ *
+ * Sorting splits the list between threads, merge-sorts each share, and
+ * merges the sorted runs in parallel as well.  The result is the same stable
+ * order create_merge_sorter() produces; small lists are sorted on the calling
+ * thread.  The comparator must be safe to call concurrently.
+ *
+ * @param cmp Comparator used by the sorting operations.
+ * @param threads Number of threads to use; 0 or less uses every online CPU.
+ * @return New sorter instance, or NULL on failure.
+ */
+sorter *create_parallel_sorter(comparator cmp, int threads);
+
+/**
+ * @brief Create a new sorter that sorts by integer key without comparisons.
+ *
+ * sort() extracts every key once and runs a stable LSD radix sort on 11-bit
+ * digits, skipping digits that all keys share, so 32-bit keys take three
+ * passes and 64-bit keys six; its cost is linear in the list size. Very
+ * short lists fall back to the comparison sort when @p cmp is provided. The
+ * other operations (binary_search, min, max, ...) use @p cmp, which should
+ * agree with the key order.
+ *
+ * @param cmp Comparator for the non-sorting operations; may be NULL if only
+ *            sort() is used.
+ * @param key Key extractor.
+ * @return New sorter instance, or NULL when @p key is NULL or on failure.
+ */
+sorter *create_radix_sorter(comparator cmp, sort_key_u64 key);
+
+/**
+ * @brief Create a new sorter that sorts by string key without comparisons.
+ *
+ * sort() runs a stable MSD radix sort over the extracted keys, giving the
+ * same order as strcmp(); NULL keys sort as empty strings. The other
+ * operations use @p cmp, as for create_radix_sorter().
+ *
+ * @param cmp Comparator for the non-sorting operations; may be NULL if only
+ *            sort() is used.
+ * @param key Key extractor.
+ * @return New sorter instance, or NULL when @p key is NULL or on failure.
+ */
+sorter *create_string_radix_sorter(comparator cmp, sort_key_string key);
+
 #endif // SORT_H
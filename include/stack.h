@@ -125,4 +125,20 @@ typedef struct stack {
  */
 stack *create_stack(StackType type);
 
+/**
+ * @brief Create a stack that stores fixed-size values inline.
+ *
+ * push() copies @p element_size bytes from its item pointer into one
+ * contiguous buffer. top() returns a pointer into that buffer, and pop()
+ * returns a pointer to the removed value, readable until the next push.
+ * clone_deep() copies values like clone_shallow() without calling the
+ * copier.
+ *
+ * @param type Stack implementation type; only ARRAY_STACK is supported.
+ * @param element_size Size in bytes of each element; must be non-zero.
+ * @return A pointer to the new stack, or NULL on failure or an unsupported
+ *         @p type.
+ */
+stack *create_stack_of(StackType type, size_t element_size);
+
 #endif // STACK_H
@@ -8,6 +8,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -27,6 +28,18 @@ typedef int (*comparator)(const void *a, const void *b);
  */
 typedef int (*hash_func_t)(void *key, int capacity);
 
+/**
+ * @brief Full-width hash function type.
+ *
+ * Unlike ::hash_func_t the result is not reduced to a bucket index, so
+ * containers can cache it and reuse it across resizes. Implementations
+ * should spread entropy across all 64 bits.
+ *
+ * @param key Pointer to the key to hash.
+ * @return 64-bit hash of @p key.
+ */
+typedef uint64_t (*hash64_func_t)(const void *key);
+
 /**
  * @brief Element copier function type for deep-copy operations.
  *
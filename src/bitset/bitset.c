@@ -0,0 +1,569 @@
+#include "bitset_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Serialized layout: magic, version, encoding, varint length, payload. */
+#define BITSET_MAGIC "OVBS"
+#define BITSET_MAGIC_LEN 4
+#define BITSET_FORMAT_VERSION 1
+#define BITSET_HEADER_LEN (BITSET_MAGIC_LEN + 2)
+
+typedef enum {
+    BITSET_ENCODING_DENSE = 0,  /* varint word count, then little-endian words */
+    BITSET_ENCODING_SPARSE = 1  /* varint bit count, then varint gaps between set bits */
+} bitset_encoding;
+
+static inline unsigned bitset_popcount(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (unsigned)((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static inline unsigned bitset_ctz(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(w);
+#else
+    unsigned n = 0;
+    while (!(w & 1u)) {
+        w >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* Position of the set bit of rank @p k inside @p w; @p k < popcount(w). */
+static inline unsigned bitset_select_in_word(uint64_t w, unsigned k) {
+    while (k--) {
+        w &= w - 1;
+    }
+    return bitset_ctz(w);
+}
+
+static size_t bitset_words_for(size_t nbits) {
+    return nbits / BITSET_WORD_BITS + (nbits % BITSET_WORD_BITS != 0);
+}
+
+static void bitset_recount(bitset *bs) {
+    size_t count = 0;
+    for (size_t i = 0; i < bs->word_count; i++) {
+        count += bitset_popcount(bs->words[i]);
+    }
+    bs->count = count;
+    bs->rank->valid = false;
+}
+
+static bitset *bitset_alloc(size_t word_count) {
+    bitset *bs = (bitset *)calloc(1, sizeof(bitset));
+    if (!bs) {
+        return NULL;
+    }
+    bs->rank = (bitset_rank_index *)calloc(1, sizeof(bitset_rank_index));
+    bs->words = (uint64_t *)calloc(word_count > 0 ? word_count : 1, sizeof(uint64_t));
+    if (!bs->rank || !bs->words) {
+        free(bs->rank);
+        free(bs->words);
+        free(bs);
+        return NULL;
+    }
+    bs->word_count = word_count;
+    return bs;
+}
+
+bitset *create_bitset(size_t nbits) {
+    return bitset_alloc(bitset_words_for(nbits));
+}
+
+bitset *bitset_clone(const bitset *bs) {
+    if (!bs) {
+        return NULL;
+    }
+    bitset *copy = bitset_alloc(bs->word_count);
+    if (!copy) {
+        return NULL;
+    }
+    memcpy(copy->words, bs->words, bs->word_count * sizeof(uint64_t));
+    copy->count = bs->count;
+    return copy;
+}
+
+void bitset_free(bitset *bs) {
+    if (!bs) {
+        return;
+    }
+    if (bs->rank) {
+        free(bs->rank->before);
+        free(bs->rank);
+    }
+    free(bs->words);
+    free(bs);
+}
+
+/* Grow to at least @p words words, doubling so repeated adds stay amortised. */
+static bool bitset_grow(bitset *bs, size_t words) {
+    if (words <= bs->word_count) {
+        return true;
+    }
+    size_t target = bs->word_count * 2;
+    if (target < words) {
+        target = words;
+    }
+    if (target > SIZE_MAX / sizeof(uint64_t)) {
+        return false;
+    }
+
+    uint64_t *grown = (uint64_t *)realloc(bs->words, target * sizeof(uint64_t));
+    if (!grown) {
+        return false;
+    }
+    memset(grown + bs->word_count, 0, (target - bs->word_count) * sizeof(uint64_t));
+    bs->words = grown;
+    bs->word_count = target;
+    bs->rank->valid = false;
+    return true;
+}
+
+bool bitset_add(bitset *bs, size_t bit) {
+    if (!bs || !bitset_grow(bs, bit / BITSET_WORD_BITS + 1)) {
+        return false;
+    }
+    size_t before = bs->count;
+    bitset_set_bit(bs, bit);
+    return bs->count != before;
+}
+
+bool bitset_remove(bitset *bs, size_t bit) {
+    if (!bitset_contains(bs, bit)) {
+        return false;
+    }
+    bs->words[bit / BITSET_WORD_BITS] &= ~((uint64_t)1 << (bit % BITSET_WORD_BITS));
+    bs->count--;
+    bs->rank->valid = false;
+    return true;
+}
+
+bool bitset_contains(const bitset *bs, size_t bit) {
+    return bs && bit / BITSET_WORD_BITS < bs->word_count && bitset_test_bit(bs, bit);
+}
+
+size_t bitset_size(const bitset *bs) {
+    return bs ? bs->count : 0;
+}
+
+size_t bitset_capacity(const bitset *bs) {
+    return bs ? bs->word_count * BITSET_WORD_BITS : 0;
+}
+
+ova_error_code bitset_reserve(bitset *bs, size_t nbits) {
+    if (!bs) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    return bitset_grow(bs, bitset_words_for(nbits)) ? OVA_SUCCESS : OVA_ERROR_MEMORY;
+}
+
+void bitset_clear(bitset *bs) {
+    if (!bs) {
+        return;
+    }
+    memset(bs->words, 0, bs->word_count * sizeof(uint64_t));
+    bs->count = 0;
+    bs->rank->valid = false;
+}
+
+/*
+ * Word-parallel kernels. The vector paths cover whole 256- or 128-bit lanes
+ * and the scalar loop finishes the tail, so results match bit for bit.
+ */
+static void bitset_words_or(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(const void *)(dst + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(const void *)(src + i));
+        _mm256_storeu_si256((__m256i *)(void *)(dst + i), _mm256_or_si256(a, b));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(const void *)(dst + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(const void *)(src + i));
+        _mm_storeu_si128((__m128i *)(void *)(dst + i), _mm_or_si128(a, b));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] |= src[i];
+    }
+}
+
+static void bitset_words_and(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(const void *)(dst + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(const void *)(src + i));
+        _mm256_storeu_si256((__m256i *)(void *)(dst + i), _mm256_and_si256(a, b));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(const void *)(dst + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(const void *)(src + i));
+        _mm_storeu_si128((__m128i *)(void *)(dst + i), _mm_and_si128(a, b));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] &= src[i];
+    }
+}
+
+static void bitset_words_andnot(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(const void *)(dst + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(const void *)(src + i));
+        _mm256_storeu_si256((__m256i *)(void *)(dst + i), _mm256_andnot_si256(b, a));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(const void *)(dst + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(const void *)(src + i));
+        _mm_storeu_si128((__m128i *)(void *)(dst + i), _mm_andnot_si128(b, a));
+    }
+#endif
+    for (; i < n; i++) {
+        dst[i] &= ~src[i];
+    }
+}
+
+/* Highest word holding a set bit, plus one. */
+static size_t bitset_used_words(const bitset *bs) {
+    size_t used = bs->word_count;
+    while (used > 0 && bs->words[used - 1] == 0) {
+        used--;
+    }
+    return used;
+}
+
+ova_error_code bitset_union_into(bitset *dst, const bitset *src) {
+    if (!dst || !src) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    size_t used = bitset_used_words(src);
+    if (!bitset_grow(dst, used)) {
+        return OVA_ERROR_MEMORY;
+    }
+    bitset_words_or(dst->words, src->words, used);
+    bitset_recount(dst);
+    return OVA_SUCCESS;
+}
+
+void bitset_intersect_into(bitset *dst, const bitset *src) {
+    if (!dst || !src) {
+        return;
+    }
+    size_t shared = dst->word_count < src->word_count ? dst->word_count : src->word_count;
+    bitset_words_and(dst->words, src->words, shared);
+    memset(dst->words + shared, 0, (dst->word_count - shared) * sizeof(uint64_t));
+    bitset_recount(dst);
+}
+
+void bitset_difference_into(bitset *dst, const bitset *src) {
+    if (!dst || !src) {
+        return;
+    }
+    size_t shared = dst->word_count < src->word_count ? dst->word_count : src->word_count;
+    bitset_words_andnot(dst->words, src->words, shared);
+    bitset_recount(dst);
+}
+
+/* Rebuild the per-block prefix counts if a mutation invalidated them. */
+static bool bitset_rank_refresh(const bitset *bs) {
+    bitset_rank_index *rank = bs->rank;
+    if (rank->valid) {
+        return true;
+    }
+
+    size_t blocks = bs->word_count / BITSET_RANK_BLOCK_WORDS + 1;
+    if (blocks != rank->blocks) {
+        size_t *before = (size_t *)realloc(rank->before, blocks * sizeof(size_t));
+        if (!before) {
+            return false;
+        }
+        rank->before = before;
+        rank->blocks = blocks;
+    }
+
+    size_t total = 0;
+    for (size_t b = 0; b < blocks; b++) {
+        rank->before[b] = total;
+        size_t end = (b + 1) * BITSET_RANK_BLOCK_WORDS;
+        for (size_t w = b * BITSET_RANK_BLOCK_WORDS; w < end && w < bs->word_count; w++) {
+            total += bitset_popcount(bs->words[w]);
+        }
+    }
+    rank->valid = true;
+    return true;
+}
+
+size_t bitset_rank(const bitset *bs, size_t bit) {
+    if (!bs) {
+        return 0;
+    }
+    size_t word = bit / BITSET_WORD_BITS;
+    if (word >= bs->word_count) {
+        return bs->count;
+    }
+
+    size_t block = word / BITSET_RANK_BLOCK_WORDS;
+    size_t first = block * BITSET_RANK_BLOCK_WORDS;
+    size_t rank = 0;
+    if (bitset_rank_refresh(bs)) {
+        rank = bs->rank->before[block];
+    } else {
+        first = 0;
+    }
+    for (size_t w = first; w < word; w++) {
+        rank += bitset_popcount(bs->words[w]);
+    }
+    uint64_t below = ((uint64_t)1 << (bit % BITSET_WORD_BITS)) - 1;
+    return rank + bitset_popcount(bs->words[word] & below);
+}
+
+bool bitset_select(const bitset *bs, size_t k, size_t *out) {
+    if (!bs || k >= bs->count) {
+        return false;
+    }
+
+    size_t word = 0;
+    size_t seen = 0;
+    if (bitset_rank_refresh(bs)) {
+        /* Last block whose prefix count does not exceed k. */
+        size_t lo = 0;
+        size_t hi = bs->rank->blocks;
+        while (hi - lo > 1) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (bs->rank->before[mid] <= k) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        word = lo * BITSET_RANK_BLOCK_WORDS;
+        seen = bs->rank->before[lo];
+    }
+
+    for (; word < bs->word_count; word++) {
+        unsigned bits = bitset_popcount(bs->words[word]);
+        if (k - seen < bits) {
+            if (out) {
+                *out = word * BITSET_WORD_BITS + bitset_select_in_word(bs->words[word], (unsigned)(k - seen));
+            }
+            return true;
+        }
+        seen += bits;
+    }
+    return false;
+}
+
+bool bitset_next(const bitset *bs, size_t from, size_t *out) {
+    if (!bs) {
+        return false;
+    }
+    size_t word = from / BITSET_WORD_BITS;
+    if (word >= bs->word_count) {
+        return false;
+    }
+
+    uint64_t bits = bs->words[word] & (~(uint64_t)0 << (from % BITSET_WORD_BITS));
+    for (;;) {
+        if (bits) {
+            if (out) {
+                *out = word * BITSET_WORD_BITS + bitset_ctz(bits);
+            }
+            return true;
+        }
+        if (++word >= bs->word_count) {
+            return false;
+        }
+        bits = bs->words[word];
+    }
+}
+
+/* Byte sink that only measures when @p out is NULL. */
+typedef struct {
+    uint8_t *out;
+    size_t len;
+} bitset_writer;
+
+static void bitset_put_byte(bitset_writer *w, uint8_t byte) {
+    if (w->out) {
+        w->out[w->len] = byte;
+    }
+    w->len++;
+}
+
+static void bitset_put_varint(bitset_writer *w, uint64_t value) {
+    while (value >= 0x80) {
+        bitset_put_byte(w, (uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    bitset_put_byte(w, (uint8_t)value);
+}
+
+static size_t bitset_encode(const bitset *bs, bitset_encoding encoding, uint8_t *out) {
+    bitset_writer w = {out, 0};
+    for (size_t i = 0; i < BITSET_MAGIC_LEN; i++) {
+        bitset_put_byte(&w, (uint8_t)BITSET_MAGIC[i]);
+    }
+    bitset_put_byte(&w, BITSET_FORMAT_VERSION);
+    bitset_put_byte(&w, (uint8_t)encoding);
+
+    if (encoding == BITSET_ENCODING_DENSE) {
+        size_t used = bitset_used_words(bs);
+        bitset_put_varint(&w, used);
+        for (size_t i = 0; i < used; i++) {
+            for (unsigned shift = 0; shift < 64; shift += 8) {
+                bitset_put_byte(&w, (uint8_t)(bs->words[i] >> shift));
+            }
+        }
+        return w.len;
+    }
+
+    bitset_put_varint(&w, bs->count);
+    size_t pos = 0;
+    size_t next_from = 0;
+    while (bitset_next(bs, next_from, &pos)) {
+        bitset_put_varint(&w, pos - next_from);
+        next_from = pos + 1;
+    }
+    return w.len;
+}
+
+/* Sparse wins only when strictly smaller, which deserialisation relies on. */
+static bitset_encoding bitset_pick_encoding(const bitset *bs, size_t *size) {
+    size_t dense = bitset_encode(bs, BITSET_ENCODING_DENSE, NULL);
+    size_t sparse = bitset_encode(bs, BITSET_ENCODING_SPARSE, NULL);
+    *size = sparse < dense ? sparse : dense;
+    return sparse < dense ? BITSET_ENCODING_SPARSE : BITSET_ENCODING_DENSE;
+}
+
+size_t bitset_serialized_size(const bitset *bs) {
+    if (!bs) {
+        return 0;
+    }
+    size_t size = 0;
+    bitset_pick_encoding(bs, &size);
+    return size;
+}
+
+size_t bitset_serialize(const bitset *bs, void *buf, size_t capacity) {
+    if (!bs || !buf) {
+        return 0;
+    }
+    size_t size = 0;
+    bitset_encoding encoding = bitset_pick_encoding(bs, &size);
+    if (capacity < size) {
+        return 0;
+    }
+    return bitset_encode(bs, encoding, (uint8_t *)buf);
+}
+
+typedef struct {
+    const uint8_t *in;
+    size_t len;
+    size_t pos;
+} bitset_reader;
+
+static bool bitset_get_varint(bitset_reader *r, uint64_t *value) {
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (r->pos >= r->len) {
+            return false;
+        }
+        uint8_t byte = r->in[r->pos++];
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+bitset *bitset_deserialize(const void *buf, size_t len) {
+    if (!buf || len < BITSET_HEADER_LEN || memcmp(buf, BITSET_MAGIC, BITSET_MAGIC_LEN) != 0) {
+        return NULL;
+    }
+
+    bitset_reader r = {(const uint8_t *)buf, len, BITSET_MAGIC_LEN};
+    uint8_t version = r.in[r.pos++];
+    uint8_t encoding = r.in[r.pos++];
+    uint64_t n = 0;
+    if (version != BITSET_FORMAT_VERSION || !bitset_get_varint(&r, &n)) {
+        return NULL;
+    }
+
+    if (encoding == BITSET_ENCODING_DENSE) {
+        if (n != (r.len - r.pos) / 8 || (r.len - r.pos) % 8 != 0) {
+            return NULL;
+        }
+        bitset *bs = bitset_alloc((size_t)n);
+        if (!bs) {
+            return NULL;
+        }
+        for (size_t i = 0; i < (size_t)n; i++) {
+            uint64_t word = 0;
+            for (unsigned shift = 0; shift < 64; shift += 8) {
+                word |= (uint64_t)r.in[r.pos++] << shift;
+            }
+            bs->words[i] = word;
+        }
+        bitset_recount(bs);
+        return bs;
+    }
+
+    if (encoding != BITSET_ENCODING_SPARSE || n > r.len - r.pos) {
+        return NULL;
+    }
+
+    /* Validate every gap and find the highest position before allocating. */
+    size_t payload = r.pos;
+    size_t last = 0;
+    size_t next_from = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t gap = 0;
+        if (!bitset_get_varint(&r, &gap) || gap > SIZE_MAX - BITSET_WORD_BITS - next_from) {
+            return NULL;
+        }
+        last = next_from + (size_t)gap;
+        next_from = last + 1;
+    }
+    if (r.pos != r.len) {
+        return NULL;
+    }
+
+    bitset *bs = bitset_alloc(n > 0 ? bitset_words_for(last + 1) : 0);
+    if (!bs) {
+        return NULL;
+    }
+    r.pos = payload;
+    next_from = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t gap = 0;
+        bitset_get_varint(&r, &gap);
+        bitset_set_bit(bs, next_from + (size_t)gap);
+        next_from += (size_t)gap + 1;
+    }
+    return bs;
+}
@@ -0,0 +1,44 @@
+#ifndef BITSET_INTERNAL_H
+#define BITSET_INTERNAL_H
+
+#include "../../include/bitset.h"
+
+#include <stdint.h>
+
+#define BITSET_WORD_BITS 64
+/* Words summarised by one entry of the rank index. */
+#define BITSET_RANK_BLOCK_WORDS 8
+
+typedef struct bitset_rank_index {
+    size_t *before; /* set bits preceding each block */
+    size_t blocks;
+    bool valid;
+} bitset_rank_index;
+
+struct bitset {
+    uint64_t *words;
+    size_t word_count;
+    size_t count;
+    /* Separately allocated so const queries can refresh it. */
+    bitset_rank_index *rank;
+};
+
+/*
+ * Unchecked accessors for callers that sized the bitset up front, such as
+ * the graph traversals' visited sets.
+ */
+static inline bool bitset_test_bit(const bitset *bs, size_t bit) {
+    return (bs->words[bit / BITSET_WORD_BITS] >> (bit % BITSET_WORD_BITS)) & 1u;
+}
+
+static inline void bitset_set_bit(bitset *bs, size_t bit) {
+    uint64_t mask = (uint64_t)1 << (bit % BITSET_WORD_BITS);
+    uint64_t *word = &bs->words[bit / BITSET_WORD_BITS];
+    if (!(*word & mask)) {
+        *word |= mask;
+        bs->count++;
+        bs->rank->valid = false;
+    }
+}
+
+#endif // BITSET_INTERNAL_H
@@ -0,0 +1,236 @@
+#include "../../include/deque.h"
+#include "../utils/capacity_utils.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_CAPACITY 16
+
+/*
+ * Ring buffer of fixed-size values. Pushes copy the value in; pops leave it
+ * in its old slot and return a pointer there, which stays valid until the
+ * next push reuses the slot.
+ */
+typedef struct value_deque_impl {
+    unsigned char *buffer;
+    unsigned char *scratch; /* one value, holds a pushed value that lives in the old buffer */
+    size_t element_size;
+    int capacity;
+    int size;
+    int front;
+} value_deque_impl;
+
+static value_deque_impl *value_deque_impl_from_self(const deque *self) {
+    return self ? (value_deque_impl *)self->impl : NULL;
+}
+
+static unsigned char *value_deque_slot(const value_deque_impl *impl, int physical_index) {
+    return impl->buffer + (size_t)physical_index * impl->element_size;
+}
+
+/* Copies the live values, in order, to the start of @p out. */
+static void value_deque_copy_out(const value_deque_impl *impl, unsigned char *out) {
+    int head_count = impl->capacity - impl->front;
+    if (head_count >= impl->size) {
+        memcpy(out, value_deque_slot(impl, impl->front), (size_t)impl->size * impl->element_size);
+    } else {
+        memcpy(out, value_deque_slot(impl, impl->front), (size_t)head_count * impl->element_size);
+        memcpy(out + (size_t)head_count * impl->element_size, impl->buffer,
+               (size_t)(impl->size - head_count) * impl->element_size);
+    }
+}
+
+static int value_deque_resize_impl(value_deque_impl *impl) {
+    int new_capacity = safe_double_capacity(impl->capacity);
+    if (new_capacity == impl->capacity || (size_t)new_capacity > SIZE_MAX / impl->element_size) {
+        return -1;
+    }
+
+    unsigned char *new_buffer = malloc((size_t)new_capacity * impl->element_size);
+    if (!new_buffer) {
+        return -1;
+    }
+    value_deque_copy_out(impl, new_buffer);
+
+    free(impl->buffer);
+    impl->buffer = new_buffer;
+    impl->capacity = new_capacity;
+    impl->front = 0;
+    return 0;
+}
+
+static ova_error_code value_deque_push(deque *self, void *element, bool at_front) {
+    value_deque_impl *impl = value_deque_impl_from_self(self);
+    if (!impl || !element) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    const void *source = element;
+    if (impl->size == impl->capacity) {
+        /* The value may sit in the buffer about to be replaced. */
+        uintptr_t offset = (uintptr_t)element - (uintptr_t)impl->buffer;
+        if (offset < (uintptr_t)impl->capacity * impl->element_size) {
+            memcpy(impl->scratch, element, impl->element_size);
+            source = impl->scratch;
+        }
+        if (value_deque_resize_impl(impl) != 0) {
+            return OVA_ERROR_MEMORY;
+        }
+    }
+
+    int target;
+    if (at_front) {
+        impl->front = (impl->front - 1 + impl->capacity) % impl->capacity;
+        target = impl->front;
+    } else {
+        target = (impl->front + impl->size) % impl->capacity;
+    }
+    memmove(value_deque_slot(impl, target), source, impl->element_size);
+    impl->size++;
+    return OVA_SUCCESS;
+}
+
+static ova_error_code value_deque_push_front_method(deque *self, void *element) {
+    return value_deque_push(self, element, true);
+}
+
+static ova_error_code value_deque_push_back_method(deque *self, void *element) {
+    return value_deque_push(self, element, false);
+}
+
+static void *value_deque_pop_front_method(deque *self) {
+    value_deque_impl *impl = value_deque_impl_from_self(self);
+    if (!impl || impl->size == 0) {
+        return NULL;
+    }
+
+    void *element = value_deque_slot(impl, impl->front);
+    impl->front = (impl->front + 1) % impl->capacity;
+    impl->size--;
+    return element;
+}
+
+static void *value_deque_pop_back_method(deque *self) {
+    value_deque_impl *impl = value_deque_impl_from_self(self);
+    if (!impl || impl->size == 0) {
+        return NULL;
+    }
+
+    int back = (impl->front + impl->size - 1) % impl->capacity;
+    impl->size--;
+    return value_deque_slot(impl, back);
+}
+
+static void *value_deque_get_method(const deque *self, int index) {
+    value_deque_impl *impl = value_deque_impl_from_self(self);
+    if (!impl || index < 0 || index >= impl->size) {
+        return NULL;
+    }
+
+    return value_deque_slot(impl, (impl->front + index) % impl->capacity);
+}
+
+static void *value_deque_peek_front_method(const deque *self) {
+    return value_deque_get_method(self, 0);
+}
+
+static void *value_deque_peek_back_method(const deque *self) {
+    value_deque_impl *impl = value_deque_impl_from_self(self);
+    return impl ? value_deque_get_method(self, impl->size - 1) : NULL;
+}
+
+static int value_deque_size_method(const deque *self) {
+    value_deque_impl *impl = value_deque_impl_from_self(self);
+    return impl ? impl->size : 0;
+}
+
+static bool value_deque_is_empty_method(const deque *self) {
+    return value_deque_size_method(self) == 0;
+}
+
+static void value_deque_free_method(deque *self) {
+    if (!self) {
+        return;
+    }
+
+    value_deque_impl *impl = value_deque_impl_from_self(self);
+    if (impl) {
+        free(impl->buffer);
+        free(impl->scratch);
+        free(impl);
+        self->impl = NULL;
+    }
+
+    free(self);
+}
+
+static deque *value_deque_clone_shallow_method(const deque *self) {
+    value_deque_impl *impl = value_deque_impl_from_self(self);
+    if (!impl) {
+        return NULL;
+    }
+
+    deque *copy = create_deque_of(impl->element_size, impl->size > 0 ? impl->size : DEFAULT_CAPACITY);
+    if (!copy) {
+        return NULL;
+    }
+
+    value_deque_impl *copy_impl = value_deque_impl_from_self(copy);
+    value_deque_copy_out(impl, copy_impl->buffer);
+    copy_impl->size = impl->size;
+    copy->user_data = self->user_data;
+    return copy;
+}
+
+static deque *value_deque_clone_deep_method(const deque *self, element_copier copier) {
+    (void)copier;
+    return value_deque_clone_shallow_method(self);
+}
+
+deque *create_deque_of(size_t element_size, int capacity) {
+    if (element_size == 0) {
+        return NULL;
+    }
+    if (capacity <= 0) {
+        capacity = DEFAULT_CAPACITY;
+    }
+    if ((size_t)capacity > SIZE_MAX / element_size) {
+        return NULL;
+    }
+
+    deque *out = (deque *)calloc(1, sizeof(deque));
+    value_deque_impl *impl = (value_deque_impl *)calloc(1, sizeof(value_deque_impl));
+    unsigned char *buffer = malloc((size_t)capacity * element_size);
+    unsigned char *scratch = malloc(element_size);
+    if (!out || !impl || !buffer || !scratch) {
+        free(scratch);
+        free(buffer);
+        free(impl);
+        free(out);
+        return NULL;
+    }
+
+    impl->buffer = buffer;
+    impl->scratch = scratch;
+    impl->element_size = element_size;
+    impl->capacity = capacity;
+    impl->size = 0;
+    impl->front = 0;
+
+    out->impl = impl;
+    out->push_front = value_deque_push_front_method;
+    out->push_back = value_deque_push_back_method;
+    out->pop_front = value_deque_pop_front_method;
+    out->pop_back = value_deque_pop_back_method;
+    out->peek_front = value_deque_peek_front_method;
+    out->peek_back = value_deque_peek_back_method;
+    out->get = value_deque_get_method;
+    out->size = value_deque_size_method;
+    out->is_empty = value_deque_is_empty_method;
+    out->free = value_deque_free_method;
+    out->clone_shallow = value_deque_clone_shallow_method;
+    out->clone_deep = value_deque_clone_deep_method;
+
+    return out;
+}
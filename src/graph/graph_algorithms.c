@@ -2,6 +2,7 @@
 #include "../../include/queue.h"
 #include "../../include/stack.h"
 #include "graph_internal.h"
+#include "../bitset/bitset_internal.h"
 #include "../matrix/matrix_internal.h"
 
 #include <stdint.h>
@@ -38,10 +39,10 @@ list *graph_bfs_impl(const graph_impl *g, int start_vertex) {
         return order;
     }
 
-    bool *visited = (bool *)calloc((size_t)g->vertex_capacity, sizeof(bool));
+    bitset *visited = create_bitset((size_t)g->vertex_capacity);
     queue *q = create_queue(QUEUE_TYPE_NORMAL, 0, NULL);
     if (!visited || !q) {
-        free(visited);
+        bitset_free(visited);
         if (q) {
             q->free(q);
         }
@@ -49,7 +50,7 @@ list *graph_bfs_impl(const graph_impl *g, int start_vertex) {
         return NULL;
     }
 
-    visited[start_vertex] = true;
+    bitset_set_bit(visited, (size_t)start_vertex);
     q->enqueue(q, (void *)(intptr_t)start_vertex);
 
     while (!q->is_empty(q)) {
@@ -61,28 +62,28 @@ list *graph_bfs_impl(const graph_impl *g, int start_vertex) {
             int n = adj ? adj->size(adj) : 0;
             for (int i = 0; i < n; i++) {
                 graph_edge *e = (graph_edge *)adj->get(adj, i);
-                if (!e || !graph_is_valid_vertex(g, e->to) || visited[e->to]) {
+                if (!e || !graph_is_valid_vertex(g, e->to) || bitset_test_bit(visited, (size_t)e->to)) {
                     continue;
                 }
-                visited[e->to] = true;
+                bitset_set_bit(visited, (size_t)e->to);
                 q->enqueue(q, (void *)(intptr_t)e->to);
             }
         } else {
             for (int to = 0; to < g->vertex_capacity; to++) {
-                if (!graph_is_valid_vertex(g, to) || visited[to]) {
+                if (!graph_is_valid_vertex(g, to) || bitset_test_bit(visited, (size_t)to)) {
                     continue;
                 }
                 if (g->adj_matrix[v * g->vertex_capacity + to] == GRAPH_NO_EDGE) {
                     continue;
                 }
-                visited[to] = true;
+                bitset_set_bit(visited, (size_t)to);
                 q->enqueue(q, (void *)(intptr_t)to);
             }
         }
     }
 
     q->free(q);
-    free(visited);
+    bitset_free(visited);
     return order;
 }
 
@@ -96,10 +97,10 @@ list *graph_dfs_iterative_impl(const graph_impl *g, int start_vertex) {
         return order;
     }
 
-    bool *visited = (bool *)calloc((size_t)g->vertex_capacity, sizeof(bool));
+    bitset *visited = create_bitset((size_t)g->vertex_capacity);
     stack *st = create_stack(ARRAY_STACK);
     if (!visited || !st) {
-        free(visited);
+        bitset_free(visited);
         if (st) {
             st->free(st);
         }
@@ -111,10 +112,10 @@ list *graph_dfs_iterative_impl(const graph_impl *g, int start_vertex) {
 
     while (!st->is_empty(st)) {
         int v = (int)(intptr_t)st->pop(st);
-        if (visited[v]) {
+        if (bitset_test_bit(visited, (size_t)v)) {
             continue;
         }
-        visited[v] = true;
+        bitset_set_bit(visited, (size_t)v);
         order->insert(order, g->vertex_ptrs[v], order->size(order));
 
         if (g->rep == GRAPH_ADJACENCY_LIST) {
@@ -122,14 +123,14 @@ list *graph_dfs_iterative_impl(const graph_impl *g, int start_vertex) {
             int n = adj ? adj->size(adj) : 0;
             for (int i = n - 1; i >= 0; i--) {
                 graph_edge *e = (graph_edge *)adj->get(adj, i);
-                if (!e || !graph_is_valid_vertex(g, e->to) || visited[e->to]) {
+                if (!e || !graph_is_valid_vertex(g, e->to) || bitset_test_bit(visited, (size_t)e->to)) {
                     continue;
                 }
                 st->push(st, (void *)(intptr_t)e->to);
             }
         } else {
             for (int to = g->vertex_capacity - 1; to >= 0; to--) {
-                if (!graph_is_valid_vertex(g, to) || visited[to]) {
+                if (!graph_is_valid_vertex(g, to) || bitset_test_bit(visited, (size_t)to)) {
                     continue;
                 }
                 if (g->adj_matrix[v * g->vertex_capacity + to] == GRAPH_NO_EDGE) {
@@ -141,12 +142,12 @@ list *graph_dfs_iterative_impl(const graph_impl *g, int start_vertex) {
     }
 
     st->free(st);
-    free(visited);
+    bitset_free(visited);
     return order;
 }
 
-static void dfs_recursive_visit(const graph_impl *g, int v, bool *visited, list *order) {
-    visited[v] = true;
+static void dfs_recursive_visit(const graph_impl *g, int v, bitset *visited, list *order) {
+    bitset_set_bit(visited, (size_t)v);
     order->insert(order, g->vertex_ptrs[v], order->size(order));
 
     if (g->rep == GRAPH_ADJACENCY_LIST) {
@@ -154,14 +155,14 @@ static void dfs_recursive_visit(const graph_impl *g, int v, bool *visited, list
         int n = adj ? adj->size(adj) : 0;
         for (int i = 0; i < n; i++) {
             graph_edge *e = (graph_edge *)adj->get(adj, i);
-            if (!e || !graph_is_valid_vertex(g, e->to) || visited[e->to]) {
+            if (!e || !graph_is_valid_vertex(g, e->to) || bitset_test_bit(visited, (size_t)e->to)) {
                 continue;
             }
             dfs_recursive_visit(g, e->to, visited, order);
         }
     } else {
         for (int to = 0; to < g->vertex_capacity; to++) {
-            if (!graph_is_valid_vertex(g, to) || visited[to]) {
+            if (!graph_is_valid_vertex(g, to) || bitset_test_bit(visited, (size_t)to)) {
                 continue;
             }
             if (g->adj_matrix[v * g->vertex_capacity + to] == GRAPH_NO_EDGE) {
@@ -182,14 +183,14 @@ list *graph_dfs_recursive_impl(const graph_impl *g, int start_vertex) {
         return order;
     }
 
-    bool *visited = (bool *)calloc((size_t)g->vertex_capacity, sizeof(bool));
+    bitset *visited = create_bitset((size_t)g->vertex_capacity);
     if (!visited) {
         order->free(order);
         return NULL;
     }
 
     dfs_recursive_visit(g, start_vertex, visited, order);
-    free(visited);
+    bitset_free(visited);
     return order;
 }
 
@@ -609,7 +610,7 @@ static void prim_arena_destroy(prim_arena *a) {
     a->head = NULL;
 }
 
-static void prim_push_edges(const graph_impl *g, int from, const bool *in_mst,
+static void prim_push_edges(const graph_impl *g, int from, const bitset *in_mst,
                             heap *pq, prim_arena *arena) {
     if (!g || !pq || !in_mst || !arena) {
         return;
@@ -620,7 +621,7 @@ static void prim_push_edges(const graph_impl *g, int from, const bool *in_mst,
         int n = adj ? adj->size(adj) : 0;
         for (int i = 0; i < n; i++) {
             graph_edge *e = (graph_edge *)adj->get(adj, i);
-            if (!e || !graph_is_valid_vertex(g, e->to) || in_mst[e->to]) {
+            if (!e || !graph_is_valid_vertex(g, e->to) || bitset_test_bit(in_mst, (size_t)e->to)) {
                 continue;
             }
             prim_cand *c = prim_arena_alloc(arena);
@@ -636,7 +637,7 @@ static void prim_push_edges(const graph_impl *g, int from, const bool *in_mst,
     }
 
     for (int to = 0; to < g->vertex_capacity; to++) {
-        if (!graph_is_valid_vertex(g, to) || in_mst[to]) {
+        if (!graph_is_valid_vertex(g, to) || bitset_test_bit(in_mst, (size_t)to)) {
             continue;
         }
         double w = g->adj_matrix[from * g->vertex_capacity + to];
@@ -672,10 +673,10 @@ list *graph_mst_prim_impl(const graph_impl *g, int start_vertex) {
         return mst;
     }
 
-    bool *in_mst = (bool *)calloc((size_t)g->vertex_capacity, sizeof(bool));
+    bitset *in_mst = create_bitset((size_t)g->vertex_capacity);
     heap *pq = create_heap(BINARY_HEAP, g->vertex_count > 0 ? g->vertex_count : 4, prim_cand_cmp);
     if (!in_mst || !pq) {
-        free(in_mst);
+        bitset_free(in_mst);
         if (pq) {
             pq->free(pq);
         }
@@ -686,7 +687,7 @@ list *graph_mst_prim_impl(const graph_impl *g, int start_vertex) {
     prim_arena arena;
     prim_arena_init(&arena, g->vertex_count > 0 ? g->vertex_count : 16);
 
-    in_mst[start] = true;
+    bitset_set_bit(in_mst, (size_t)start);
     prim_push_edges(g, start, in_mst, pq, &arena);
 
     while (pq->size(pq) > 0 && mst->size(mst) < g->vertex_count - 1) {
@@ -694,7 +695,7 @@ list *graph_mst_prim_impl(const graph_impl *g, int start_vertex) {
         if (!c) {
             break;
         }
-        if (in_mst[c->to]) {
+        if (bitset_test_bit(in_mst, (size_t)c->to)) {
             continue;
         }
 
@@ -703,13 +704,13 @@ list *graph_mst_prim_impl(const graph_impl *g, int start_vertex) {
             break;
         }
         mst->insert(mst, we, mst->size(mst));
-        in_mst[c->to] = true;
+        bitset_set_bit(in_mst, (size_t)c->to);
         prim_push_edges(g, c->to, in_mst, pq, &arena);
     }
 
     pq->free(pq);
     prim_arena_destroy(&arena);
-    free(in_mst);
+    bitset_free(in_mst);
     return mst;
 }
 
@@ -881,10 +882,10 @@ list *graph_connected_components_impl(const graph_impl *g) {
         return NULL;
     }
 
-    bool *visited = (bool *)calloc((size_t)g->vertex_capacity, sizeof(bool));
+    bitset *visited = create_bitset((size_t)g->vertex_capacity);
     queue *q = create_queue(QUEUE_TYPE_NORMAL, 0, NULL);
     if (!visited || !q) {
-        free(visited);
+        bitset_free(visited);
         if (q) {
             q->free(q);
         }
@@ -893,7 +894,7 @@ list *graph_connected_components_impl(const graph_impl *g) {
     }
 
     for (int start = 0; start < g->vertex_capacity; start++) {
-        if (!graph_is_valid_vertex(g, start) || visited[start]) {
+        if (!graph_is_valid_vertex(g, start) || bitset_test_bit(visited, (size_t)start)) {
             continue;
         }
 
@@ -902,7 +903,7 @@ list *graph_connected_components_impl(const graph_impl *g) {
             continue;
         }
 
-        visited[start] = true;
+        bitset_set_bit(visited, (size_t)start);
         q->enqueue(q, (void *)(intptr_t)start);
 
         while (!q->is_empty(q)) {
@@ -914,21 +915,21 @@ list *graph_connected_components_impl(const graph_impl *g) {
                 int n = adj ? adj->size(adj) : 0;
                 for (int i = 0; i < n; i++) {
                     graph_edge *e = (graph_edge *)adj->get(adj, i);
-                    if (!e || !graph_is_valid_vertex(g, e->to) || visited[e->to]) {
+                    if (!e || !graph_is_valid_vertex(g, e->to) || bitset_test_bit(visited, (size_t)e->to)) {
                         continue;
                     }
-                    visited[e->to] = true;
+                    bitset_set_bit(visited, (size_t)e->to);
                     q->enqueue(q, (void *)(intptr_t)e->to);
                 }
             } else {
                 for (int to = 0; to < g->vertex_capacity; to++) {
-                    if (!graph_is_valid_vertex(g, to) || visited[to]) {
+                    if (!graph_is_valid_vertex(g, to) || bitset_test_bit(visited, (size_t)to)) {
                         continue;
                     }
                     if (g->adj_matrix[v * g->vertex_capacity + to] == GRAPH_NO_EDGE) {
                         continue;
                     }
-                    visited[to] = true;
+                    bitset_set_bit(visited, (size_t)to);
                     q->enqueue(q, (void *)(intptr_t)to);
                 }
             }
@@ -938,7 +939,7 @@ list *graph_connected_components_impl(const graph_impl *g) {
     }
 
     q->free(q);
-    free(visited);
+    bitset_free(visited);
     return components;
 }
 
@@ -1195,8 +1196,8 @@ static bool has_cycle_directed_dfs(const graph_impl *g, int v, unsigned char *co
     return false;
 }
 
-static bool has_cycle_undirected_dfs(const graph_impl *g, int v, int parent, bool *visited) {
-    visited[v] = true;
+static bool has_cycle_undirected_dfs(const graph_impl *g, int v, int parent, bitset *visited) {
+    bitset_set_bit(visited, (size_t)v);
 
     if (g->rep == GRAPH_ADJACENCY_LIST) {
         list *adj = g->adj_lists ? g->adj_lists[v] : NULL;
@@ -1207,7 +1208,7 @@ static bool has_cycle_undirected_dfs(const graph_impl *g, int v, int parent, boo
                 continue;
             }
             int to = e->to;
-            if (!visited[to]) {
+            if (!bitset_test_bit(visited, (size_t)to)) {
                 if (has_cycle_undirected_dfs(g, to, v, visited)) {
                     return true;
                 }
@@ -1223,7 +1224,7 @@ static bool has_cycle_undirected_dfs(const graph_impl *g, int v, int parent, boo
             if (g->adj_matrix[v * g->vertex_capacity + to] == GRAPH_NO_EDGE) {
                 continue;
             }
-            if (!visited[to]) {
+            if (!bitset_test_bit(visited, (size_t)to)) {
                 if (has_cycle_undirected_dfs(g, to, v, visited)) {
                     return true;
                 }
@@ -1259,19 +1260,19 @@ bool graph_has_cycle_impl(const graph_impl *g) {
         return false;
     }
 
-    bool *visited = (bool *)calloc((size_t)g->vertex_capacity, sizeof(bool));
+    bitset *visited = create_bitset((size_t)g->vertex_capacity);
     if (!visited) {
         return false;
     }
     for (int v = 0; v < g->vertex_capacity; v++) {
-        if (!graph_is_valid_vertex(g, v) || visited[v]) {
+        if (!graph_is_valid_vertex(g, v) || bitset_test_bit(visited, (size_t)v)) {
             continue;
         }
         if (has_cycle_undirected_dfs(g, v, -1, visited)) {
-            free(visited);
+            bitset_free(visited);
             return true;
         }
     }
-    free(visited);
+    bitset_free(visited);
     return false;
 }
@@ -1,6 +1,7 @@
 #include "../../include/heap.h"
 #include "binary_heap.h"
 #include "fibonacci_heap.h"
+#include "value_binary_heap.h"
 
 heap *create_heap(HeapType type, int capacity, comparator compare_function) {
     switch (type) {
@@ -13,3 +14,12 @@ heap *create_heap(HeapType type, int capacity, comparator compare_function) {
     }
 }
 
+heap *create_heap_of(HeapType type, size_t element_size, int capacity, comparator compare_function) {
+    switch (type) {
+        case BINARY_HEAP:
+            return create_value_binary_heap(element_size, capacity, compare_function);
+        case FIBONACCI_HEAP:
+        default:
+            return NULL;
+    }
+}
@@ -0,0 +1,149 @@
+#include "value_binary_heap.h"
+#include "../utils/capacity_utils.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Binary heap over a contiguous array of fixed-size values. Sifting moves a
+ * hole instead of swapping: the moving value waits in @p scratch and is
+ * written once where it lands. pop() parks the old root just past the live
+ * range and returns a pointer to it, readable until the next put().
+ */
+typedef struct value_binary_heap {
+    unsigned char *data;
+    unsigned char *scratch; // One value: the element being sifted
+    size_t element_size;
+    int capacity;
+    int size;
+    comparator cmp;
+} value_binary_heap;
+
+static unsigned char *slot(const value_binary_heap *h, int index) {
+    return h->data + (size_t)index * h->element_size;
+}
+
+/* Move the value in scratch up from the hole at @p index. */
+static void sift_up(value_binary_heap *h, int index) {
+    while (index > 0) {
+        int parent_idx = (index - 1) / 2;
+        if (h->cmp(slot(h, parent_idx), h->scratch) >= 0) break;
+        memcpy(slot(h, index), slot(h, parent_idx), h->element_size);
+        index = parent_idx;
+    }
+    memcpy(slot(h, index), h->scratch, h->element_size);
+}
+
+/* Move the value in scratch down from the hole at @p index. */
+static void sift_down(value_binary_heap *h, int index) {
+    int half = h->size / 2;
+    while (index < half) {
+        int child = 2 * index + 1;
+        if (child + 1 < h->size && h->cmp(slot(h, child + 1), slot(h, child)) > 0) {
+            child++;
+        }
+        if (h->cmp(slot(h, child), h->scratch) <= 0) break;
+        memcpy(slot(h, index), slot(h, child), h->element_size);
+        index = child;
+    }
+    memcpy(slot(h, index), h->scratch, h->element_size);
+}
+
+static ova_error_code value_binary_heap_put(heap *self, void *item) {
+    value_binary_heap *h = (value_binary_heap *)self->impl;
+    if (!item) return OVA_ERROR_INVALID_ARG;
+
+    /* Copy first: the item may live in the array about to grow. */
+    memmove(h->scratch, item, h->element_size);
+    if (h->size == h->capacity) {
+        int new_capacity = safe_double_capacity(h->capacity);
+        if (new_capacity == h->capacity || (size_t)new_capacity > SIZE_MAX / h->element_size) {
+            return OVA_ERROR_FULL;
+        }
+        unsigned char *new_data = realloc(h->data, (size_t)new_capacity * h->element_size);
+        if (new_data == NULL) {
+            return OVA_ERROR_MEMORY;
+        }
+        h->data = new_data;
+        h->capacity = new_capacity;
+    }
+    sift_up(h, h->size);
+    h->size++;
+    return OVA_SUCCESS;
+}
+
+static void *value_binary_heap_pop(heap *self) {
+    value_binary_heap *h = (value_binary_heap *)self->impl;
+    if (h->size == 0) return NULL;
+
+    h->size--;
+    /* With one element left the root already sits in the vacated slot. */
+    if (h->size > 0) {
+        memcpy(h->scratch, slot(h, h->size), h->element_size);
+        memcpy(slot(h, h->size), slot(h, 0), h->element_size);
+        sift_down(h, 0);
+    }
+    return slot(h, h->size);
+}
+
+static void *value_binary_heap_peek(const heap *self) {
+    value_binary_heap *h = (value_binary_heap *)self->impl;
+    if (h->size == 0) return NULL;
+    return h->data;
+}
+
+static int value_binary_heap_size(const heap *self) {
+    value_binary_heap *h = (value_binary_heap *)self->impl;
+    return h->size;
+}
+
+static void value_binary_heap_clear(heap *self) {
+    value_binary_heap *h = (value_binary_heap *)self->impl;
+    h->size = 0;
+}
+
+static void value_binary_heap_free(heap *self) {
+    value_binary_heap *h = (value_binary_heap *)self->impl;
+    free(h->data);
+    free(h->scratch);
+    free(h);
+    free(self);
+}
+
+heap *create_value_binary_heap(size_t element_size, int initial_capacity, comparator compare_function) {
+    if (element_size == 0 || !compare_function) return NULL;
+    int capacity = initial_capacity > 0 ? initial_capacity : 1;
+    if ((size_t)capacity > SIZE_MAX / element_size) return NULL;
+
+    heap *out = malloc(sizeof(heap));
+    value_binary_heap *h = malloc(sizeof(value_binary_heap));
+    unsigned char *data = malloc((size_t)capacity * element_size);
+    unsigned char *scratch = malloc(element_size);
+    if (!out || !h || !data || !scratch) {
+        free(scratch);
+        free(data);
+        free(h);
+        free(out);
+        return NULL;
+    }
+
+    h->data = data;
+    h->scratch = scratch;
+    h->element_size = element_size;
+    h->capacity = capacity;
+    h->size = 0;
+    h->cmp = compare_function;
+
+    out->impl = h;
+    out->put = value_binary_heap_put;
+    out->put_with_handle = NULL;  // Not supported for binary heap
+    out->decrease_key = NULL;     // Not supported for binary heap
+    out->delete_node = NULL;      // Not supported for binary heap
+    out->pop = value_binary_heap_pop;
+    out->peek = value_binary_heap_peek;
+    out->size = value_binary_heap_size;
+    out->clear = value_binary_heap_clear;
+    out->free = value_binary_heap_free;
+    out->user_data = NULL;
+    return out;
+}
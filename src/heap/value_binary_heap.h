@@ -0,0 +1,13 @@
+#ifndef VALUE_BINARY_HEAP_H
+#define VALUE_BINARY_HEAP_H
+
+#include "../../include/heap.h"
+
+/**
+ * @brief Creates a binary heap that stores @p element_size-byte values inline.
+ *
+ * The comparator receives pointers to the stored values, as qsort's does.
+ */
+heap *create_value_binary_heap(size_t element_size, int initial_capacity, comparator compare_function);
+
+#endif // VALUE_BINARY_HEAP_H
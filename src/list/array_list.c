@@ -1,4 +1,5 @@
 #include "../../include/list.h"
+#include "array_list.h"
 #include "../utils/capacity_utils.h"
 #include <stdlib.h>
 #include <string.h>
@@ -13,14 +14,24 @@ static size_t active_item_buffers = 0;
 
 static ova_error_code array_list_insert(list *self, void *item, int index);
 
+static ova_error_code array_list_insert_bulk(list *self, void **elements, int count);
+
+static ova_error_code array_list_insert_range(list *self, int index, void **elements, int count);
+
 static void *array_list_get(list *self, int index);
 
 static ova_error_code array_list_remove(list *self, int index);
 
+static ova_error_code array_list_remove_range(list *self, int from, int to);
+
 static int array_list_size(const list *self);
 
 static void array_list_clear(list *self);
 
+static ova_error_code array_list_reserve(list *self, int capacity);
+
+static ova_error_code array_list_data_span(list *self, void ***items, int *count);
+
 static void array_list_free(list *self);
 
 list *create_array_list(int initial_capacity) {
@@ -34,10 +45,15 @@ list *create_array_list(int initial_capacity) {
 
         lst->impl = impl;
         lst->insert = array_list_insert;
+        lst->insert_bulk = array_list_insert_bulk;
+        lst->insert_range = array_list_insert_range;
         lst->get = array_list_get;
         lst->remove = array_list_remove;
+        lst->remove_range = array_list_remove_range;
         lst->size = array_list_size;
         lst->clear = array_list_clear;
+        lst->reserve = array_list_reserve;
+        lst->data_span = array_list_data_span;
         lst->free = array_list_free;
         lst->user_data = NULL;
         return lst;
@@ -53,22 +69,36 @@ static int get_size_from_impl(void *impl) {
     return internal->size;
 }
 
+static int resize_items(array_list_impl *impl, int new_capacity) {
+    void **new_items = realloc(impl->items, (size_t)new_capacity * sizeof(void *));
+    if (new_items == NULL) {
+        return 0;
+    }
+    impl->items = new_items;
+    impl->capacity = new_capacity;
+    return 1;
+}
+
 static int ensure_capacity(array_list_impl *impl) {
     if (impl->size >= impl->capacity) {
         int new_capacity = safe_double_capacity(impl->capacity);
         if (new_capacity == impl->capacity) {
             return 0; // Already at maximum capacity
         }
-        void **new_items = realloc(impl->items, (size_t)new_capacity * sizeof(void *));
-        if (new_items == NULL) {
-            return 0; // Signal failure
-        }
-        impl->items = new_items;
-        impl->capacity = new_capacity;
+        return resize_items(impl, new_capacity);
     }
     return 1; // Success
 }
 
+/* One growth step for a range insert: double, or jump straight to @p needed. */
+static int ensure_capacity_for(array_list_impl *impl, int needed) {
+    if (needed <= impl->capacity) {
+        return 1;
+    }
+    int new_capacity = safe_double_capacity(impl->capacity);
+    return resize_items(impl, new_capacity > needed ? new_capacity : needed);
+}
+
 static ova_error_code array_list_insert(list *self, void *item, int index) {
     array_list_impl *impl = (array_list_impl *) self->impl;
     if (index < 0 || index > impl->size) return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
@@ -81,6 +111,27 @@ static ova_error_code array_list_insert(list *self, void *item, int index) {
     return OVA_SUCCESS;
 }
 
+static ova_error_code array_list_insert_range(list *self, int index, void **elements, int count) {
+    array_list_impl *impl = self ? (array_list_impl *) self->impl : NULL;
+    if (!impl || count < 0 || (count > 0 && !elements)) return OVA_ERROR_INVALID_ARG;
+    if (index < 0 || index > impl->size) return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    if (count > INT_MAX - impl->size) return OVA_ERROR_MEMORY;
+    if (!ensure_capacity_for(impl, impl->size + count)) {
+        return OVA_ERROR_MEMORY;
+    }
+    memmove(&impl->items[index + count], &impl->items[index], (size_t)(impl->size - index) * sizeof(void *));
+    if (count > 0) {
+        memcpy(&impl->items[index], elements, (size_t)count * sizeof(void *));
+    }
+    impl->size += count;
+    return OVA_SUCCESS;
+}
+
+static ova_error_code array_list_insert_bulk(list *self, void **elements, int count) {
+    if (!self || !self->impl || !elements || count <= 0) return OVA_ERROR_INVALID_ARG;
+    return array_list_insert_range(self, array_list_size(self), elements, count);
+}
+
 static void *array_list_get(list *self, int index) {
     array_list_impl *impl = (array_list_impl *) self->impl;
     if (index < 0 || index >= impl->size) return NULL;
@@ -95,6 +146,15 @@ static ova_error_code array_list_remove(list *self, int index) {
     return OVA_SUCCESS;
 }
 
+static ova_error_code array_list_remove_range(list *self, int from, int to) {
+    array_list_impl *impl = self ? (array_list_impl *) self->impl : NULL;
+    if (!impl) return OVA_ERROR_INVALID_ARG;
+    if (from < 0 || from > to || to > impl->size) return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    memmove(&impl->items[from], &impl->items[to], (size_t)(impl->size - to) * sizeof(void *));
+    impl->size -= to - from;
+    return OVA_SUCCESS;
+}
+
 static int array_list_size(const list *self) {
     if (!self || !self->impl) return 0;
     return get_size_from_impl(self->impl);
@@ -107,6 +167,21 @@ static void array_list_clear(list *self) {
     }
 }
 
+static ova_error_code array_list_reserve(list *self, int capacity) {
+    array_list_impl *impl = self ? (array_list_impl *) self->impl : NULL;
+    if (!impl || capacity < 0) return OVA_ERROR_INVALID_ARG;
+    if (capacity <= impl->capacity) return OVA_SUCCESS;
+    return resize_items(impl, capacity) ? OVA_SUCCESS : OVA_ERROR_MEMORY;
+}
+
+static ova_error_code array_list_data_span(list *self, void ***items, int *count) {
+    array_list_impl *impl = self ? (array_list_impl *) self->impl : NULL;
+    if (!impl || !items || !count) return OVA_ERROR_INVALID_ARG;
+    *items = impl->items;
+    *count = impl->size;
+    return OVA_SUCCESS;
+}
+
 static void array_list_free(list *self) {
     if (self) {
         array_list_impl *impl = (array_list_impl *) self->impl;
@@ -125,6 +200,14 @@ static void array_list_free(list *self) {
     }
 }
 
+void **array_list_data(list *lst) {
+    if (!lst || !lst->impl || lst->get != array_list_get) {
+        return NULL;
+    }
+    array_list_impl *impl = (array_list_impl *) lst->impl;
+    return impl->items;
+}
+
 size_t array_list_active_buffer_count(void) {
     return active_item_buffers;
 }
@@ -5,4 +5,14 @@
 
 list *create_array_list(int initial_capacity);
 
+/**
+ * @brief Borrow the contiguous item buffer of an array list.
+ *
+ * Lets internal algorithms permute the stored pointers in place. The buffer
+ * holds size() entries and stays valid until the next insert or remove.
+ *
+ * @return The item buffer, or NULL when @p lst is not an array list.
+ */
+void **array_list_data(list *lst);
+
 #endif // ARRAY_LIST_H
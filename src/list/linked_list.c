@@ -1,4 +1,5 @@
 #include "../../include/list.h"
+#include "linked_list.h"
 #include <stdlib.h>
 
 typedef struct linked_list_node {
@@ -20,6 +21,7 @@ typedef struct {
 static ova_error_code linked_list_insert(list *self, void *item, int index);
 static void *linked_list_get(list *self, int index);
 static ova_error_code linked_list_remove(list *self, int index);
+static ova_error_code linked_list_remove_range(list *self, int from, int to);
 static void linked_list_clear(list *self);
 static void linked_list_free(list *self);
 static int linked_list_size(const list *self);
@@ -37,10 +39,15 @@ list *create_linked_list(void) {
 
         lst->impl = impl;
         lst->insert = linked_list_insert;
+        lst->insert_bulk = NULL;
+        lst->insert_range = NULL;
         lst->get = linked_list_get;
         lst->remove = linked_list_remove;
+        lst->remove_range = linked_list_remove_range;
         lst->size = linked_list_size;
         lst->clear = linked_list_clear;
+        lst->reserve = NULL;
+        lst->data_span = NULL;
         lst->free = linked_list_free;
         lst->user_data = NULL;
         return lst;
@@ -184,6 +191,49 @@ static ova_error_code linked_list_remove(list *self, int index) {
     return OVA_SUCCESS;
 }
 
+/* Walks to @p from once and unlinks the run, instead of one walk per item. */
+static ova_error_code linked_list_remove_range(list *self, int from, int to) {
+    linked_list_impl *impl = self ? (linked_list_impl *)self->impl : NULL;
+    if (!impl) return OVA_ERROR_INVALID_ARG;
+    if (from < 0 || from > to || to > impl->size) return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    if (from == to) return OVA_SUCCESS;
+    impl->cursor_node = NULL;
+    impl->cursor_index = -1;
+
+    linked_list_node *first;
+    if (from < impl->size / 2) {
+        first = impl->head;
+        for (int i = 0; i < from; i++) {
+            first = first->next;
+        }
+    } else {
+        first = impl->tail;
+        for (int i = impl->size - 1; i > from; i--) {
+            first = first->prev;
+        }
+    }
+
+    linked_list_node *before = first->prev;
+    linked_list_node *current = first;
+    for (int i = from; i < to; i++) {
+        linked_list_node *next = current->next;
+        free(current);
+        current = next;
+    }
+    if (before) {
+        before->next = current;
+    } else {
+        impl->head = current;
+    }
+    if (current) {
+        current->prev = before;
+    } else {
+        impl->tail = before;
+    }
+    impl->size -= to - from;
+    return OVA_SUCCESS;
+}
+
 static int linked_list_size(const list *self) {
     if (!self || !self->impl) return 0;
     linked_list_impl *impl = (linked_list_impl *)self->impl;
@@ -221,3 +271,18 @@ static void linked_list_free(list *self) {
     }
     free(self);
 }
+
+bool linked_list_assign(list *lst, void *const *items, int n) {
+    if (!lst || !lst->impl || lst->get != linked_list_get) {
+        return false;
+    }
+    linked_list_impl *impl = (linked_list_impl *)lst->impl;
+    if (n != impl->size || (n > 0 && !items)) {
+        return false;
+    }
+    int i = 0;
+    for (linked_list_node *node = impl->head; node; node = node->next) {
+        node->data = items[i++];
+    }
+    return true;
+}
@@ -5,4 +5,12 @@
 
 list *create_linked_list(void);
 
+/**
+ * @brief Overwrite the payloads of a linked list front to back.
+ *
+ * @param items Replacement payloads; @p n must equal the list size.
+ * @return false when @p lst is not a linked list or the sizes differ.
+ */
+bool linked_list_assign(list *lst, void *const *items, int n);
+
 #endif // LINKED_LIST_H
@@ -2,6 +2,9 @@
 #include "array_list.h"
 #include "linked_list.h"
 #include "sorted_list.h"
+#include "sorted_block_list.h"
+#include "unrolled_list.h"
+#include "value_array_list.h"
 
 #include <string.h>
 
@@ -19,9 +22,79 @@ static ova_error_code list_insert_bulk_impl(list *self, void **elements, int cou
     return OVA_SUCCESS;
 }
 
+static ova_error_code list_insert_range_impl(list *self, int index, void **elements, int count) {
+    if (!self || count < 0 || (count > 0 && !elements)) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < count; i++) {
+        ova_error_code err = self->insert(self, elements[i], index + i);
+        if (err != OVA_SUCCESS) {
+            return err;
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static ova_error_code list_remove_range_impl(list *self, int from, int to) {
+    if (!self) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (from < 0 || from > to || to > self->size(self)) {
+        return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    for (int i = from; i < to; i++) {
+        ova_error_code err = self->remove(self, from);
+        if (err != OVA_SUCCESS) {
+            return err;
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static ova_error_code list_reserve_impl(list *self, int capacity) {
+    return self && capacity >= 0 ? OVA_SUCCESS : OVA_ERROR_INVALID_ARG;
+}
+
+static ova_error_code list_data_span_impl(list *self, void ***items, int *count) {
+    (void)self;
+    if (items) {
+        *items = NULL;
+    }
+    if (count) {
+        *count = 0;
+    }
+    return OVA_ERROR_INVALID_ARG;
+}
+
 static list *list_clone_shallow_impl(const list *self);
 static list *list_clone_deep_impl(const list *self, element_copier copier);
 
+static void list_init_common(list *out, ListType type, comparator cmp, size_t element_size) {
+    out->_type = type;
+    out->_cmp = cmp;
+    out->_element_size = element_size;
+    /* Backends without native bulk or range paths get element-at-a-time fallbacks. */
+    if (!out->insert_bulk) {
+        out->insert_bulk = list_insert_bulk_impl;
+    }
+    if (!out->insert_range) {
+        out->insert_range = list_insert_range_impl;
+    }
+    if (!out->remove_range) {
+        out->remove_range = list_remove_range_impl;
+    }
+    if (!out->reserve) {
+        out->reserve = list_reserve_impl;
+    }
+    if (!out->data_span) {
+        out->data_span = list_data_span_impl;
+    }
+    out->clone_shallow = list_clone_shallow_impl;
+    out->clone_deep = list_clone_deep_impl;
+}
+
 list *create_list(ListType type, int initial_capacity, comparator cmp) {
     list *out = NULL;
 
@@ -35,27 +108,49 @@ list *create_list(ListType type, int initial_capacity, comparator cmp) {
         case SORTED_LIST:
             out = create_sorted_list(initial_capacity, cmp);
             break;
+        case SORTED_BLOCK_LIST:
+            out = create_sorted_block_list(cmp);
+            break;
+        case UNROLLED_LIST:
+            out = create_unrolled_list();
+            break;
         default:
             return NULL;
     }
 
     if (out) {
-        out->_type = type;
-        out->_cmp = cmp;
-        out->insert_bulk = list_insert_bulk_impl;
-        out->clone_shallow = list_clone_shallow_impl;
-        out->clone_deep = list_clone_deep_impl;
+        list_init_common(out, type, cmp, 0);
     }
     return out;
 }
 
+list *create_list_of(ListType type, size_t element_size, int initial_capacity) {
+    if (type != ARRAY_LIST) {
+        return NULL;
+    }
+
+    list *out = create_value_array_list(element_size, initial_capacity);
+    if (out) {
+        list_init_common(out, type, NULL, element_size);
+    }
+    return out;
+}
+
+/* Empty list of the same kind as @p self, sized for @p n elements. */
+static list *list_create_like(const list *self, int n) {
+    if (self->_element_size > 0) {
+        return create_list_of(self->_type, self->_element_size, n > 0 ? n : 1);
+    }
+    return create_list(self->_type, n > 0 ? n : 1, self->_cmp);
+}
+
 static list *list_clone_shallow_impl(const list *self) {
     if (!self) {
         return NULL;
     }
 
     int n = self->size(self);
-    list *copy = create_list(self->_type, n > 0 ? n : 1, self->_cmp);
+    list *copy = list_create_like(self, n);
     if (!copy) {
         return NULL;
     }
@@ -76,12 +171,15 @@ static list *list_clone_shallow_impl(const list *self) {
 }
 
 static list *list_clone_deep_impl(const list *self, element_copier copier) {
+    if (self && self->_element_size > 0) {
+        return list_clone_shallow_impl(self); // Values are copied either way
+    }
     if (!self || !copier) {
         return NULL;
     }
 
     int n = self->size(self);
-    list *copy = create_list(self->_type, n > 0 ? n : 1, self->_cmp);
+    list *copy = list_create_like(self, n);
     if (!copy) {
         return NULL;
     }
@@ -0,0 +1,347 @@
+#include "sorted_block_list.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Sorted list kept as an ordered directory of small sorted blocks. Inserts
+ * and removes move at most one block's items, and a Fenwick tree over the
+ * block sizes turns an index into (block, offset) in O(log blocks), so
+ * every operation is O(log n + SORTED_BLOCK_MAX) instead of the O(n) tail
+ * shift of the flat SORTED_LIST.
+ */
+
+/* Items per block; a full block splits into two halves. */
+#define SORTED_BLOCK_MAX 1024
+/* A block below this size merges with a neighbour when both fit in half a block. */
+#define SORTED_BLOCK_MIN (SORTED_BLOCK_MAX / 4)
+
+typedef struct {
+    int count;
+    void *items[SORTED_BLOCK_MAX];
+} sorted_block;
+
+typedef struct {
+    sorted_block **blocks;
+    void **lasts; /* last item of each block, contiguous for the directory search */
+    int block_count;
+    int block_capacity;
+    int *tree; /* Fenwick tree over block counts, 1-based, block_capacity + 1 slots */
+    int size;
+    comparator cmp;
+    /* Block of the last get() and the list index of its first item, so
+     * sequential scans skip the tree walk. cursor_block == -1 when stale. */
+    int cursor_block;
+    int cursor_start;
+} sorted_block_list_impl;
+
+static ova_error_code sorted_block_list_insert(list *self, void *item, int index);
+static void *sorted_block_list_get(list *self, int index);
+static ova_error_code sorted_block_list_remove(list *self, int index);
+static int sorted_block_list_size(const list *self);
+static void sorted_block_list_clear(list *self);
+static void sorted_block_list_free(list *self);
+
+list *create_sorted_block_list(comparator cmp) {
+    if (!cmp) {
+        return NULL;
+    }
+
+    list *lst = malloc(sizeof(list));
+    sorted_block_list_impl *impl = malloc(sizeof(sorted_block_list_impl));
+    if (!lst || !impl) {
+        free(lst);
+        free(impl);
+        return NULL;
+    }
+
+    impl->blocks = NULL;
+    impl->lasts = NULL;
+    impl->block_count = 0;
+    impl->block_capacity = 0;
+    impl->tree = NULL;
+    impl->size = 0;
+    impl->cmp = cmp;
+    impl->cursor_block = -1;
+    impl->cursor_start = 0;
+
+    lst->impl = impl;
+    lst->insert = sorted_block_list_insert;
+    lst->insert_bulk = NULL;
+    lst->insert_range = NULL;
+    lst->get = sorted_block_list_get;
+    lst->remove = sorted_block_list_remove;
+    lst->remove_range = NULL;
+    lst->size = sorted_block_list_size;
+    lst->clear = sorted_block_list_clear;
+    lst->reserve = NULL;
+    lst->data_span = NULL;
+    lst->free = sorted_block_list_free;
+    lst->user_data = NULL;
+
+    return lst;
+}
+
+static sorted_block_list_impl *get_impl(const list *self) {
+    return self ? (sorted_block_list_impl *)self->impl : NULL;
+}
+
+static void tree_add(sorted_block_list_impl *impl, int block, int delta) {
+    for (int i = block + 1; i <= impl->block_count; i += i & -i) {
+        impl->tree[i] += delta;
+    }
+}
+
+/* O(blocks) rebuild after the directory itself changes. */
+static void tree_rebuild(sorted_block_list_impl *impl) {
+    int n = impl->block_count;
+    for (int i = 1; i <= n; i++) {
+        impl->tree[i] = impl->blocks[i - 1]->count;
+    }
+    for (int i = 1; i <= n; i++) {
+        int parent = i + (i & -i);
+        if (parent <= n) {
+            impl->tree[parent] += impl->tree[i];
+        }
+    }
+}
+
+/* Block holding list position @p index; *offset receives its place inside it. */
+static int tree_locate(const sorted_block_list_impl *impl, int index, int *offset) {
+    int pos = 0;
+    int step = 1;
+    while (step * 2 <= impl->block_count) {
+        step *= 2;
+    }
+    for (; step > 0; step /= 2) {
+        if (pos + step <= impl->block_count && impl->tree[pos + step] <= index) {
+            pos += step;
+            index -= impl->tree[pos];
+        }
+    }
+    *offset = index;
+    return pos;
+}
+
+static int ensure_directory(sorted_block_list_impl *impl) {
+    if (impl->block_count < impl->block_capacity) {
+        return 1;
+    }
+    int new_capacity = impl->block_capacity > 0 ? impl->block_capacity * 2 : 4;
+    sorted_block **blocks = realloc(impl->blocks, sizeof(sorted_block *) * (size_t)new_capacity);
+    if (!blocks) {
+        return 0;
+    }
+    impl->blocks = blocks;
+    void **lasts = realloc(impl->lasts, sizeof(void *) * (size_t)new_capacity);
+    if (!lasts) {
+        return 0;
+    }
+    impl->lasts = lasts;
+    int *tree = realloc(impl->tree, sizeof(int) * (size_t)(new_capacity + 1));
+    if (!tree) {
+        return 0;
+    }
+    impl->tree = tree;
+    impl->block_capacity = new_capacity;
+    return 1;
+}
+
+/* Insert @p block into the directory at @p at; the caller rebuilds the tree. */
+static void directory_insert(sorted_block_list_impl *impl, int at, sorted_block *block) {
+    memmove(&impl->blocks[at + 1], &impl->blocks[at],
+            sizeof(sorted_block *) * (size_t)(impl->block_count - at));
+    memmove(&impl->lasts[at + 1], &impl->lasts[at], sizeof(void *) * (size_t)(impl->block_count - at));
+    impl->blocks[at] = block;
+    impl->block_count++;
+}
+
+static void directory_remove(sorted_block_list_impl *impl, int at) {
+    free(impl->blocks[at]);
+    memmove(&impl->blocks[at], &impl->blocks[at + 1],
+            sizeof(sorted_block *) * (size_t)(impl->block_count - at - 1));
+    memmove(&impl->lasts[at], &impl->lasts[at + 1], sizeof(void *) * (size_t)(impl->block_count - at - 1));
+    impl->block_count--;
+}
+
+/* First block whose last item is not less than @p item, or the last block. */
+static int find_block(const sorted_block_list_impl *impl, void *item) {
+    int left = 0;
+    int right = impl->block_count - 1;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        if (impl->cmp(item, impl->lasts[mid]) > 0) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+static int find_insert_position(const sorted_block_list_impl *impl, const sorted_block *block, void *item) {
+    int left = 0;
+    int right = block->count;
+    while (left < right) {
+        int mid = left + (right - left) / 2;
+        if (impl->cmp(item, block->items[mid]) > 0) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+static ova_error_code sorted_block_list_insert(list *self, void *item, int index) {
+    (void)index; // Index is ignored to keep the list sorted
+    sorted_block_list_impl *impl = get_impl(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    impl->cursor_block = -1;
+
+    if (impl->block_count == 0) {
+        sorted_block *first = malloc(sizeof(sorted_block));
+        if (!first || !ensure_directory(impl)) {
+            free(first);
+            return OVA_ERROR_MEMORY;
+        }
+        first->count = 0;
+        directory_insert(impl, 0, first);
+        tree_rebuild(impl);
+    }
+
+    int b = find_block(impl, item);
+    sorted_block *block = impl->blocks[b];
+    int pos = find_insert_position(impl, block, item);
+
+    if (block->count == SORTED_BLOCK_MAX) {
+        sorted_block *upper = malloc(sizeof(sorted_block));
+        if (!upper || !ensure_directory(impl)) {
+            free(upper);
+            return OVA_ERROR_MEMORY;
+        }
+        int half = SORTED_BLOCK_MAX / 2;
+        upper->count = SORTED_BLOCK_MAX - half;
+        memcpy(upper->items, &block->items[half], sizeof(void *) * (size_t)upper->count);
+        block->count = half;
+        impl->lasts[b] = block->items[half - 1];
+        directory_insert(impl, b + 1, upper);
+        impl->lasts[b + 1] = upper->items[upper->count - 1];
+        tree_rebuild(impl);
+        if (pos > half) {
+            b++;
+            block = upper;
+            pos -= half;
+        }
+    }
+
+    memmove(&block->items[pos + 1], &block->items[pos], sizeof(void *) * (size_t)(block->count - pos));
+    block->items[pos] = item;
+    block->count++;
+    impl->lasts[b] = block->items[block->count - 1];
+    tree_add(impl, b, 1);
+    impl->size++;
+    return OVA_SUCCESS;
+}
+
+static void *sorted_block_list_get(list *self, int index) {
+    sorted_block_list_impl *impl = get_impl(self);
+    if (!impl || index < 0 || index >= impl->size) {
+        return NULL;
+    }
+
+    int b = impl->cursor_block;
+    if (b >= 0 && index >= impl->cursor_start) {
+        int offset = index - impl->cursor_start;
+        if (offset < impl->blocks[b]->count) {
+            return impl->blocks[b]->items[offset];
+        }
+        if (offset == impl->blocks[b]->count && b + 1 < impl->block_count) {
+            impl->cursor_start += impl->blocks[b]->count;
+            impl->cursor_block = b + 1;
+            return impl->blocks[b + 1]->items[0];
+        }
+    }
+
+    int offset = 0;
+    b = tree_locate(impl, index, &offset);
+    impl->cursor_block = b;
+    impl->cursor_start = index - offset;
+    return impl->blocks[b]->items[offset];
+}
+
+static ova_error_code sorted_block_list_remove(list *self, int index) {
+    sorted_block_list_impl *impl = get_impl(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (index < 0 || index >= impl->size) {
+        return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+    impl->cursor_block = -1;
+
+    int offset = 0;
+    int b = tree_locate(impl, index, &offset);
+    sorted_block *block = impl->blocks[b];
+    memmove(&block->items[offset], &block->items[offset + 1],
+            sizeof(void *) * (size_t)(block->count - offset - 1));
+    block->count--;
+    impl->size--;
+    if (block->count > 0) {
+        impl->lasts[b] = block->items[block->count - 1];
+    }
+
+    if (block->count == 0) {
+        directory_remove(impl, b);
+        tree_rebuild(impl);
+        return OVA_SUCCESS;
+    }
+    if (block->count < SORTED_BLOCK_MIN) {
+        /* Fold the smaller of the two blocks into the left one. */
+        int left = b + 1 < impl->block_count ? b : b - 1;
+        if (left >= 0) {
+            sorted_block *dst = impl->blocks[left];
+            sorted_block *src = impl->blocks[left + 1];
+            if (dst->count + src->count <= SORTED_BLOCK_MAX / 2) {
+                memcpy(&dst->items[dst->count], src->items, sizeof(void *) * (size_t)src->count);
+                dst->count += src->count;
+                impl->lasts[left] = dst->items[dst->count - 1];
+                directory_remove(impl, left + 1);
+                tree_rebuild(impl);
+                return OVA_SUCCESS;
+            }
+        }
+    }
+    tree_add(impl, b, -1);
+    return OVA_SUCCESS;
+}
+
+static int sorted_block_list_size(const list *self) {
+    const sorted_block_list_impl *impl = get_impl(self);
+    return impl ? impl->size : 0;
+}
+
+static void sorted_block_list_clear(list *self) {
+    sorted_block_list_impl *impl = get_impl(self);
+    if (impl) {
+        for (int i = 0; i < impl->block_count; i++) {
+            free(impl->blocks[i]);
+        }
+        impl->block_count = 0;
+        impl->size = 0;
+        impl->cursor_block = -1;
+    }
+}
+
+static void sorted_block_list_free(list *self) {
+    sorted_block_list_impl *impl = get_impl(self);
+    if (impl) {
+        sorted_block_list_clear(self);
+        free(impl->blocks);
+        free(impl->lasts);
+        free(impl->tree);
+        free(impl);
+    }
+    free(self);
+}
@@ -0,0 +1,9 @@
+#ifndef SORTED_BLOCK_LIST_H
+#define SORTED_BLOCK_LIST_H
+
+#include "../../include/types.h"
+#include "../../include/list.h"
+
+list *create_sorted_block_list(comparator cmp);
+
+#endif // SORTED_BLOCK_LIST_H
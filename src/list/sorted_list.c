@@ -1,4 +1,5 @@
 #include "sorted_list.h"
+#include "../utils/capacity_utils.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -10,10 +11,15 @@ typedef struct {
 } sorted_list_impl;
 
 static ova_error_code sorted_list_insert(list *self, void *item, int index);
+static ova_error_code sorted_list_insert_bulk(list *self, void **elements, int count);
+static ova_error_code sorted_list_insert_range(list *self, int index, void **elements, int count);
 static void *sorted_list_get(list *self, int index);
 static ova_error_code sorted_list_remove(list *self, int index);
+static ova_error_code sorted_list_remove_range(list *self, int from, int to);
 static int sorted_list_size(const list *self);
 static void sorted_list_clear(list *self);
+static ova_error_code sorted_list_reserve(list *self, int capacity);
+static ova_error_code sorted_list_data_span(list *self, void ***items, int *count);
 static void sorted_list_free(list *self);
 
 static int clamp_initial_capacity(int initial_capacity) {
@@ -47,10 +53,15 @@ list *create_sorted_list(int initial_capacity, comparator cmp) {
 
     lst->impl = impl;
     lst->insert = sorted_list_insert;
+    lst->insert_bulk = sorted_list_insert_bulk;
+    lst->insert_range = sorted_list_insert_range;
     lst->get = sorted_list_get;
     lst->remove = sorted_list_remove;
+    lst->remove_range = sorted_list_remove_range;
     lst->size = sorted_list_size;
     lst->clear = sorted_list_clear;
+    lst->reserve = sorted_list_reserve;
+    lst->data_span = sorted_list_data_span;
     lst->free = sorted_list_free;
     lst->user_data = NULL;
 
@@ -110,6 +121,126 @@ static ova_error_code sorted_list_insert(list *self, void *item, int index) {
     return OVA_SUCCESS;
 }
 
+/* Stable bottom-up merge sort of @p a using @p tmp; returns whichever holds the result. */
+static void **merge_sort_batch(void **a, void **tmp, int n, comparator cmp) {
+    for (int width = 1; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = lo + width < n ? lo + width : n;
+            int hi = mid + width < n ? mid + width : n;
+            int i = lo;
+            int j = mid;
+            int k = lo;
+            while (i < mid && j < hi) {
+                tmp[k++] = cmp(a[j], a[i]) < 0 ? a[j++] : a[i++];
+            }
+            while (i < mid) tmp[k++] = a[i++];
+            while (j < hi) tmp[k++] = a[j++];
+        }
+        void **swap = a;
+        a = tmp;
+        tmp = swap;
+    }
+    return a;
+}
+
+static int is_sorted_batch(void **a, int n, comparator cmp) {
+    for (int i = 1; i < n; i++) {
+        if (cmp(a[i], a[i - 1]) < 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Sorts a copy of the batch (skipped when it is already in order), grows
+ * the item array at most once, and merges from the back so each existing
+ * item moves once: O(count log count + size) instead of count tail shifts.
+ * Batch items land before existing items that compare equal and keep their
+ * batch order among themselves.
+ */
+static ova_error_code sorted_list_insert_bulk(list *self, void **elements, int count) {
+    sorted_list_impl *impl = get_impl(self);
+    if (!impl || !elements || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (count > INT_MAX - impl->size) {
+        return OVA_ERROR_MEMORY;
+    }
+
+    void **batch = elements;
+    void **scratch = NULL;
+    if (!is_sorted_batch(elements, count, impl->cmp)) {
+        scratch = malloc(sizeof(void *) * (size_t)count * 2);
+        if (!scratch) {
+            return OVA_ERROR_MEMORY;
+        }
+        memcpy(scratch, elements, sizeof(void *) * (size_t)count);
+        batch = merge_sort_batch(scratch, scratch + count, count, impl->cmp);
+    }
+
+    int needed = impl->size + count;
+    if (needed > impl->capacity) {
+        int new_capacity = safe_double_capacity(impl->capacity);
+        if (new_capacity < needed) {
+            new_capacity = needed;
+        }
+        void **new_items = realloc(impl->items, sizeof(void *) * (size_t)new_capacity);
+        if (!new_items) {
+            free(scratch);
+            return OVA_ERROR_MEMORY;
+        }
+        impl->items = new_items;
+        impl->capacity = new_capacity;
+    }
+
+    int i = impl->size - 1;
+    int j = count - 1;
+    int k = needed - 1;
+    if ((long long)count * 32 < impl->size) {
+        /* Small batch: binary-search where each batch item goes and move the
+         * existing run after it in one memmove, so comparisons scale with
+         * count * log(size) rather than size. */
+        while (j >= 0) {
+            int left = 0;
+            int right = i + 1;
+            while (left < right) {
+                int mid = left + (right - left) / 2;
+                if (impl->cmp(impl->items[mid], batch[j]) < 0) {
+                    left = mid + 1;
+                } else {
+                    right = mid;
+                }
+            }
+            int run = i + 1 - left;
+            k -= run;
+            memmove(&impl->items[k + 1], &impl->items[left], sizeof(void *) * (size_t)run);
+            i = left - 1;
+            impl->items[k--] = batch[j--];
+        }
+    } else {
+        while (j >= 0) {
+            if (i >= 0 && impl->cmp(impl->items[i], batch[j]) >= 0) {
+                impl->items[k--] = impl->items[i--];
+            } else {
+                impl->items[k--] = batch[j--];
+            }
+        }
+    }
+    impl->size = needed;
+
+    free(scratch);
+    return OVA_SUCCESS;
+}
+
+static ova_error_code sorted_list_insert_range(list *self, int index, void **elements, int count) {
+    (void)index; // Index is ignored to keep the list sorted
+    if (!get_impl(self) || count < 0 || (count > 0 && !elements)) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    return count > 0 ? sorted_list_insert_bulk(self, elements, count) : OVA_SUCCESS;
+}
+
 static void *sorted_list_get(list *self, int index) {
     sorted_list_impl *impl = get_impl(self);
     if (!impl || index < 0 || index >= impl->size) {
@@ -133,6 +264,20 @@ static ova_error_code sorted_list_remove(list *self, int index) {
     return OVA_SUCCESS;
 }
 
+static ova_error_code sorted_list_remove_range(list *self, int from, int to) {
+    sorted_list_impl *impl = get_impl(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (from < 0 || from > to || to > impl->size) {
+        return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    memmove(&impl->items[from], &impl->items[to], (size_t)(impl->size - to) * sizeof(void *));
+    impl->size -= to - from;
+    return OVA_SUCCESS;
+}
+
 static int sorted_list_size(const list *self) {
     const sorted_list_impl *impl = get_impl(self);
     return impl ? impl->size : 0;
@@ -145,6 +290,34 @@ static void sorted_list_clear(list *self) {
     }
 }
 
+static ova_error_code sorted_list_reserve(list *self, int capacity) {
+    sorted_list_impl *impl = get_impl(self);
+    if (!impl || capacity < 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (capacity <= impl->capacity) {
+        return OVA_SUCCESS;
+    }
+
+    void **new_items = realloc(impl->items, sizeof(void *) * (size_t)capacity);
+    if (!new_items) {
+        return OVA_ERROR_MEMORY;
+    }
+    impl->items = new_items;
+    impl->capacity = capacity;
+    return OVA_SUCCESS;
+}
+
+static ova_error_code sorted_list_data_span(list *self, void ***items, int *count) {
+    sorted_list_impl *impl = get_impl(self);
+    if (!impl || !items || !count) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    *items = impl->items;
+    *count = impl->size;
+    return OVA_SUCCESS;
+}
+
 static void sorted_list_free(list *self) {
     sorted_list_impl *impl = get_impl(self);
     if (impl) {
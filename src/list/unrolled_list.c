@@ -0,0 +1,284 @@
+#include "unrolled_list.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Doubly linked list of small item arrays. Scans read UNROLLED_NODE_MAX
+ * pointers per node hop, and an insert or remove shifts at most one node's
+ * items, so positional updates cost O(n / UNROLLED_NODE_MAX) node hops
+ * plus one short memmove instead of a pointer chase per element.
+ */
+
+/* Items per node; a full node splits into two halves. */
+#define UNROLLED_NODE_MAX 64
+/* A node below this size merges with a neighbour when both fit in half a node. */
+#define UNROLLED_NODE_MIN (UNROLLED_NODE_MAX / 4)
+
+typedef struct unrolled_node {
+    struct unrolled_node *next;
+    struct unrolled_node *prev;
+    int count;
+    void *items[UNROLLED_NODE_MAX];
+} unrolled_node;
+
+typedef struct {
+    unrolled_node *head;
+    unrolled_node *tail;
+    int size;
+    /* Node of the last lookup and the list index of its first item, so
+     * sequential and nearby accesses skip the walk. cursor_node == NULL
+     * when stale. */
+    unrolled_node *cursor_node;
+    int cursor_start;
+} unrolled_list_impl;
+
+static ova_error_code unrolled_list_insert(list *self, void *item, int index);
+static void *unrolled_list_get(list *self, int index);
+static ova_error_code unrolled_list_remove(list *self, int index);
+static int unrolled_list_size(const list *self);
+static void unrolled_list_clear(list *self);
+static void unrolled_list_free(list *self);
+
+list *create_unrolled_list(void) {
+    list *lst = malloc(sizeof(list));
+    unrolled_list_impl *impl = malloc(sizeof(unrolled_list_impl));
+    if (!lst || !impl) {
+        free(lst);
+        free(impl);
+        return NULL;
+    }
+
+    impl->head = NULL;
+    impl->tail = NULL;
+    impl->size = 0;
+    impl->cursor_node = NULL;
+    impl->cursor_start = 0;
+
+    lst->impl = impl;
+    lst->insert = unrolled_list_insert;
+    lst->insert_bulk = NULL;
+    lst->insert_range = NULL;
+    lst->get = unrolled_list_get;
+    lst->remove = unrolled_list_remove;
+    lst->remove_range = NULL;
+    lst->size = unrolled_list_size;
+    lst->clear = unrolled_list_clear;
+    lst->reserve = NULL;
+    lst->data_span = NULL;
+    lst->free = unrolled_list_free;
+    lst->user_data = NULL;
+
+    return lst;
+}
+
+static unrolled_list_impl *get_impl(const list *self) {
+    return self ? (unrolled_list_impl *)self->impl : NULL;
+}
+
+/*
+ * Node holding list position @p index (0 <= index < size) and the index of
+ * its first item, walking from the head, the tail or the cursor, whichever
+ * is closest.
+ */
+static unrolled_node *locate(unrolled_list_impl *impl, int index, int *start) {
+    unrolled_node *node = impl->head;
+    int node_start = 0;
+    int best = index;
+
+    int tail_start = impl->size - impl->tail->count;
+    if (impl->size - 1 - index < best) {
+        node = impl->tail;
+        node_start = tail_start;
+        best = impl->size - 1 - index;
+    }
+    if (impl->cursor_node) {
+        int distance = index - impl->cursor_start;
+        if (distance < 0) {
+            distance = -distance;
+        }
+        if (distance < best) {
+            node = impl->cursor_node;
+            node_start = impl->cursor_start;
+        }
+    }
+
+    while (index < node_start) {
+        node = node->prev;
+        node_start -= node->count;
+    }
+    while (index >= node_start + node->count) {
+        node_start += node->count;
+        node = node->next;
+    }
+
+    impl->cursor_node = node;
+    impl->cursor_start = node_start;
+    *start = node_start;
+    return node;
+}
+
+static unrolled_node *new_node_after(unrolled_list_impl *impl, unrolled_node *prev) {
+    unrolled_node *node = malloc(sizeof(unrolled_node));
+    if (!node) {
+        return NULL;
+    }
+    node->count = 0;
+    node->prev = prev;
+    node->next = prev ? prev->next : impl->head;
+    if (node->next) {
+        node->next->prev = node;
+    } else {
+        impl->tail = node;
+    }
+    if (prev) {
+        prev->next = node;
+    } else {
+        impl->head = node;
+    }
+    return node;
+}
+
+static void unlink_node(unrolled_list_impl *impl, unrolled_node *node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        impl->head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        impl->tail = node->prev;
+    }
+    free(node);
+}
+
+static ova_error_code unrolled_list_insert(list *self, void *item, int index) {
+    unrolled_list_impl *impl = get_impl(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (index < 0 || index > impl->size) {
+        return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    unrolled_node *node;
+    int offset;
+    if (index == impl->size) {
+        /* Appends fill the tail and open a fresh node rather than splitting,
+         * so a list built front to back keeps its nodes full. */
+        node = impl->tail;
+        if (!node || node->count == UNROLLED_NODE_MAX) {
+            node = new_node_after(impl, impl->tail);
+            if (!node) {
+                return OVA_ERROR_MEMORY;
+            }
+        }
+        offset = node->count;
+        impl->cursor_node = node;
+        impl->cursor_start = impl->size - node->count;
+    } else {
+        int start = 0;
+        node = locate(impl, index, &start);
+        offset = index - start;
+        if (node->count == UNROLLED_NODE_MAX) {
+            unrolled_node *upper = new_node_after(impl, node);
+            if (!upper) {
+                return OVA_ERROR_MEMORY;
+            }
+            int half = UNROLLED_NODE_MAX / 2;
+            upper->count = UNROLLED_NODE_MAX - half;
+            memcpy(upper->items, &node->items[half], sizeof(void *) * (size_t)upper->count);
+            node->count = half;
+            if (offset > half) {
+                node = upper;
+                offset -= half;
+                impl->cursor_node = upper;
+                impl->cursor_start = start + half;
+            }
+        }
+    }
+
+    memmove(&node->items[offset + 1], &node->items[offset], sizeof(void *) * (size_t)(node->count - offset));
+    node->items[offset] = item;
+    node->count++;
+    impl->size++;
+    return OVA_SUCCESS;
+}
+
+static void *unrolled_list_get(list *self, int index) {
+    unrolled_list_impl *impl = get_impl(self);
+    if (!impl || index < 0 || index >= impl->size) {
+        return NULL;
+    }
+
+    unrolled_node *node = impl->cursor_node;
+    if (node && index >= impl->cursor_start && index < impl->cursor_start + node->count) {
+        return node->items[index - impl->cursor_start];
+    }
+    int start = 0;
+    node = locate(impl, index, &start);
+    return node->items[index - start];
+}
+
+static ova_error_code unrolled_list_remove(list *self, int index) {
+    unrolled_list_impl *impl = get_impl(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (index < 0 || index >= impl->size) {
+        return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    int start = 0;
+    unrolled_node *node = locate(impl, index, &start);
+    int offset = index - start;
+    memmove(&node->items[offset], &node->items[offset + 1], sizeof(void *) * (size_t)(node->count - offset - 1));
+    node->count--;
+    impl->size--;
+
+    if (node->count == 0) {
+        impl->cursor_node = NULL;
+        unlink_node(impl, node);
+    } else if (node->count < UNROLLED_NODE_MIN) {
+        /* Fold the right node of the pair into the left one. */
+        unrolled_node *left = node->next ? node : node->prev;
+        if (left && left->count + left->next->count <= UNROLLED_NODE_MAX / 2) {
+            unrolled_node *right = left->next;
+            memcpy(&left->items[left->count], right->items, sizeof(void *) * (size_t)right->count);
+            left->count += right->count;
+            impl->cursor_node = NULL;
+            unlink_node(impl, right);
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static int unrolled_list_size(const list *self) {
+    const unrolled_list_impl *impl = get_impl(self);
+    return impl ? impl->size : 0;
+}
+
+static void unrolled_list_clear(list *self) {
+    unrolled_list_impl *impl = get_impl(self);
+    if (impl) {
+        unrolled_node *node = impl->head;
+        while (node) {
+            unrolled_node *next = node->next;
+            free(node);
+            node = next;
+        }
+        impl->head = NULL;
+        impl->tail = NULL;
+        impl->size = 0;
+        impl->cursor_node = NULL;
+    }
+}
+
+static void unrolled_list_free(list *self) {
+    unrolled_list_impl *impl = get_impl(self);
+    if (impl) {
+        unrolled_list_clear(self);
+        free(impl);
+    }
+    free(self);
+}
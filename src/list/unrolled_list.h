@@ -0,0 +1,8 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include "../../include/list.h"
+
+list *create_unrolled_list(void);
+
+#endif // UNROLLED_LIST_H
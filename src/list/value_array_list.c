@@ -0,0 +1,223 @@
+#include "value_array_list.h"
+#include "../utils/capacity_utils.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Array list whose elements are fixed-size values stored back to back, so
+ * small PODs need no allocation of their own and a scan reads one buffer
+ * instead of chasing a pointer per element. Item pointers passed in are
+ * copied from; pointers handed out point into the buffer and stay valid
+ * until the next call that grows or shifts it.
+ */
+
+typedef struct {
+    unsigned char *data;
+    size_t element_size;
+    int size;
+    int capacity;
+} value_array_list_impl;
+
+static ova_error_code value_array_list_insert(list *self, void *item, int index);
+static ova_error_code value_array_list_insert_bulk(list *self, void **elements, int count);
+static ova_error_code value_array_list_insert_range(list *self, int index, void **elements, int count);
+static void *value_array_list_get(list *self, int index);
+static ova_error_code value_array_list_remove(list *self, int index);
+static ova_error_code value_array_list_remove_range(list *self, int from, int to);
+static int value_array_list_size(const list *self);
+static void value_array_list_clear(list *self);
+static ova_error_code value_array_list_reserve(list *self, int capacity);
+static void value_array_list_free(list *self);
+
+list *create_value_array_list(size_t element_size, int initial_capacity) {
+    if (element_size == 0) {
+        return NULL;
+    }
+    int capacity = initial_capacity > 0 ? initial_capacity : 4;
+    if ((size_t)capacity > SIZE_MAX / element_size) {
+        return NULL;
+    }
+
+    list *lst = malloc(sizeof(list));
+    value_array_list_impl *impl = malloc(sizeof(value_array_list_impl));
+    unsigned char *data = malloc((size_t)capacity * element_size);
+    if (!lst || !impl || !data) {
+        free(lst);
+        free(impl);
+        free(data);
+        return NULL;
+    }
+
+    impl->data = data;
+    impl->element_size = element_size;
+    impl->size = 0;
+    impl->capacity = capacity;
+
+    lst->impl = impl;
+    lst->insert = value_array_list_insert;
+    lst->insert_bulk = value_array_list_insert_bulk;
+    lst->insert_range = value_array_list_insert_range;
+    lst->get = value_array_list_get;
+    lst->remove = value_array_list_remove;
+    lst->remove_range = value_array_list_remove_range;
+    lst->size = value_array_list_size;
+    lst->clear = value_array_list_clear;
+    lst->reserve = value_array_list_reserve;
+    lst->data_span = NULL; // Elements are values, not pointers
+    lst->free = value_array_list_free;
+    lst->user_data = NULL;
+
+    return lst;
+}
+
+static value_array_list_impl *get_impl(const list *self) {
+    return self ? (value_array_list_impl *)self->impl : NULL;
+}
+
+static unsigned char *slot(const value_array_list_impl *impl, int index) {
+    return impl->data + (size_t)index * impl->element_size;
+}
+
+static int resize_data(value_array_list_impl *impl, int new_capacity) {
+    if ((size_t)new_capacity > SIZE_MAX / impl->element_size) {
+        return 0;
+    }
+    unsigned char *data = realloc(impl->data, (size_t)new_capacity * impl->element_size);
+    if (!data) {
+        return 0;
+    }
+    impl->data = data;
+    impl->capacity = new_capacity;
+    return 1;
+}
+
+/* One growth step: double, or jump straight to @p needed. */
+static int ensure_capacity_for(value_array_list_impl *impl, int needed) {
+    if (needed <= impl->capacity) {
+        return 1;
+    }
+    int new_capacity = safe_double_capacity(impl->capacity);
+    return resize_data(impl, new_capacity > needed ? new_capacity : needed);
+}
+
+/*
+ * Where the value behind @p item lives after a range insert at @p index.
+ * Items pointing into the list itself (say, insert(get(i))) are rebased
+ * onto the possibly moved buffer, past the gap when they sat after it.
+ */
+static const void *insert_source(const value_array_list_impl *impl, const void *item, uintptr_t old_base,
+                                 size_t old_bytes, int index, int count) {
+    uintptr_t offset = (uintptr_t)item - old_base;
+    if (offset >= old_bytes) {
+        return item;
+    }
+    if (offset >= (uintptr_t)index * impl->element_size) {
+        offset += (uintptr_t)count * impl->element_size;
+    }
+    return impl->data + offset;
+}
+
+static ova_error_code value_array_list_insert(list *self, void *item, int index) {
+    void *items[1] = {item};
+    if (!item) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    return value_array_list_insert_range(self, index, items, 1);
+}
+
+static ova_error_code value_array_list_insert_bulk(list *self, void **elements, int count) {
+    if (!self || !self->impl || !elements || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    return value_array_list_insert_range(self, value_array_list_size(self), elements, count);
+}
+
+static ova_error_code value_array_list_insert_range(list *self, int index, void **elements, int count) {
+    value_array_list_impl *impl = get_impl(self);
+    if (!impl || count < 0 || (count > 0 && !elements)) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (index < 0 || index > impl->size) {
+        return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!elements[i]) {
+            return OVA_ERROR_INVALID_ARG;
+        }
+    }
+    if (count > INT_MAX - impl->size) {
+        return OVA_ERROR_MEMORY;
+    }
+    uintptr_t old_base = (uintptr_t)impl->data;
+    size_t old_bytes = (size_t)impl->size * impl->element_size;
+    if (!ensure_capacity_for(impl, impl->size + count)) {
+        return OVA_ERROR_MEMORY;
+    }
+
+    memmove(slot(impl, index + count), slot(impl, index), (size_t)(impl->size - index) * impl->element_size);
+    for (int i = 0; i < count; i++) {
+        const void *source = insert_source(impl, elements[i], old_base, old_bytes, index, count);
+        memcpy(slot(impl, index + i), source, impl->element_size);
+    }
+    impl->size += count;
+    return OVA_SUCCESS;
+}
+
+static void *value_array_list_get(list *self, int index) {
+    value_array_list_impl *impl = get_impl(self);
+    if (!impl || index < 0 || index >= impl->size) {
+        return NULL;
+    }
+    return slot(impl, index);
+}
+
+static ova_error_code value_array_list_remove(list *self, int index) {
+    return value_array_list_remove_range(self, index, index + 1);
+}
+
+static ova_error_code value_array_list_remove_range(list *self, int from, int to) {
+    value_array_list_impl *impl = get_impl(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (from < 0 || from > to || to > impl->size) {
+        return OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    memmove(slot(impl, from), slot(impl, to), (size_t)(impl->size - to) * impl->element_size);
+    impl->size -= to - from;
+    return OVA_SUCCESS;
+}
+
+static int value_array_list_size(const list *self) {
+    const value_array_list_impl *impl = get_impl(self);
+    return impl ? impl->size : 0;
+}
+
+static void value_array_list_clear(list *self) {
+    value_array_list_impl *impl = get_impl(self);
+    if (impl) {
+        impl->size = 0;
+    }
+}
+
+static ova_error_code value_array_list_reserve(list *self, int capacity) {
+    value_array_list_impl *impl = get_impl(self);
+    if (!impl || capacity < 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (capacity <= impl->capacity) {
+        return OVA_SUCCESS;
+    }
+    return resize_data(impl, capacity) ? OVA_SUCCESS : OVA_ERROR_MEMORY;
+}
+
+static void value_array_list_free(list *self) {
+    value_array_list_impl *impl = get_impl(self);
+    if (impl) {
+        free(impl->data);
+        free(impl);
+    }
+    free(self);
+}
@@ -0,0 +1,14 @@
+#ifndef VALUE_ARRAY_LIST_H
+#define VALUE_ARRAY_LIST_H
+
+#include "../../include/list.h"
+
+/**
+ * @brief Create an array list that stores @p element_size-byte values inline.
+ *
+ * insert() copies the value behind its item pointer into the list, and get()
+ * returns a pointer into the list's contiguous storage.
+ */
+list *create_value_array_list(size_t element_size, int initial_capacity);
+
+#endif // VALUE_ARRAY_LIST_H
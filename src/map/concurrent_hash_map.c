@@ -0,0 +1,500 @@
+#include "concurrent_hash_map.h"
+#include "hash_map.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The key space is split into independent chained tables ("segments"), each
+ * behind its own reader/writer lock and picked by the top bits of the key
+ * hash. Readers of a segment run in parallel, writers only exclude the one
+ * segment they touch, and each segment resizes incrementally, a few buckets
+ * per write, so no single operation pays for a whole-table rehash.
+ */
+#define CONCURRENT_MAP_SEGMENT_BITS 6
+#define CONCURRENT_MAP_SEGMENTS (1 << CONCURRENT_MAP_SEGMENT_BITS)
+#define CONCURRENT_MAP_CACHE_LINE 64
+
+typedef struct {
+    _Alignas(CONCURRENT_MAP_CACHE_LINE) pthread_rwlock_t lock;
+    map_impl *table;
+} concurrent_segment;
+
+typedef struct {
+    map_type type;
+    concurrent_segment *segments;
+    map_hasher hasher;
+    comparator key_compare;
+} concurrent_map_impl;
+
+static concurrent_map_impl *concurrent_impl_from_map(const map *m) {
+    return m ? (concurrent_map_impl *)m->impl : NULL;
+}
+
+static concurrent_segment *concurrent_segment_for(const concurrent_map_impl *impl, uint64_t hash) {
+    return &impl->segments[hash >> (64 - CONCURRENT_MAP_SEGMENT_BITS)];
+}
+
+static ova_error_code concurrent_put(map *self, void *key, void *data) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    uint64_t hash = map_hasher_apply(&impl->hasher, key);
+    concurrent_segment *seg = concurrent_segment_for(impl, hash);
+    pthread_rwlock_wrlock(&seg->lock);
+    ova_error_code err = hash_map_impl_put(seg->table, key, data, hash);
+    pthread_rwlock_unlock(&seg->lock);
+    return err;
+}
+
+/*
+ * Bulk operations hash each batch before taking any lock, then visit the
+ * keys in order under their segment's lock. A batch spans many segments, so
+ * there is no single lock to hold for the whole call.
+ */
+static void concurrent_hash_batch(const concurrent_map_impl *impl, void **keys, uint64_t *hashes,
+                                  int n) {
+    for (int i = 0; i < n; i++) {
+        hashes[i] = map_hasher_apply(&impl->hasher, keys[i]);
+        map_prefetch(concurrent_segment_for(impl, hashes[i]));
+    }
+}
+
+static ova_error_code concurrent_put_bulk(map *self, void **keys, void **values, int count) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl || !keys || !values || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    uint64_t hashes[MAP_BULK_BATCH];
+    for (int base = 0; base < count; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        concurrent_hash_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n; i++) {
+            concurrent_segment *seg = concurrent_segment_for(impl, hashes[i]);
+            pthread_rwlock_wrlock(&seg->lock);
+            ova_error_code err = hash_map_impl_put(seg->table, keys[base + i], values[base + i], hashes[i]);
+            pthread_rwlock_unlock(&seg->lock);
+            if (err != OVA_SUCCESS) {
+                return err;
+            }
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static ova_error_code concurrent_get_bulk(map *self, void **keys, void **out_values, int count) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl || !keys || !out_values || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    uint64_t hashes[MAP_BULK_BATCH];
+    for (int base = 0; base < count; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        concurrent_hash_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n; i++) {
+            concurrent_segment *seg = concurrent_segment_for(impl, hashes[i]);
+            pthread_rwlock_rdlock(&seg->lock);
+            out_values[base + i] = hash_map_impl_get(seg->table, keys[base + i], hashes[i]);
+            pthread_rwlock_unlock(&seg->lock);
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static ova_error_code concurrent_remove_bulk(map *self, void **keys, void **out_values, int count) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl || !keys || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    uint64_t hashes[MAP_BULK_BATCH];
+    for (int base = 0; base < count; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        concurrent_hash_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n; i++) {
+            concurrent_segment *seg = concurrent_segment_for(impl, hashes[i]);
+            pthread_rwlock_wrlock(&seg->lock);
+            void *data = hash_map_impl_remove(seg->table, keys[base + i], hashes[i]);
+            pthread_rwlock_unlock(&seg->lock);
+            if (out_values) {
+                out_values[base + i] = data;
+            }
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static void *concurrent_get(map *self, void *key) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return NULL;
+    }
+
+    uint64_t hash = map_hasher_apply(&impl->hasher, key);
+    concurrent_segment *seg = concurrent_segment_for(impl, hash);
+    pthread_rwlock_rdlock(&seg->lock);
+    void *result = hash_map_impl_get(seg->table, key, hash);
+    pthread_rwlock_unlock(&seg->lock);
+    return result;
+}
+
+static void *concurrent_remove(map *self, void *key) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return NULL;
+    }
+
+    uint64_t hash = map_hasher_apply(&impl->hasher, key);
+    concurrent_segment *seg = concurrent_segment_for(impl, hash);
+    pthread_rwlock_wrlock(&seg->lock);
+    void *data = hash_map_impl_remove(seg->table, key, hash);
+    pthread_rwlock_unlock(&seg->lock);
+    return data;
+}
+
+static int concurrent_size(const map *self) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return 0;
+    }
+
+    int total = 0;
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_rdlock(&seg->lock);
+        total += seg->table->size;
+        pthread_rwlock_unlock(&seg->lock);
+    }
+    return total;
+}
+
+static int concurrent_capacity(const map *self) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return 0;
+    }
+
+    int total = 0;
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_rdlock(&seg->lock);
+        total += seg->table->capacity;
+        pthread_rwlock_unlock(&seg->lock);
+    }
+    return total;
+}
+
+static ova_error_code concurrent_reserve(map *self, int n) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl || n < 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    /* Keys spread unevenly over segments; 1/8 slack absorbs most of it. */
+    long per_segment = n / CONCURRENT_MAP_SEGMENTS;
+    per_segment += per_segment / 8 + 1;
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_wrlock(&seg->lock);
+        ova_error_code err = hash_map_impl_reserve(seg->table, per_segment);
+        pthread_rwlock_unlock(&seg->lock);
+        if (err != OVA_SUCCESS) {
+            return err;
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static ova_error_code concurrent_shrink_to_fit(map *self) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_wrlock(&seg->lock);
+        ova_error_code err = hash_map_impl_shrink_to_fit(seg->table);
+        pthread_rwlock_unlock(&seg->lock);
+        if (err != OVA_SUCCESS) {
+            return err;
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static ova_error_code concurrent_set_max_load_factor(map *self, double load_factor) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl || !map_load_factor_valid(load_factor)) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_wrlock(&seg->lock);
+        ova_error_code err = hash_map_impl_set_max_load(seg->table, load_factor);
+        pthread_rwlock_unlock(&seg->lock);
+        if (err != OVA_SUCCESS) {
+            return err;
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static double concurrent_max_load_factor(const map *self) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return 0.0;
+    }
+
+    concurrent_segment *seg = &impl->segments[0];
+    pthread_rwlock_rdlock(&seg->lock);
+    double load_factor = seg->table->max_load;
+    pthread_rwlock_unlock(&seg->lock);
+    return load_factor;
+}
+
+static void concurrent_clear(map *self) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return;
+    }
+
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_wrlock(&seg->lock);
+        hash_map_impl_clear(seg->table);
+        pthread_rwlock_unlock(&seg->lock);
+    }
+}
+
+static void concurrent_destroy_impl(concurrent_map_impl *impl, int initialised) {
+    if (!impl) {
+        return;
+    }
+    if (impl->segments) {
+        for (int i = 0; i < initialised; i++) {
+            pthread_rwlock_destroy(&impl->segments[i].lock);
+            hash_map_impl_destroy(impl->segments[i].table);
+        }
+        free(impl->segments);
+    }
+    free(impl);
+}
+
+static void concurrent_free(map *self) {
+    if (!self) {
+        return;
+    }
+
+    concurrent_destroy_impl(concurrent_impl_from_map(self), CONCURRENT_MAP_SEGMENTS);
+    self->impl = NULL;
+    free(self);
+}
+
+static void concurrent_for_each(const map *self, map_visitor visit, void *ctx) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl || !visit) {
+        return;
+    }
+
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_rdlock(&seg->lock);
+        hash_map_impl_visit(seg->table, visit, ctx);
+        pthread_rwlock_unlock(&seg->lock);
+    }
+}
+
+/*
+ * The cursor walks segment by segment, locking only the segment it is in
+ * for the duration of each call. Unlike for_each it holds no lock between
+ * calls, so it must not overlap with writers on other threads.
+ */
+static void concurrent_iter_begin(map *self, map_iterator *it) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!it) {
+        return;
+    }
+    memset(it, 0, sizeof(*it));
+    if (!impl) {
+        return;
+    }
+
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_wrlock(&seg->lock);
+        hash_map_impl_iter_begin(seg->table, it);
+        pthread_rwlock_unlock(&seg->lock);
+    }
+}
+
+static bool concurrent_iter_next(map *self, map_iterator *it) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl || !it) {
+        return false;
+    }
+
+    while (it->segment < CONCURRENT_MAP_SEGMENTS) {
+        concurrent_segment *seg = &impl->segments[it->segment];
+        pthread_rwlock_rdlock(&seg->lock);
+        bool found = hash_map_impl_iter_next(seg->table, it);
+        pthread_rwlock_unlock(&seg->lock);
+        if (found) {
+            return true;
+        }
+        it->segment++;
+        it->index = 0;
+        it->next_entry = NULL;
+    }
+    return false;
+}
+
+static void *concurrent_iter_remove(map *self, map_iterator *it) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl || !it || it->segment >= CONCURRENT_MAP_SEGMENTS) {
+        return NULL;
+    }
+
+    concurrent_segment *seg = &impl->segments[it->segment];
+    pthread_rwlock_wrlock(&seg->lock);
+    void *data = hash_map_impl_iter_remove(seg->table, it);
+    pthread_rwlock_unlock(&seg->lock);
+    return data;
+}
+
+ova_error_code concurrent_hash_map_use_slabs(map *self) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_wrlock(&seg->lock);
+        ova_error_code err = hash_map_impl_use_pool(seg->table, NULL);
+        pthread_rwlock_unlock(&seg->lock);
+        if (err != OVA_SUCCESS) {
+            return err;
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static map *concurrent_clone_shallow(const map *self);
+static map *concurrent_clone_deep(const map *self, element_copier copier);
+
+map *create_concurrent_hash_map(int capacity, map_hasher hasher, comparator key_compare) {
+    map *out = (map *)calloc(1, sizeof(map));
+    if (!out) {
+        return NULL;
+    }
+
+    concurrent_map_impl *impl = (concurrent_map_impl *)calloc(1, sizeof(concurrent_map_impl));
+    if (!impl) {
+        free(out);
+        return NULL;
+    }
+
+    size_t bytes = CONCURRENT_MAP_SEGMENTS * sizeof(concurrent_segment);
+    impl->segments = (concurrent_segment *)aligned_alloc(CONCURRENT_MAP_CACHE_LINE, bytes);
+    if (!impl->segments) {
+        free(impl);
+        free(out);
+        return NULL;
+    }
+    memset(impl->segments, 0, bytes);
+
+    impl->type = HASH_MAP_CONCURRENT;
+    impl->hasher = hasher;
+    impl->key_compare = key_compare;
+
+    int per_segment = capacity / CONCURRENT_MAP_SEGMENTS;
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        seg->table = hash_map_impl_create(per_segment, hasher, key_compare);
+        if (!seg->table) {
+            concurrent_destroy_impl(impl, i);
+            free(out);
+            return NULL;
+        }
+        seg->table->incremental = 1;
+        if (pthread_rwlock_init(&seg->lock, NULL) != 0) {
+            hash_map_impl_destroy(seg->table);
+            concurrent_destroy_impl(impl, i);
+            free(out);
+            return NULL;
+        }
+    }
+
+    out->impl = impl;
+    out->put = concurrent_put;
+    out->put_bulk = concurrent_put_bulk;
+    out->get = concurrent_get;
+    out->remove = concurrent_remove;
+    out->get_bulk = concurrent_get_bulk;
+    out->remove_bulk = concurrent_remove_bulk;
+    out->size = concurrent_size;
+    out->capacity = concurrent_capacity;
+    out->reserve = concurrent_reserve;
+    out->shrink_to_fit = concurrent_shrink_to_fit;
+    out->set_max_load_factor = concurrent_set_max_load_factor;
+    out->max_load_factor = concurrent_max_load_factor;
+    out->for_each = concurrent_for_each;
+    out->iter_begin = concurrent_iter_begin;
+    out->iter_next = concurrent_iter_next;
+    out->iter_remove = concurrent_iter_remove;
+    out->clear = concurrent_clear;
+    out->free = concurrent_free;
+    out->clone_shallow = concurrent_clone_shallow;
+    out->clone_deep = concurrent_clone_deep;
+    return out;
+}
+
+static map *concurrent_clone_with(const map *self, element_copier copier) {
+    concurrent_map_impl *impl = concurrent_impl_from_map(self);
+    if (!impl) {
+        return NULL;
+    }
+
+    map *copy = create_concurrent_hash_map(0, impl->hasher, impl->key_compare);
+    if (!copy) {
+        return NULL;
+    }
+    if (impl->segments[0].table->pool && concurrent_hash_map_use_slabs(copy) != OVA_SUCCESS) {
+        copy->free(copy);
+        return NULL;
+    }
+
+    /* Equal hashes select equal segments, so segments copy one-to-one. */
+    concurrent_map_impl *dst = concurrent_impl_from_map(copy);
+    for (int i = 0; i < CONCURRENT_MAP_SEGMENTS; i++) {
+        concurrent_segment *seg = &impl->segments[i];
+        pthread_rwlock_rdlock(&seg->lock);
+        dst->segments[i].table->max_load = seg->table->max_load;
+        ova_error_code err = hash_map_impl_copy_into(seg->table, dst->segments[i].table, copier);
+        pthread_rwlock_unlock(&seg->lock);
+        if (err != OVA_SUCCESS) {
+            copy->free(copy);
+            return NULL;
+        }
+    }
+
+    copy->user_data = self->user_data;
+    return copy;
+}
+
+static map *concurrent_clone_shallow(const map *self) {
+    return concurrent_clone_with(self, NULL);
+}
+
+static map *concurrent_clone_deep(const map *self, element_copier copier) {
+    if (!copier) {
+        return NULL;
+    }
+    return concurrent_clone_with(self, copier);
+}
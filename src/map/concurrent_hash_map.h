@@ -0,0 +1,11 @@
+#ifndef CONCURRENT_HASH_MAP_H
+#define CONCURRENT_HASH_MAP_H
+
+#include "map_internal.h"
+
+map *create_concurrent_hash_map(int capacity, map_hasher hasher, comparator key_compare);
+
+/* Give every segment a private entry slab; the map must still be empty. */
+ova_error_code concurrent_hash_map_use_slabs(map *self);
+
+#endif // CONCURRENT_HASH_MAP_H
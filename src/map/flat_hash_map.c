@@ -0,0 +1,688 @@
+#include "flat_hash_map.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#define FLAT_GROUP_WIDTH 16
+#else
+#define FLAT_GROUP_WIDTH 8
+#endif
+
+/*
+ * Open-addressing layout in the Swiss-table style: one control byte per slot
+ * holds either FLAT_CTRL_EMPTY or the top 7 bits of the entry hash (H2), and
+ * a whole group of control bytes is matched against H2 at once before any
+ * slot is touched.  Probing is linear from the home slot (H1), which lets
+ * removal shift the rest of the run back instead of leaving tombstones.
+ *
+ * The control array carries FLAT_GROUP_WIDTH - 1 trailing bytes that mirror
+ * the first bytes of the table so a group load never needs to wrap.
+ */
+#define FLAT_CTRL_EMPTY ((uint8_t)0x80)
+#define FLAT_MIN_CAPACITY ((size_t)FLAT_GROUP_WIDTH)
+#define FLAT_MAX_CAPACITY ((size_t)1 << 30)
+
+typedef struct {
+    void *key;
+    void *data;
+    uint64_t hash;
+} flat_slot;
+
+typedef struct {
+    map_type type;
+    uint8_t *ctrl;
+    flat_slot *slots;
+    size_t capacity;
+    size_t size;
+    double max_load;
+    map_hasher hasher;
+    comparator key_compare;
+} flat_map_impl;
+
+typedef uint32_t flat_bitmask;
+
+static flat_map_impl *flat_impl_from_map(const map *m) {
+    return m ? (flat_map_impl *)m->impl : NULL;
+}
+
+#ifdef __SSE2__
+static inline flat_bitmask flat_group_match(const uint8_t *group, uint8_t h2) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)(const void *)group);
+    __m128i needle = _mm_set1_epi8((char)h2);
+    return (flat_bitmask)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, needle));
+}
+
+static inline flat_bitmask flat_group_match_empty(const uint8_t *group) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)(const void *)group);
+    return (flat_bitmask)_mm_movemask_epi8(ctrl);
+}
+#else
+static inline flat_bitmask flat_group_match(const uint8_t *group, uint8_t h2) {
+    flat_bitmask mask = 0;
+    for (unsigned i = 0; i < FLAT_GROUP_WIDTH; i++) {
+        mask |= (flat_bitmask)(group[i] == h2) << i;
+    }
+    return mask;
+}
+
+static inline flat_bitmask flat_group_match_empty(const uint8_t *group) {
+    flat_bitmask mask = 0;
+    for (unsigned i = 0; i < FLAT_GROUP_WIDTH; i++) {
+        mask |= (flat_bitmask)(group[i] == FLAT_CTRL_EMPTY) << i;
+    }
+    return mask;
+}
+#endif
+
+static inline unsigned flat_bitmask_lowest(flat_bitmask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned lane = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        lane++;
+    }
+    return lane;
+#endif
+}
+
+static inline int flat_ctrl_is_full(uint8_t ctrl) {
+    return (ctrl & FLAT_CTRL_EMPTY) == 0;
+}
+
+/* H1 picks the home slot; H2 is the top 7 bits, kept in the control byte. */
+static inline size_t flat_home(uint64_t hash, size_t mask) {
+    return (size_t)(hash >> 7) & mask;
+}
+
+static inline uint8_t flat_h2(uint64_t hash) {
+    return (uint8_t)(hash >> 57);
+}
+
+static int flat_keys_equal(const flat_map_impl *impl, void *lhs, void *rhs) {
+    if (lhs == rhs) return 1;
+    if (lhs == NULL || rhs == NULL) return 0;
+    if (!impl->key_compare) return 0;
+    return impl->key_compare(lhs, rhs) == 0;
+}
+
+static size_t flat_capacity_for(size_t requested) {
+    size_t capacity = FLAT_MIN_CAPACITY;
+    while (capacity < requested && capacity < FLAT_MAX_CAPACITY) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/* Whether one more entry would push @p size past the load factor. */
+static int flat_needs_growth(const flat_map_impl *impl, size_t size, size_t capacity) {
+    return (double)(size + 1) > (double)capacity * impl->max_load;
+}
+
+/* Smallest table that holds @p entries under the load factor. */
+static size_t flat_capacity_for_entries(const flat_map_impl *impl, size_t entries) {
+    size_t capacity = FLAT_MIN_CAPACITY;
+    while (entries > 0 && flat_needs_growth(impl, entries - 1, capacity) &&
+           capacity < FLAT_MAX_CAPACITY) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+static void flat_set_ctrl(flat_map_impl *impl, size_t index, uint8_t value) {
+    impl->ctrl[index] = value;
+    if (index < FLAT_GROUP_WIDTH - 1) {
+        impl->ctrl[impl->capacity + index] = value;
+    }
+}
+
+/**
+ * @brief Locate @p key, or the empty slot that ends its probe run.
+ *
+ * @return Slot index; @p found tells whether it holds @p key.
+ */
+static size_t flat_probe(const flat_map_impl *impl, void *key, uint64_t hash, int *found) {
+    size_t mask = impl->capacity - 1;
+    size_t pos = flat_home(hash, mask);
+    uint8_t h2 = flat_h2(hash);
+
+    for (;;) {
+        const uint8_t *group = impl->ctrl + pos;
+        flat_bitmask empty = flat_group_match_empty(group);
+        flat_bitmask match = flat_group_match(group, h2);
+        if (empty) {
+            match &= ((flat_bitmask)1 << flat_bitmask_lowest(empty)) - 1;
+        }
+
+        while (match) {
+            size_t index = (pos + flat_bitmask_lowest(match)) & mask;
+            const flat_slot *slot = &impl->slots[index];
+            if (slot->hash == hash && flat_keys_equal(impl, slot->key, key)) {
+                *found = 1;
+                return index;
+            }
+            match &= match - 1;
+        }
+
+        if (empty) {
+            *found = 0;
+            return (pos + flat_bitmask_lowest(empty)) & mask;
+        }
+        pos = (pos + FLAT_GROUP_WIDTH) & mask;
+    }
+}
+
+static size_t flat_find_empty(const uint8_t *ctrl, size_t capacity, uint64_t hash) {
+    size_t mask = capacity - 1;
+    size_t pos = flat_home(hash, mask);
+    for (;;) {
+        flat_bitmask empty = flat_group_match_empty(ctrl + pos);
+        if (empty) {
+            return (pos + flat_bitmask_lowest(empty)) & mask;
+        }
+        pos = (pos + FLAT_GROUP_WIDTH) & mask;
+    }
+}
+
+static int flat_alloc_tables(size_t capacity, uint8_t **ctrl_out, flat_slot **slots_out) {
+    uint8_t *ctrl = (uint8_t *)malloc(capacity + FLAT_GROUP_WIDTH - 1);
+    flat_slot *slots = (flat_slot *)malloc(capacity * sizeof(flat_slot));
+    if (!ctrl || !slots) {
+        free(ctrl);
+        free(slots);
+        return 0;
+    }
+    memset(ctrl, FLAT_CTRL_EMPTY, capacity + FLAT_GROUP_WIDTH - 1);
+    *ctrl_out = ctrl;
+    *slots_out = slots;
+    return 1;
+}
+
+/**
+ * @brief Move every entry into a table of @p new_capacity slots.
+ *
+ * Entries are placed by their stored hash, so no key is hashed or compared.
+ */
+static int flat_resize(flat_map_impl *impl, size_t new_capacity) {
+    uint8_t *new_ctrl = NULL;
+    flat_slot *new_slots = NULL;
+    if (!flat_alloc_tables(new_capacity, &new_ctrl, &new_slots)) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < impl->capacity; i++) {
+        if (!flat_ctrl_is_full(impl->ctrl[i])) {
+            continue;
+        }
+        const flat_slot *slot = &impl->slots[i];
+        size_t index = flat_find_empty(new_ctrl, new_capacity, slot->hash);
+        new_ctrl[index] = flat_h2(slot->hash);
+        if (index < FLAT_GROUP_WIDTH - 1) {
+            new_ctrl[new_capacity + index] = new_ctrl[index];
+        }
+        new_slots[index] = *slot;
+    }
+
+    free(impl->ctrl);
+    free(impl->slots);
+    impl->ctrl = new_ctrl;
+    impl->slots = new_slots;
+    impl->capacity = new_capacity;
+    return 1;
+}
+
+static int flat_grow_for(flat_map_impl *impl, size_t needed) {
+    size_t capacity = flat_capacity_for_entries(impl, needed);
+    if (capacity <= impl->capacity) {
+        return 0;
+    }
+    return flat_resize(impl, capacity);
+}
+
+/**
+ * @brief Remove the entry at @p index without leaving a tombstone.
+ *
+ * Later members of the same probe run are shifted back into the hole as
+ * long as that does not move them in front of their home slot.
+ */
+static void flat_erase_at(flat_map_impl *impl, size_t index) {
+    size_t mask = impl->capacity - 1;
+    size_t hole = index;
+    size_t next = (index + 1) & mask;
+
+    while (impl->ctrl[next] != FLAT_CTRL_EMPTY) {
+        size_t home = flat_home(impl->slots[next].hash, mask);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            impl->slots[hole] = impl->slots[next];
+            flat_set_ctrl(impl, hole, impl->ctrl[next]);
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    flat_set_ctrl(impl, hole, FLAT_CTRL_EMPTY);
+    impl->size--;
+}
+
+static ova_error_code flat_put_hashed(flat_map_impl *impl, void *key, void *data, uint64_t hash) {
+    int found = 0;
+    size_t index = flat_probe(impl, key, hash, &found);
+    if (found) {
+        impl->slots[index].data = data;
+        return OVA_SUCCESS;
+    }
+
+    if (flat_needs_growth(impl, impl->size, impl->capacity)) {
+        if (flat_grow_for(impl, impl->size + 1)) {
+            index = flat_find_empty(impl->ctrl, impl->capacity, hash);
+        } else if (impl->size + 1 >= impl->capacity) {
+            return OVA_ERROR_MEMORY;
+        }
+    }
+
+    flat_slot *slot = &impl->slots[index];
+    slot->key = key;
+    slot->data = data;
+    slot->hash = hash;
+    flat_set_ctrl(impl, index, flat_h2(hash));
+    impl->size++;
+    return OVA_SUCCESS;
+}
+
+static void *flat_remove_hashed(flat_map_impl *impl, void *key, uint64_t hash) {
+    int found = 0;
+    size_t index = flat_probe(impl, key, hash, &found);
+    if (!found) {
+        return NULL;
+    }
+
+    void *data = impl->slots[index].data;
+    flat_erase_at(impl, index);
+    return data;
+}
+
+/**
+ * @brief Hash a batch of keys and prefetch the control group and first slot
+ *        of each probe sequence.
+ */
+static void flat_prepare_batch(const flat_map_impl *impl, void **keys, uint64_t *hashes, int n) {
+    size_t mask = impl->capacity - 1;
+    for (int i = 0; i < n; i++) {
+        hashes[i] = map_hasher_apply(&impl->hasher, keys[i]);
+        size_t home = flat_home(hashes[i], mask);
+        map_prefetch(&impl->ctrl[home]);
+        map_prefetch(&impl->slots[home]);
+    }
+}
+
+static ova_error_code flat_put(map *self, void *key, void *data) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    return flat_put_hashed(impl, key, data, map_hasher_apply(&impl->hasher, key));
+}
+
+static ova_error_code flat_put_bulk(map *self, void **keys, void **values, int count) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || !keys || !values || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    if (flat_needs_growth(impl, impl->size + (size_t)count - 1, impl->capacity)) {
+        flat_grow_for(impl, impl->size + (size_t)count);
+    }
+
+    uint64_t hashes[MAP_BULK_BATCH];
+    for (int base = 0; base < count; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        flat_prepare_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n; i++) {
+            ova_error_code err = flat_put_hashed(impl, keys[base + i], values[base + i], hashes[i]);
+            if (err != OVA_SUCCESS) {
+                return err;
+            }
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static void *flat_get(map *self, void *key) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl) {
+        return NULL;
+    }
+
+    int found = 0;
+    size_t index = flat_probe(impl, key, map_hasher_apply(&impl->hasher, key), &found);
+    return found ? impl->slots[index].data : NULL;
+}
+
+static void *flat_remove(map *self, void *key) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl) {
+        return NULL;
+    }
+    return flat_remove_hashed(impl, key, map_hasher_apply(&impl->hasher, key));
+}
+
+static ova_error_code flat_get_bulk(map *self, void **keys, void **out_values, int count) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || !keys || !out_values || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    uint64_t hashes[MAP_BULK_BATCH];
+    for (int base = 0; base < count; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        flat_prepare_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n; i++) {
+            int found = 0;
+            size_t index = flat_probe(impl, keys[base + i], hashes[i], &found);
+            out_values[base + i] = found ? impl->slots[index].data : NULL;
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static ova_error_code flat_remove_bulk(map *self, void **keys, void **out_values, int count) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || !keys || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    uint64_t hashes[MAP_BULK_BATCH];
+    for (int base = 0; base < count; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        flat_prepare_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n; i++) {
+            void *data = flat_remove_hashed(impl, keys[base + i], hashes[i]);
+            if (out_values) {
+                out_values[base + i] = data;
+            }
+        }
+    }
+    return OVA_SUCCESS;
+}
+
+static int flat_size(const map *self) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    return impl ? (int)impl->size : 0;
+}
+
+static int flat_capacity(const map *self) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    return impl ? (int)impl->capacity : 0;
+}
+
+static ova_error_code flat_reserve(map *self, int n) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || n < 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    size_t target = flat_capacity_for_entries(impl, (size_t)n);
+    if (n > 0 && flat_needs_growth(impl, (size_t)n - 1, target)) {
+        return OVA_ERROR_FULL; // Capped at FLAT_MAX_CAPACITY
+    }
+    if (target <= impl->capacity) {
+        return OVA_SUCCESS;
+    }
+    return flat_resize(impl, target) ? OVA_SUCCESS : OVA_ERROR_MEMORY;
+}
+
+static ova_error_code flat_shrink_to_fit(map *self) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    size_t target = flat_capacity_for_entries(impl, impl->size);
+    if (target >= impl->capacity) {
+        return OVA_SUCCESS;
+    }
+    return flat_resize(impl, target) ? OVA_SUCCESS : OVA_ERROR_MEMORY;
+}
+
+static ova_error_code flat_set_max_load_factor(map *self, double load_factor) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || !map_load_factor_valid(load_factor)) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    impl->max_load = load_factor;
+    size_t target = flat_capacity_for_entries(impl, impl->size);
+    if (target <= impl->capacity) {
+        return OVA_SUCCESS;
+    }
+    return flat_resize(impl, target) ? OVA_SUCCESS : OVA_ERROR_MEMORY;
+}
+
+static double flat_max_load_factor(const map *self) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    return impl ? impl->max_load : 0.0;
+}
+
+static void flat_clear(map *self) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl) {
+        return;
+    }
+    memset(impl->ctrl, FLAT_CTRL_EMPTY, impl->capacity + FLAT_GROUP_WIDTH - 1);
+    impl->size = 0;
+}
+
+static void flat_free(map *self) {
+    if (!self) {
+        return;
+    }
+
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (impl) {
+        free(impl->ctrl);
+        free(impl->slots);
+        free(impl);
+        self->impl = NULL;
+    }
+    free(self);
+}
+
+static void flat_for_each(const map *self, map_visitor visit, void *ctx) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || !visit) {
+        return;
+    }
+
+    for (size_t i = 0; i < impl->capacity; i++) {
+        if (flat_ctrl_is_full(impl->ctrl[i])) {
+            visit(impl->slots[i].key, impl->slots[i].data, ctx);
+        }
+    }
+}
+
+/*
+ * The cursor walks the table once, cyclically, from an empty slot (start).
+ * Backward-shift removal only pulls entries toward the hole from later in
+ * the same run, and no run crosses an empty slot, so entries the cursor has
+ * passed never move in front of it. After a removal the cursor re-examines
+ * the hole, which may now hold a not yet visited entry.
+ */
+static void flat_iter_begin(map *self, map_iterator *it) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!it) {
+        return;
+    }
+    memset(it, 0, sizeof(*it));
+    if (!impl) {
+        return;
+    }
+
+    size_t start = 0;
+    while (start < impl->capacity && flat_ctrl_is_full(impl->ctrl[start])) {
+        start++;
+    }
+    it->start = start;
+}
+
+static bool flat_iter_next(map *self, map_iterator *it) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || !it) {
+        return false;
+    }
+
+    size_t mask = impl->capacity - 1;
+    while (it->index < impl->capacity) {
+        size_t slot = (it->start + it->index++) & mask;
+        if (flat_ctrl_is_full(impl->ctrl[slot])) {
+            it->entry = &impl->slots[slot];
+            it->key = impl->slots[slot].key;
+            it->value = impl->slots[slot].data;
+            return true;
+        }
+    }
+    it->entry = NULL;
+    return false;
+}
+
+static void *flat_iter_remove(map *self, map_iterator *it) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || !it || !it->entry) {
+        return NULL;
+    }
+
+    size_t slot = (it->start + it->index - 1) & (impl->capacity - 1);
+    void *data = impl->slots[slot].data;
+    flat_erase_at(impl, slot);
+    it->index--;
+    it->entry = NULL;
+    return data;
+}
+
+static map *flat_clone_shallow(const map *self);
+static map *flat_clone_deep(const map *self, element_copier copier);
+
+static map *flat_create_with_slots(size_t capacity, map_hasher hasher, comparator key_compare) {
+    map *out = (map *)calloc(1, sizeof(map));
+    if (!out) {
+        return NULL;
+    }
+
+    flat_map_impl *impl = (flat_map_impl *)calloc(1, sizeof(flat_map_impl));
+    if (!impl) {
+        free(out);
+        return NULL;
+    }
+
+    if (!flat_alloc_tables(capacity, &impl->ctrl, &impl->slots)) {
+        free(impl);
+        free(out);
+        return NULL;
+    }
+
+    impl->type = HASH_MAP_FLAT;
+    impl->capacity = capacity;
+    impl->size = 0;
+    impl->max_load = LOAD_FACTOR;
+    impl->hasher = hasher;
+    impl->key_compare = key_compare;
+
+    out->impl = impl;
+    out->put = flat_put;
+    out->put_bulk = flat_put_bulk;
+    out->get = flat_get;
+    out->remove = flat_remove;
+    out->get_bulk = flat_get_bulk;
+    out->remove_bulk = flat_remove_bulk;
+    out->size = flat_size;
+    out->capacity = flat_capacity;
+    out->reserve = flat_reserve;
+    out->shrink_to_fit = flat_shrink_to_fit;
+    out->set_max_load_factor = flat_set_max_load_factor;
+    out->max_load_factor = flat_max_load_factor;
+    out->for_each = flat_for_each;
+    out->iter_begin = flat_iter_begin;
+    out->iter_next = flat_iter_next;
+    out->iter_remove = flat_iter_remove;
+    out->clear = flat_clear;
+    out->free = flat_free;
+    out->clone_shallow = flat_clone_shallow;
+    out->clone_deep = flat_clone_deep;
+    return out;
+}
+
+map *create_flat_hash_map(int capacity, map_hasher hasher, comparator key_compare) {
+    if (capacity < INITIAL_CAPACITY) {
+        capacity = INITIAL_CAPACITY;
+    }
+    return flat_create_with_slots(flat_capacity_for((size_t)capacity), hasher, key_compare);
+}
+
+static map *flat_clone_shallow(const map *self) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl) {
+        return NULL;
+    }
+
+    map *copy = flat_create_with_slots(impl->capacity, impl->hasher, impl->key_compare);
+    if (!copy) {
+        return NULL;
+    }
+
+    flat_map_impl *dst = flat_impl_from_map(copy);
+    dst->max_load = impl->max_load;
+    memcpy(dst->ctrl, impl->ctrl, impl->capacity + FLAT_GROUP_WIDTH - 1);
+    for (size_t i = 0; i < impl->capacity; i++) {
+        if (flat_ctrl_is_full(impl->ctrl[i])) {
+            dst->slots[i] = impl->slots[i];
+        }
+    }
+    dst->size = impl->size;
+
+    copy->user_data = self->user_data;
+    return copy;
+}
+
+static map *flat_clone_deep(const map *self, element_copier copier) {
+    flat_map_impl *impl = flat_impl_from_map(self);
+    if (!impl || !copier) {
+        return NULL;
+    }
+
+    map *copy = flat_create_with_slots(impl->capacity, impl->hasher, impl->key_compare);
+    if (!copy) {
+        return NULL;
+    }
+
+    /* Copies compare equal to their originals, so they keep the same slot. */
+    flat_map_impl *dst = flat_impl_from_map(copy);
+    dst->max_load = impl->max_load;
+    for (size_t i = 0; i < impl->capacity; i++) {
+        if (!flat_ctrl_is_full(impl->ctrl[i])) {
+            continue;
+        }
+        void *key_dup = copier(impl->slots[i].key);
+        if (!key_dup) {
+            copy->free(copy);
+            return NULL;
+        }
+        void *val_dup = copier(impl->slots[i].data);
+        if (!val_dup) {
+            free(key_dup);
+            copy->free(copy);
+            return NULL;
+        }
+        dst->slots[i].key = key_dup;
+        dst->slots[i].data = val_dup;
+        dst->slots[i].hash = impl->slots[i].hash;
+        flat_set_ctrl(dst, i, impl->ctrl[i]);
+        dst->size++;
+    }
+
+    copy->user_data = self->user_data;
+    return copy;
+}
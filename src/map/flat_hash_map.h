@@ -0,0 +1,8 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "map_internal.h"
+
+map *create_flat_hash_map(int capacity, map_hasher hasher, comparator key_compare);
+
+#endif // FLAT_HASH_MAP_H
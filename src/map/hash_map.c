@@ -5,46 +5,71 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* Minimum old buckets moved into the new table per mutating call during a resize. */
+#define HASH_MAP_MIGRATE_STEP 8
+
+/* Bounds on entries per chunk of a private slab; sized from the capacity. */
+#define HASH_MAP_SLAB_MIN_BLOCKS 64
+#define HASH_MAP_SLAB_MAX_BLOCKS 4096
+
 static bool safe_key_equals(void *k1, void *k2, comparator cmp) {
     if (k1 == NULL && k2 == NULL) return true;
     if (k1 == NULL || k2 == NULL) return false;
     return cmp(k1, k2) == 0;
 }
 
-static int map_keys_equal(map_impl *impl, void *lhs, void *rhs) {
+static int map_keys_equal(const map_impl *impl, void *lhs, void *rhs) {
     if (!impl || !impl->key_compare) {
         return (lhs == rhs) ? 1 : 0;
     }
     return safe_key_equals(lhs, rhs, impl->key_compare) ? 1 : 0;
 }
 
-static int map_bucket_index(map_impl *impl, void *key) {
+static int map_bucket_index(const map_impl *impl, uint64_t hash) {
     if (!impl || impl->capacity <= 0) {
         return 0;
     }
-    if (key == NULL) {
-        return 0;
+    return (int)map_reduce(hash, (uint32_t)impl->capacity);
+}
+
+/* Compare cached hashes first so the comparator only runs on likely hits. */
+static int map_entry_matches(const map_impl *impl, const map_entry *node, void *key, uint64_t hash) {
+    return node->hash == hash && map_keys_equal(impl, node->key, key);
+}
+
+static void hash_lock(map_impl *impl) {
+    if (impl->lock) {
+        pthread_mutex_lock(impl->lock);
     }
-    return impl->hash_func(key, impl->capacity);
 }
 
-static void resize_and_rehash(map_impl *impl) {
-    int old_capacity = impl->capacity;
-    int new_capacity = safe_double_capacity(old_capacity);
-    if (new_capacity == old_capacity) {
-        return;
+static void hash_unlock(map_impl *impl) {
+    if (impl->lock) {
+        pthread_mutex_unlock(impl->lock);
+    }
+}
+
+/**
+ * @brief Move every node into a fresh array of @p new_capacity buckets.
+ *
+ * Nodes carry their full hash, so redistribution never calls the hash
+ * function.
+ */
+static ova_error_code rehash_to(map_impl *impl, int new_capacity) {
+    if (new_capacity == impl->capacity) {
+        return OVA_SUCCESS;
     }
 
     map_entry **new_buckets = calloc((size_t)new_capacity, sizeof(map_entry *));
     if (!new_buckets) {
-        return;
+        return OVA_ERROR_MEMORY;
     }
 
-    for (int i = 0; i < old_capacity; i++) {
+    for (int i = 0; i < impl->capacity; i++) {
         map_entry *node = impl->buckets[i];
         while (node) {
             map_entry *next_node = node->next;
-            int new_index = node->key ? impl->hash_func(node->key, new_capacity) : 0;
+            int new_index = (int)map_reduce(node->hash, (uint32_t)new_capacity);
             node->next = new_buckets[new_index];
             new_buckets[new_index] = node;
             node = next_node;
@@ -54,134 +79,604 @@ static void resize_and_rehash(map_impl *impl) {
     free(impl->buckets);
     impl->buckets = new_buckets;
     impl->capacity = new_capacity;
+    return OVA_SUCCESS;
 }
 
-static ova_error_code hash_insert(map *self, void *key, void *data) {
-    map_impl *impl = map_impl_from_map(self);
-    if (!impl) {
+static void resize_and_rehash(map_impl *impl) {
+    rehash_to(impl, safe_double_capacity(impl->capacity));
+}
+
+static int hash_over_load(const map_impl *impl, long size, int capacity) {
+    return (double)size > (double)capacity * impl->max_load;
+}
+
+/* Smallest bucket count that holds @p entries under the load factor. */
+static int hash_capacity_for(const map_impl *impl, long entries) {
+    double wanted = (double)entries / impl->max_load;
+    if (wanted >= (double)INT_MAX) {
+        return INT_MAX;
+    }
+    int capacity = (int)wanted;
+    if (hash_over_load(impl, entries, capacity)) {
+        capacity++;
+    }
+    return capacity < INITIAL_CAPACITY ? INITIAL_CAPACITY : capacity;
+}
+
+/**
+ * @brief Move one bucket of the retiring table into the live table.
+ */
+static void migrate_bucket(map_impl *impl, int old_index) {
+    map_entry *node = impl->old_buckets[old_index];
+    while (node) {
+        map_entry *next_node = node->next;
+        int index = map_bucket_index(impl, node->hash);
+        node->next = impl->buckets[index];
+        impl->buckets[index] = node;
+        node = next_node;
+    }
+    impl->old_buckets[old_index] = NULL;
+}
+
+/**
+ * @brief Migrate up to @p budget buckets; release the old table when done.
+ */
+static void migrate_step(map_impl *impl, int budget) {
+    if (!impl->old_buckets) {
+        return;
+    }
+
+    while (budget-- > 0 && impl->migrate_pos < impl->old_capacity) {
+        migrate_bucket(impl, impl->migrate_pos++);
+    }
+
+    if (impl->migrate_pos >= impl->old_capacity) {
+        free(impl->old_buckets);
+        impl->old_buckets = NULL;
+        impl->old_capacity = 0;
+        impl->migrate_pos = 0;
+    }
+}
+
+static void migrate_all(map_impl *impl) {
+    if (impl->old_buckets) {
+        migrate_step(impl, impl->old_capacity);
+    }
+}
+
+/**
+ * @brief Start an incremental resize.
+ *
+ * Only the new bucket array is allocated here; existing nodes stay in the
+ * old array and move a few buckets at a time on later mutating calls. The
+ * per-call budget spreads the old array over the inserts left before the
+ * next growth, so low load factors still finish before the next resize.
+ */
+static void begin_incremental_resize(map_impl *impl) {
+    migrate_all(impl);
+
+    int new_capacity = safe_double_capacity(impl->capacity);
+    if (new_capacity == impl->capacity) {
+        return;
+    }
+
+    map_entry **new_buckets = calloc((size_t)new_capacity, sizeof(map_entry *));
+    if (!new_buckets) {
+        return;
+    }
+
+    long headroom = (long)((double)new_capacity * impl->max_load) - impl->size;
+    long budget = headroom > 0 ? ((long)impl->capacity + headroom - 1) / headroom : impl->capacity;
+
+    impl->old_buckets = impl->buckets;
+    impl->old_capacity = impl->capacity;
+    impl->migrate_pos = 0;
+    impl->migrate_budget = budget > HASH_MAP_MIGRATE_STEP ? (int)budget : HASH_MAP_MIGRATE_STEP;
+    impl->buckets = new_buckets;
+    impl->capacity = new_capacity;
+}
+
+/**
+ * @brief Grow once so @p needed entries fit under the load factor.
+ *
+ * Bulk inserts call this to take one rehash up front instead of a doubling
+ * every time the threshold is crossed.
+ */
+ova_error_code hash_map_impl_reserve(map_impl *impl, long needed) {
+    int target = hash_capacity_for(impl, needed);
+    if (target <= impl->capacity) {
+        return OVA_SUCCESS;
+    }
+    migrate_all(impl);
+    return rehash_to(impl, target);
+}
+
+/**
+ * @brief Move every entry into a fresh private slab and free the old one.
+ *
+ * Removed entries only return to the slab's free list, so after a large
+ * removal the slab's chunks stay allocated. The fresh slab's first chunk
+ * holds all live entries, so the copy cannot fail halfway. Nothing is
+ * copied unless the old slab has more free blocks than the fresh one would.
+ */
+static ova_error_code compact_private_slab(map_impl *impl) {
+    int blocks = impl->size > HASH_MAP_SLAB_MIN_BLOCKS ? impl->size : HASH_MAP_SLAB_MIN_BLOCKS;
+    if (memory_pool_free_count(impl->pool) <= (size_t)(blocks - impl->size)) {
+        return OVA_SUCCESS;
+    }
+
+    memory_pool *fresh = create_memory_pool(sizeof(map_entry), blocks);
+    if (!fresh) {
+        return OVA_ERROR_MEMORY;
+    }
+
+    for (int i = 0; i < impl->capacity; i++) {
+        for (map_entry **link = &impl->buckets[i]; *link; link = &(*link)->next) {
+            map_entry *moved = (map_entry *)memory_pool_alloc(fresh);
+            *moved = **link;
+            *link = moved;
+        }
+    }
+    memory_pool_destroy(impl->pool);
+    impl->pool = fresh;
+    return OVA_SUCCESS;
+}
+
+ova_error_code hash_map_impl_shrink_to_fit(map_impl *impl) {
+    migrate_all(impl);
+    int target = hash_capacity_for(impl, impl->size);
+    if (target < impl->capacity) {
+        ova_error_code err = rehash_to(impl, target);
+        if (err != OVA_SUCCESS) {
+            return err;
+        }
+    }
+    return impl->owns_pool ? compact_private_slab(impl) : OVA_SUCCESS;
+}
+
+ova_error_code hash_map_impl_set_max_load(map_impl *impl, double load_factor) {
+    if (!map_load_factor_valid(load_factor)) {
         return OVA_ERROR_INVALID_ARG;
     }
+    impl->max_load = load_factor;
+    return hash_map_impl_reserve(impl, impl->size);
+}
 
-    if (impl->lock) {
-        pthread_mutex_lock(impl->lock);
+/**
+ * @brief Hash a batch of keys and prefetch their bucket heads.
+ *
+ * The bucket slots are prefetched first, then the first node of each chain,
+ * so the misses for the whole batch are in flight together.
+ */
+static void hash_prepare_batch(const map_impl *impl, void **keys, uint64_t *hashes, int n) {
+    for (int i = 0; i < n; i++) {
+        hashes[i] = map_hasher_apply(&impl->hasher, keys[i]);
+        map_prefetch(&impl->buckets[map_bucket_index(impl, hashes[i])]);
+    }
+    for (int i = 0; i < n; i++) {
+        map_prefetch(impl->buckets[map_bucket_index(impl, hashes[i])]);
     }
+}
 
-    if (impl->size > impl->capacity - impl->capacity / 4) {
-        resize_and_rehash(impl);
+/**
+ * @brief Return the link that points at the node holding @p key, or NULL.
+ *
+ * While a resize is in flight the retiring table is consulted for buckets
+ * that have not migrated yet.
+ */
+static map_entry **hash_find_link(const map_impl *impl, void *key, uint64_t hash) {
+    map_entry **link = &impl->buckets[map_bucket_index(impl, hash)];
+    for (; *link; link = &(*link)->next) {
+        if (map_entry_matches(impl, *link, key, hash)) {
+            return link;
+        }
     }
 
-    int index = map_bucket_index(impl, key);
-    map_entry *node = impl->buckets[index];
-    while (node) {
-        if (map_keys_equal(impl, node->key, key)) {
-            node->data = data;
-            if (impl->lock) {
-                pthread_mutex_unlock(impl->lock);
+    if (impl->old_buckets) {
+        int old_index = (int)map_reduce(hash, (uint32_t)impl->old_capacity);
+        if (old_index >= impl->migrate_pos) {
+            for (link = &impl->old_buckets[old_index]; *link; link = &(*link)->next) {
+                if (map_entry_matches(impl, *link, key, hash)) {
+                    return link;
+                }
             }
-            return OVA_SUCCESS;
         }
-        node = node->next;
     }
+    return NULL;
+}
 
-    map_entry *new_node = (map_entry *)malloc(sizeof(map_entry));
-    if (!new_node) {
-        if (impl->lock) {
-            pthread_mutex_unlock(impl->lock);
-        }
+static map_entry *entry_alloc(map_impl *impl) {
+    if (impl->pool) {
+        return (map_entry *)memory_pool_alloc(impl->pool);
+    }
+    return (map_entry *)malloc(sizeof(map_entry));
+}
+
+static void entry_release(map_impl *impl, map_entry *node) {
+    if (impl->pool) {
+        memory_pool_free(impl->pool, node);
+    } else {
+        free(node);
+    }
+}
+
+/**
+ * @brief Link a new node at the head of its bucket without a duplicate check.
+ */
+static ova_error_code hash_link_node(map_impl *impl, void *key, void *data, uint64_t hash) {
+    map_entry *node = entry_alloc(impl);
+    if (!node) {
         return OVA_ERROR_MEMORY;
     }
-    new_node->key = key;
-    new_node->data = data;
-    new_node->next = impl->buckets[index];
-    impl->buckets[index] = new_node;
+    int index = map_bucket_index(impl, hash);
+    node->key = key;
+    node->data = data;
+    node->hash = hash;
+    node->next = impl->buckets[index];
+    impl->buckets[index] = node;
     impl->size++;
+    return OVA_SUCCESS;
+}
 
-    if (impl->lock) {
-        pthread_mutex_unlock(impl->lock);
+ova_error_code hash_map_impl_put(map_impl *impl, void *key, void *data, uint64_t hash) {
+    migrate_step(impl, impl->migrate_budget);
+
+    map_entry **link = hash_find_link(impl, key, hash);
+    if (link) {
+        (*link)->data = data;
+        return OVA_SUCCESS;
+    }
+
+    if (hash_over_load(impl, impl->size, impl->capacity)) {
+        if (impl->incremental) {
+            begin_incremental_resize(impl);
+        } else {
+            resize_and_rehash(impl);
+        }
+    }
+    return hash_link_node(impl, key, data, hash);
+}
+
+void *hash_map_impl_get(const map_impl *impl, void *key, uint64_t hash) {
+    map_entry **link = hash_find_link(impl, key, hash);
+    return link ? (*link)->data : NULL;
+}
+
+void *hash_map_impl_remove(map_impl *impl, void *key, uint64_t hash) {
+    migrate_step(impl, impl->migrate_budget);
+
+    map_entry **link = hash_find_link(impl, key, hash);
+    if (!link) {
+        return NULL;
+    }
+
+    map_entry *current = *link;
+    void *data = current->data;
+    *link = current->next;
+    entry_release(impl, current);
+    impl->size--;
+    return data;
+}
+
+/*
+ * Release every node of @p buckets. A private slab is reset by the caller in
+ * one step, so its chains only need their heads cleared.
+ */
+static void free_chains(map_impl *impl, map_entry **buckets, int capacity) {
+    if (impl->owns_pool) {
+        memset(buckets, 0, (size_t)capacity * sizeof(map_entry *));
+        return;
+    }
+
+    for (int i = 0; i < capacity; i++) {
+        map_entry *node = buckets[i];
+        while (node) {
+            map_entry *tmp = node;
+            node = node->next;
+            entry_release(impl, tmp);
+        }
+        buckets[i] = NULL;
+    }
+}
+
+void hash_map_impl_clear(map_impl *impl) {
+    free_chains(impl, impl->buckets, impl->capacity);
+    if (impl->owns_pool) {
+        memory_pool_reset(impl->pool);
+    }
+    if (impl->old_buckets) {
+        free_chains(impl, impl->old_buckets, impl->old_capacity);
+        free(impl->old_buckets);
+        impl->old_buckets = NULL;
+        impl->old_capacity = 0;
+        impl->migrate_pos = 0;
+    }
+    impl->size = 0;
+}
+
+void hash_map_impl_visit(const map_impl *impl, map_visitor visit, void *ctx) {
+    for (int i = 0; i < impl->capacity; i++) {
+        for (map_entry *node = impl->buckets[i]; node; node = node->next) {
+            visit(node->key, node->data, ctx);
+        }
+    }
+    if (impl->old_buckets) {
+        for (int i = impl->migrate_pos; i < impl->old_capacity; i++) {
+            for (map_entry *node = impl->old_buckets[i]; node; node = node->next) {
+                visit(node->key, node->data, ctx);
+            }
+        }
+    }
+}
+
+/*
+ * Cursor state: entry is the node last returned, next_entry the node that
+ * follows it in its chain, and index the next bucket to scan once the chain
+ * runs out. Saving next_entry up front is what lets the current node be
+ * unlinked without disturbing the walk.
+ */
+void hash_map_impl_iter_begin(map_impl *impl, map_iterator *it) {
+    migrate_all(impl);
+    it->key = NULL;
+    it->value = NULL;
+    it->entry = NULL;
+    it->next_entry = NULL;
+    it->index = 0;
+}
+
+bool hash_map_impl_iter_next(const map_impl *impl, map_iterator *it) {
+    map_entry *node = (map_entry *)it->next_entry;
+    while (!node && it->index < (size_t)impl->capacity) {
+        node = impl->buckets[it->index++];
+    }
+
+    it->entry = node;
+    if (!node) {
+        return false;
+    }
+    it->next_entry = node->next;
+    it->key = node->key;
+    it->value = node->data;
+    return true;
+}
+
+void *hash_map_impl_iter_remove(map_impl *impl, map_iterator *it) {
+    map_entry *node = (map_entry *)it->entry;
+    if (!node) {
+        return NULL;
+    }
+
+    map_entry **link = &impl->buckets[map_bucket_index(impl, node->hash)];
+    while (*link && *link != node) {
+        link = &(*link)->next;
+    }
+    if (!*link) {
+        return NULL;
+    }
+
+    void *data = node->data;
+    *link = node->next;
+    entry_release(impl, node);
+    impl->size--;
+    it->entry = NULL;
+    return data;
+}
+
+static ova_error_code copy_chains(map_entry **buckets, int from, int capacity,
+                                  map_impl *dst, element_copier copier) {
+    for (int i = from; i < capacity; i++) {
+        for (map_entry *node = buckets[i]; node; node = node->next) {
+            void *key = node->key;
+            void *data = node->data;
+            if (copier) {
+                key = copier(node->key);
+                if (!key) {
+                    return OVA_ERROR_MEMORY;
+                }
+                data = copier(node->data);
+                if (!data) {
+                    free(key);
+                    return OVA_ERROR_MEMORY;
+                }
+            }
+            if (hash_link_node(dst, key, data, node->hash) != OVA_SUCCESS) {
+                if (copier) {
+                    free(key);
+                    free(data);
+                }
+                return OVA_ERROR_MEMORY;
+            }
+        }
     }
     return OVA_SUCCESS;
 }
 
-static ova_error_code hash_put_bulk(map *self, void **keys, void **values, int count) {
-    if (!self || !keys || !values || count <= 0) {
+/**
+ * @brief Copy every entry of @p src into the empty table @p dst.
+ *
+ * With a @p copier each key and value is duplicated; otherwise pointers are
+ * shared. Cached hashes are reused either way.
+ */
+ova_error_code hash_map_impl_copy_into(const map_impl *src, map_impl *dst, element_copier copier) {
+    ova_error_code err = copy_chains(src->buckets, 0, src->capacity, dst, copier);
+    if (err == OVA_SUCCESS && src->old_buckets) {
+        err = copy_chains(src->old_buckets, src->migrate_pos, src->old_capacity, dst, copier);
+    }
+    return err;
+}
+
+ova_error_code hash_map_impl_use_pool(map_impl *impl, memory_pool *pool) {
+    if (!impl || impl->size != 0 || impl->pool) {
         return OVA_ERROR_INVALID_ARG;
     }
 
-    for (int i = 0; i < count; i++) {
-        ova_error_code err = self->put(self, keys[i], values[i]);
-        if (err != OVA_SUCCESS) {
-            return err;
+    if (pool) {
+        if (memory_pool_block_size(pool) < sizeof(map_entry)) {
+            return OVA_ERROR_INVALID_ARG;
         }
+        impl->pool = pool;
+        impl->owns_pool = 0;
+        return OVA_SUCCESS;
     }
+
+    int blocks = impl->capacity;
+    if (blocks < HASH_MAP_SLAB_MIN_BLOCKS) {
+        blocks = HASH_MAP_SLAB_MIN_BLOCKS;
+    } else if (blocks > HASH_MAP_SLAB_MAX_BLOCKS) {
+        blocks = HASH_MAP_SLAB_MAX_BLOCKS;
+    }
+    impl->pool = create_memory_pool(sizeof(map_entry), blocks);
+    if (!impl->pool) {
+        return OVA_ERROR_MEMORY;
+    }
+    impl->owns_pool = 1;
     return OVA_SUCCESS;
 }
 
-static void *hash_get(map *self, void *key) {
-    map_impl *impl = map_impl_from_map(self);
+map_impl *hash_map_impl_create(int capacity, map_hasher hasher, comparator key_compare) {
+    if (capacity < INITIAL_CAPACITY) {
+        capacity = INITIAL_CAPACITY;
+    }
+
+    map_impl *impl = (map_impl *)calloc(1, sizeof(map_impl));
     if (!impl) {
         return NULL;
     }
 
-    if (impl->lock) {
-        pthread_mutex_lock(impl->lock);
+    impl->buckets = (map_entry **)calloc((size_t)capacity, sizeof(map_entry *));
+    if (!impl->buckets) {
+        free(impl);
+        return NULL;
     }
 
-    int index = map_bucket_index(impl, key);
-    map_entry *node = impl->buckets[index];
-    while (node) {
-        if (map_keys_equal(impl, node->key, key)) {
-            void *result = node->data;
-            if (impl->lock) {
-                pthread_mutex_unlock(impl->lock);
-            }
-            return result;
-        }
-        node = node->next;
+    impl->type = HASH_MAP;
+    impl->capacity = capacity;
+    impl->size = 0;
+    impl->max_load = LOAD_FACTOR;
+    impl->hasher = hasher;
+    impl->key_compare = key_compare;
+    impl->lock = NULL;
+    return impl;
+}
+
+void hash_map_impl_destroy(map_impl *impl) {
+    if (!impl) {
+        return;
     }
 
+    if (impl->owns_pool) {
+        memory_pool_destroy(impl->pool);
+        free(impl->old_buckets);
+    } else {
+        hash_map_impl_clear(impl);
+    }
+    free(impl->buckets);
     if (impl->lock) {
-        pthread_mutex_unlock(impl->lock);
+        pthread_mutex_destroy(impl->lock);
+        free(impl->lock);
     }
-    return NULL;
+    free(impl);
 }
 
-static void *hash_remove(map *self, void *key) {
+static ova_error_code hash_insert(map *self, void *key, void *data) {
     map_impl *impl = map_impl_from_map(self);
     if (!impl) {
-        return NULL;
+        return OVA_ERROR_INVALID_ARG;
     }
 
-    if (impl->lock) {
-        pthread_mutex_lock(impl->lock);
+    uint64_t hash = map_hasher_apply(&impl->hasher, key);
+    hash_lock(impl);
+    ova_error_code err = hash_map_impl_put(impl, key, data, hash);
+    hash_unlock(impl);
+    return err;
+}
+
+static ova_error_code hash_put_bulk(map *self, void **keys, void **values, int count) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl || !keys || !values || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
     }
 
-    int index = map_bucket_index(impl, key);
-    map_entry *prev = NULL;
-    map_entry *current = impl->buckets[index];
-    while (current) {
-        if (map_keys_equal(impl, current->key, key)) {
-            void *data = current->data;
-            if (!prev) {
-                impl->buckets[index] = current->next;
-            } else {
-                prev->next = current->next;
-            }
-            free(current);
-            impl->size--;
+    uint64_t hashes[MAP_BULK_BATCH];
+    ova_error_code err = OVA_SUCCESS;
+    hash_lock(impl);
+    hash_map_impl_reserve(impl, (long)impl->size + count);
+    for (int base = 0; base < count && err == OVA_SUCCESS; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        hash_prepare_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n && err == OVA_SUCCESS; i++) {
+            err = hash_map_impl_put(impl, keys[base + i], values[base + i], hashes[i]);
+        }
+    }
+    hash_unlock(impl);
+    return err;
+}
+
+static ova_error_code hash_get_bulk(map *self, void **keys, void **out_values, int count) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl || !keys || !out_values || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    uint64_t hashes[MAP_BULK_BATCH];
+    hash_lock(impl);
+    for (int base = 0; base < count; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        hash_prepare_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n; i++) {
+            out_values[base + i] = hash_map_impl_get(impl, keys[base + i], hashes[i]);
+        }
+    }
+    hash_unlock(impl);
+    return OVA_SUCCESS;
+}
 
-            if (impl->lock) {
-                pthread_mutex_unlock(impl->lock);
+static ova_error_code hash_remove_bulk(map *self, void **keys, void **out_values, int count) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl || !keys || count <= 0) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    uint64_t hashes[MAP_BULK_BATCH];
+    hash_lock(impl);
+    for (int base = 0; base < count; base += MAP_BULK_BATCH) {
+        int n = count - base < MAP_BULK_BATCH ? count - base : MAP_BULK_BATCH;
+        hash_prepare_batch(impl, keys + base, hashes, n);
+        for (int i = 0; i < n; i++) {
+            void *data = hash_map_impl_remove(impl, keys[base + i], hashes[i]);
+            if (out_values) {
+                out_values[base + i] = data;
             }
-            return data;
         }
-        prev = current;
-        current = current->next;
     }
+    hash_unlock(impl);
+    return OVA_SUCCESS;
+}
 
-    if (impl->lock) {
-        pthread_mutex_unlock(impl->lock);
+static void *hash_get(map *self, void *key) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl) {
+        return NULL;
     }
-    return NULL;
+
+    uint64_t hash = map_hasher_apply(&impl->hasher, key);
+    hash_lock(impl);
+    void *result = hash_map_impl_get(impl, key, hash);
+    hash_unlock(impl);
+    return result;
+}
+
+static void *hash_remove(map *self, void *key) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl) {
+        return NULL;
+    }
+
+    uint64_t hash = map_hasher_apply(&impl->hasher, key);
+    hash_lock(impl);
+    void *data = hash_map_impl_remove(impl, key, hash);
+    hash_unlock(impl);
+    return data;
 }
 
 static int hash_size(const map *self) {
@@ -194,34 +689,56 @@ static int hash_capacity(const map *self) {
     return impl ? impl->capacity : 0;
 }
 
-static void hash_clear(map *self) {
-    if (!self) {
-        return;
+static ova_error_code hash_reserve(map *self, int n) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl || n < 0) {
+        return OVA_ERROR_INVALID_ARG;
     }
 
+    hash_lock(impl);
+    ova_error_code err = hash_map_impl_reserve(impl, n);
+    hash_unlock(impl);
+    return err;
+}
+
+static ova_error_code hash_shrink_to_fit(map *self) {
     map_impl *impl = map_impl_from_map(self);
     if (!impl) {
-        return;
+        return OVA_ERROR_INVALID_ARG;
     }
 
-    if (impl->lock) {
-        pthread_mutex_lock(impl->lock);
-    }
+    hash_lock(impl);
+    ova_error_code err = hash_map_impl_shrink_to_fit(impl);
+    hash_unlock(impl);
+    return err;
+}
 
-    for (int i = 0; i < impl->capacity; i++) {
-        map_entry *node = impl->buckets[i];
-        while (node) {
-            map_entry *tmp = node;
-            node = node->next;
-            free(tmp);
-        }
-        impl->buckets[i] = NULL;
+static ova_error_code hash_set_max_load_factor(map *self, double load_factor) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl) {
+        return OVA_ERROR_INVALID_ARG;
     }
-    impl->size = 0;
 
-    if (impl->lock) {
-        pthread_mutex_unlock(impl->lock);
+    hash_lock(impl);
+    ova_error_code err = hash_map_impl_set_max_load(impl, load_factor);
+    hash_unlock(impl);
+    return err;
+}
+
+static double hash_max_load_factor(const map *self) {
+    map_impl *impl = map_impl_from_map(self);
+    return impl ? impl->max_load : 0.0;
+}
+
+static void hash_clear(map *self) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl) {
+        return;
     }
+
+    hash_lock(impl);
+    hash_map_impl_clear(impl);
+    hash_unlock(impl);
 }
 
 static void hash_free(map *self) {
@@ -229,79 +746,91 @@ static void hash_free(map *self) {
         return;
     }
 
+    hash_map_impl_destroy(map_impl_from_map(self));
+    self->impl = NULL;
+    free(self);
+}
+
+static void hash_for_each(const map *self, map_visitor visit, void *ctx) {
     map_impl *impl = map_impl_from_map(self);
-    if (impl) {
-        if (impl->lock) {
-            pthread_mutex_lock(impl->lock);
-        }
+    if (!impl || !visit) {
+        return;
+    }
 
-        for (int i = 0; i < impl->capacity; i++) {
-            map_entry *node = impl->buckets[i];
-            while (node) {
-                map_entry *tmp = node;
-                node = node->next;
-                free(tmp);
-            }
-        }
-        free(impl->buckets);
+    hash_lock(impl);
+    hash_map_impl_visit(impl, visit, ctx);
+    hash_unlock(impl);
+}
 
-        if (impl->lock) {
-            pthread_mutex_unlock(impl->lock);
-            pthread_mutex_destroy(impl->lock);
-            free(impl->lock);
-        }
+static void hash_iter_begin(map *self, map_iterator *it) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!it) {
+        return;
+    }
+    memset(it, 0, sizeof(*it));
+    if (!impl) {
+        return;
+    }
 
-        free(impl);
-        self->impl = NULL;
+    hash_lock(impl);
+    hash_map_impl_iter_begin(impl, it);
+    hash_unlock(impl);
+}
+
+static bool hash_iter_next(map *self, map_iterator *it) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl || !it) {
+        return false;
     }
 
-    free(self);
+    hash_lock(impl);
+    bool found = hash_map_impl_iter_next(impl, it);
+    hash_unlock(impl);
+    return found;
+}
+
+static void *hash_iter_remove(map *self, map_iterator *it) {
+    map_impl *impl = map_impl_from_map(self);
+    if (!impl || !it) {
+        return NULL;
+    }
+
+    hash_lock(impl);
+    void *data = hash_map_impl_iter_remove(impl, it);
+    hash_unlock(impl);
+    return data;
 }
 
 static map *hash_clone_shallow(const map *self);
 static map *hash_clone_deep(const map *self, element_copier copier);
 
-map *create_hash_map(int capacity, int (*hash_func)(void *, int), comparator key_compare, int thread_safe) {
-    if (capacity < INITIAL_CAPACITY) {
-        capacity = INITIAL_CAPACITY;
-    }
-
+map *create_hash_map(int capacity, map_hasher hasher, comparator key_compare, int thread_safe,
+                     int incremental) {
     map *out = (map *)calloc(1, sizeof(map));
     if (!out) {
         return NULL;
     }
 
-    map_impl *impl = (map_impl *)calloc(1, sizeof(map_impl));
+    map_impl *impl = hash_map_impl_create(capacity, hasher, key_compare);
     if (!impl) {
         free(out);
         return NULL;
     }
 
-    impl->buckets = (map_entry **)calloc((size_t)capacity, sizeof(map_entry *));
-    if (!impl->buckets) {
-        free(impl);
-        free(out);
-        return NULL;
-    }
-
-    impl->capacity = capacity;
-    impl->size = 0;
-    impl->hash_func = hash_func ? hash_func : bernstein_hash;
-    impl->key_compare = key_compare;
-    impl->lock = NULL;
+    impl->type = thread_safe ? HASH_TABLE : (incremental ? HASH_MAP_INCREMENTAL : HASH_MAP);
+    impl->incremental = incremental;
 
     if (thread_safe) {
         impl->lock = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
         if (!impl->lock) {
-            free(impl->buckets);
-            free(impl);
+            hash_map_impl_destroy(impl);
             free(out);
             return NULL;
         }
         if (pthread_mutex_init(impl->lock, NULL) != 0) {
             free(impl->lock);
-            free(impl->buckets);
-            free(impl);
+            impl->lock = NULL;
+            hash_map_impl_destroy(impl);
             free(out);
             return NULL;
         }
@@ -312,8 +841,18 @@ map *create_hash_map(int capacity, int (*hash_func)(void *, int), comparator key
     out->put_bulk = hash_put_bulk;
     out->get = hash_get;
     out->remove = hash_remove;
+    out->get_bulk = hash_get_bulk;
+    out->remove_bulk = hash_remove_bulk;
     out->size = hash_size;
     out->capacity = hash_capacity;
+    out->reserve = hash_reserve;
+    out->shrink_to_fit = hash_shrink_to_fit;
+    out->set_max_load_factor = hash_set_max_load_factor;
+    out->max_load_factor = hash_max_load_factor;
+    out->for_each = hash_for_each;
+    out->iter_begin = hash_iter_begin;
+    out->iter_next = hash_iter_next;
+    out->iter_remove = hash_iter_remove;
     out->clear = hash_clear;
     out->free = hash_free;
     out->clone_shallow = hash_clone_shallow;
@@ -322,80 +861,44 @@ map *create_hash_map(int capacity, int (*hash_func)(void *, int), comparator key
     return out;
 }
 
-static map *hash_clone_shallow(const map *self) {
-    if (!self) {
-        return NULL;
-    }
-
+static map *hash_clone_with(const map *self, element_copier copier) {
     map_impl *impl = map_impl_from_map(self);
     if (!impl) {
         return NULL;
     }
 
     int thread_safe = impl->lock ? 1 : 0;
-    map *copy = create_hash_map(impl->capacity, impl->hash_func,
-                                impl->key_compare, thread_safe);
+    map *copy = create_hash_map(impl->capacity, impl->hasher,
+                                impl->key_compare, thread_safe, impl->incremental);
     if (!copy) {
         return NULL;
     }
+    map_impl_from_map(copy)->max_load = impl->max_load;
+    if (impl->pool &&
+        hash_map_impl_use_pool(map_impl_from_map(copy), impl->owns_pool ? NULL : impl->pool) != OVA_SUCCESS) {
+        copy->free(copy);
+        return NULL;
+    }
 
-    for (int i = 0; i < impl->capacity; i++) {
-        map_entry *node = impl->buckets[i];
-        while (node) {
-            if (copy->put(copy, node->key, node->data) != OVA_SUCCESS) {
-                copy->free(copy);
-                return NULL;
-            }
-            node = node->next;
-        }
+    hash_lock(impl);
+    ova_error_code err = hash_map_impl_copy_into(impl, map_impl_from_map(copy), copier);
+    hash_unlock(impl);
+    if (err != OVA_SUCCESS) {
+        copy->free(copy);
+        return NULL;
     }
 
     copy->user_data = self->user_data;
     return copy;
 }
 
+static map *hash_clone_shallow(const map *self) {
+    return hash_clone_with(self, NULL);
+}
 
 static map *hash_clone_deep(const map *self, element_copier copier) {
-    if (!self || !copier) {
-        return NULL;
-    }
-
-    map_impl *impl = map_impl_from_map(self);
-    if (!impl) {
+    if (!copier) {
         return NULL;
     }
-
-    int thread_safe = impl->lock ? 1 : 0;
-    map *copy = create_hash_map(impl->capacity, impl->hash_func,
-                                impl->key_compare, thread_safe);
-    if (!copy) {
-        return NULL;
-    }
-
-    for (int i = 0; i < impl->capacity; i++) {
-        map_entry *node = impl->buckets[i];
-        while (node) {
-            void *key_dup = copier(node->key);
-            if (!key_dup) {
-                copy->free(copy);
-                return NULL;
-            }
-            void *val_dup = copier(node->data);
-            if (!val_dup) {
-                free(key_dup);
-                copy->free(copy);
-                return NULL;
-            }
-            if (copy->put(copy, key_dup, val_dup) != OVA_SUCCESS) {
-                free(key_dup);
-                free(val_dup);
-                copy->free(copy);
-                return NULL;
-            }
-            node = node->next;
-        }
-    }
-
-    copy->user_data = self->user_data;
-    return copy;
+    return hash_clone_with(self, copier);
 }
@@ -3,6 +3,33 @@
 
 #include "map_internal.h"
 
-map *create_hash_map(int capacity, int (*hash_func)(void *, int), comparator key_compare, int thread_safe);
+map *create_hash_map(int capacity, map_hasher hasher, comparator key_compare, int thread_safe,
+                     int incremental);
+
+/*
+ * Unlocked chained-table primitives. Callers hash the key once and provide
+ * their own synchronisation; the concurrent backend builds its segments on
+ * these.
+ */
+map_impl *hash_map_impl_create(int capacity, map_hasher hasher, comparator key_compare);
+void hash_map_impl_destroy(map_impl *impl);
+ova_error_code hash_map_impl_put(map_impl *impl, void *key, void *data, uint64_t hash);
+void *hash_map_impl_get(const map_impl *impl, void *key, uint64_t hash);
+void *hash_map_impl_remove(map_impl *impl, void *key, uint64_t hash);
+void hash_map_impl_clear(map_impl *impl);
+ova_error_code hash_map_impl_reserve(map_impl *impl, long needed);
+ova_error_code hash_map_impl_shrink_to_fit(map_impl *impl);
+ova_error_code hash_map_impl_set_max_load(map_impl *impl, double load_factor);
+void hash_map_impl_visit(const map_impl *impl, map_visitor visit, void *ctx);
+void hash_map_impl_iter_begin(map_impl *impl, map_iterator *it);
+bool hash_map_impl_iter_next(const map_impl *impl, map_iterator *it);
+void *hash_map_impl_iter_remove(map_impl *impl, map_iterator *it);
+ova_error_code hash_map_impl_copy_into(const map_impl *src, map_impl *dst, element_copier copier);
+
+/*
+ * Allocate entries of the empty table @p impl from @p pool, or from a private
+ * slab when @p pool is NULL.
+ */
+ova_error_code hash_map_impl_use_pool(map_impl *impl, memory_pool *pool);
 
 #endif // HASH_MAP_H
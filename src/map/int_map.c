@@ -0,0 +1,255 @@
+#include "../../include/int_map.h"
+#include "map_internal.h"
+#include "../utils/open_addressing.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static inline size_t int_map_home(uint64_t key, size_t mask) {
+    return (size_t)map_mix64(key) & mask;
+}
+
+/*
+ * Generates one integer-keyed map: the NAME struct plus every function
+ * declared for it in int_map.h. Key 0 marks an empty slot, so an entry with
+ * key 0 is kept beside the table in has_zero/zero_value.
+ */
+#define INT_MAP_DEFINE(NAME, VALUE_T)                                            \
+typedef struct NAME##_slot {                                                     \
+    uint64_t key;                                                                \
+    VALUE_T value;                                                               \
+} NAME##_slot;                                                                   \
+                                                                                 \
+struct NAME {                                                                    \
+    NAME##_slot *slots;                                                          \
+    size_t mask;                                                                 \
+    int size;                                                                    \
+    bool has_zero;                                                               \
+    VALUE_T zero_value;                                                          \
+};                                                                               \
+                                                                                 \
+static bool NAME##_slot_occupied(const void *table, size_t index) {              \
+    return ((const NAME *)table)->slots[index].key != 0;                         \
+}                                                                                \
+                                                                                 \
+static size_t NAME##_slot_home(const void *table, size_t index) {                \
+    const NAME *m = (const NAME *)table;                                         \
+    return int_map_home(m->slots[index].key, m->mask);                           \
+}                                                                                \
+                                                                                 \
+static void NAME##_slot_move(void *table, size_t to, size_t from) {              \
+    NAME *m = (NAME *)table;                                                     \
+    m->slots[to] = m->slots[from];                                               \
+}                                                                                \
+                                                                                 \
+static const open_addressing_ops NAME##_slot_ops = {                             \
+    NAME##_slot_occupied, NAME##_slot_home, NAME##_slot_move,                    \
+};                                                                               \
+                                                                                 \
+NAME *create_##NAME(int capacity) {                                              \
+    NAME *m = calloc(1, sizeof(NAME));                                           \
+    if (!m) {                                                                    \
+        return NULL;                                                             \
+    }                                                                            \
+    size_t slots = open_addressing_slots_for(capacity > 0 ? (size_t)capacity : 0);       \
+    m->slots = calloc(slots, sizeof(NAME##_slot));                               \
+    if (!m->slots) {                                                             \
+        free(m);                                                                 \
+        return NULL;                                                             \
+    }                                                                            \
+    m->mask = slots - 1;                                                         \
+    return m;                                                                    \
+}                                                                                \
+                                                                                 \
+void NAME##_free(NAME *m) {                                                      \
+    if (!m) {                                                                    \
+        return;                                                                  \
+    }                                                                            \
+    free(m->slots);                                                              \
+    free(m);                                                                     \
+}                                                                                \
+                                                                                 \
+/* Slot holding @p key, or the empty slot that ends its probe run. */            \
+static inline size_t NAME##_probe(const NAME *m, uint64_t key) {                 \
+    size_t i = int_map_home(key, m->mask);                                       \
+    while (m->slots[i].key != 0 && m->slots[i].key != key) {                     \
+        i = (i + 1) & m->mask;                                                   \
+    }                                                                            \
+    return i;                                                                    \
+}                                                                                \
+                                                                                 \
+static ova_error_code NAME##_rehash(NAME *m, size_t slots) {                     \
+    NAME##_slot *fresh = calloc(slots, sizeof(NAME##_slot));                     \
+    if (!fresh) {                                                                \
+        return OVA_ERROR_MEMORY;                                                 \
+    }                                                                            \
+    size_t mask = slots - 1;                                                     \
+    for (size_t i = 0; i <= m->mask; i++) {                                      \
+        if (m->slots[i].key == 0) {                                              \
+            continue;                                                            \
+        }                                                                        \
+        size_t j = int_map_home(m->slots[i].key, mask);                          \
+        while (fresh[j].key != 0) {                                              \
+            j = (j + 1) & mask;                                                  \
+        }                                                                        \
+        fresh[j] = m->slots[i];                                                  \
+    }                                                                            \
+    free(m->slots);                                                              \
+    m->slots = fresh;                                                            \
+    m->mask = mask;                                                              \
+    return OVA_SUCCESS;                                                          \
+}                                                                                \
+                                                                                 \
+ova_error_code NAME##_put(NAME *m, uint64_t key, VALUE_T value) {                \
+    if (!m) {                                                                    \
+        return OVA_ERROR_INVALID_ARG;                                            \
+    }                                                                            \
+    if (key == 0) {                                                              \
+        if (!m->has_zero) {                                                      \
+            m->has_zero = true;                                                  \
+            m->size++;                                                           \
+        }                                                                        \
+        m->zero_value = value;                                                   \
+        return OVA_SUCCESS;                                                      \
+    }                                                                            \
+                                                                                 \
+    size_t i = NAME##_probe(m, key);                                             \
+    if (m->slots[i].key == key) {                                                \
+        m->slots[i].value = value;                                               \
+        return OVA_SUCCESS;                                                      \
+    }                                                                            \
+                                                                                 \
+    size_t stored = (size_t)m->size - (m->has_zero ? 1u : 0u) + 1u;              \
+    size_t slots = m->mask + 1;                                                  \
+    if (open_addressing_over_load(stored, slots)) {                                      \
+        if (slots < OPEN_ADDRESSING_MAX_SLOTS) {                                         \
+            ova_error_code err = NAME##_rehash(m, slots << 1);                   \
+            if (err != OVA_SUCCESS) {                                            \
+                return err;                                                      \
+            }                                                                    \
+            i = NAME##_probe(m, key);                                            \
+        } else if (stored >= slots) {                                            \
+            return OVA_ERROR_FULL;                                               \
+        }                                                                        \
+    }                                                                            \
+                                                                                 \
+    m->slots[i].key = key;                                                       \
+    m->slots[i].value = value;                                                   \
+    m->size++;                                                                   \
+    return OVA_SUCCESS;                                                          \
+}                                                                                \
+                                                                                 \
+bool NAME##_get(const NAME *m, uint64_t key, VALUE_T *out) {                     \
+    if (!m) {                                                                    \
+        return false;                                                            \
+    }                                                                            \
+    if (key == 0) {                                                              \
+        if (m->has_zero && out) {                                                \
+            *out = m->zero_value;                                                \
+        }                                                                        \
+        return m->has_zero;                                                      \
+    }                                                                            \
+    const NAME##_slot *slot = &m->slots[NAME##_probe(m, key)];                   \
+    if (slot->key != key) {                                                      \
+        return false;                                                            \
+    }                                                                            \
+    if (out) {                                                                   \
+        *out = slot->value;                                                      \
+    }                                                                            \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+bool NAME##_contains(const NAME *m, uint64_t key) {                              \
+    return NAME##_get(m, key, NULL);                                             \
+}                                                                                \
+                                                                                 \
+bool NAME##_remove(NAME *m, uint64_t key, VALUE_T *out) {                        \
+    if (!m) {                                                                    \
+        return false;                                                            \
+    }                                                                            \
+    if (key == 0) {                                                              \
+        if (!m->has_zero) {                                                      \
+            return false;                                                        \
+        }                                                                        \
+        if (out) {                                                               \
+            *out = m->zero_value;                                                \
+        }                                                                        \
+        m->has_zero = false;                                                     \
+        m->size--;                                                               \
+        return true;                                                             \
+    }                                                                            \
+                                                                                 \
+    size_t hole = NAME##_probe(m, key);                                          \
+    if (m->slots[hole].key != key) {                                             \
+        return false;                                                            \
+    }                                                                            \
+    if (out) {                                                                   \
+        *out = m->slots[hole].value;                                             \
+    }                                                                            \
+                                                                                 \
+    hole = open_addressing_erase(m, m->mask, hole, &NAME##_slot_ops);            \
+    m->slots[hole].key = 0;                                                      \
+    m->size--;                                                                   \
+    return true;                                                                 \
+}                                                                                \
+                                                                                 \
+int NAME##_size(const NAME *m) {                                                 \
+    return m ? m->size : 0;                                                      \
+}                                                                                \
+                                                                                 \
+int NAME##_capacity(const NAME *m) {                                             \
+    return m ? (int)(m->mask + 1) : 0;                                           \
+}                                                                                \
+                                                                                 \
+ova_error_code NAME##_reserve(NAME *m, int n) {                                  \
+    if (!m || n < 0) {                                                           \
+        return OVA_ERROR_INVALID_ARG;                                            \
+    }                                                                            \
+    size_t slots = open_addressing_slots_for((size_t)n);                                 \
+    return slots > m->mask + 1 ? NAME##_rehash(m, slots) : OVA_SUCCESS;          \
+}                                                                                \
+                                                                                 \
+void NAME##_clear(NAME *m) {                                                     \
+    if (!m) {                                                                    \
+        return;                                                                  \
+    }                                                                            \
+    memset(m->slots, 0, (m->mask + 1) * sizeof(NAME##_slot));                    \
+    m->has_zero = false;                                                         \
+    m->size = 0;                                                                 \
+}                                                                                \
+                                                                                 \
+bool NAME##_next(const NAME *m, size_t *cursor, uint64_t *key, VALUE_T *value) { \
+    if (!m || !cursor) {                                                         \
+        return false;                                                            \
+    }                                                                            \
+    /* Cursor 0 stands for the out-of-table zero key; slot i is cursor i + 1. */ \
+    if (*cursor == 0) {                                                          \
+        *cursor = 1;                                                             \
+        if (m->has_zero) {                                                       \
+            if (key) {                                                           \
+                *key = 0;                                                        \
+            }                                                                    \
+            if (value) {                                                         \
+                *value = m->zero_value;                                          \
+            }                                                                    \
+            return true;                                                         \
+        }                                                                        \
+    }                                                                            \
+    for (size_t i = *cursor - 1; i <= m->mask; i++) {                            \
+        if (m->slots[i].key != 0) {                                              \
+            *cursor = i + 2;                                                     \
+            if (key) {                                                           \
+                *key = m->slots[i].key;                                          \
+            }                                                                    \
+            if (value) {                                                         \
+                *value = m->slots[i].value;                                      \
+            }                                                                    \
+            return true;                                                         \
+        }                                                                        \
+    }                                                                            \
+    *cursor = m->mask + 2;                                                       \
+    return false;                                                                \
+}
+
+INT_MAP_DEFINE(int_map, void *)
+INT_MAP_DEFINE(u64_map, uint64_t)
@@ -1,17 +1,70 @@
 #include "../../include/map.h"
 #include "hash_map.h"
+#include "flat_hash_map.h"
+#include "concurrent_hash_map.h"
 
-map *create_map(map_type type, int capacity, int (*hash_func)(void *, int), comparator compare) {
+#include <string.h>
+
+static map *create_map_with_hasher(map_type type, int capacity, map_hasher hasher, comparator compare) {
     switch (type) {
         case HASH_MAP:
-            return create_hash_map(capacity, hash_func, compare, 0);
+            return create_hash_map(capacity, hasher, compare, 0, 0);
         case HASH_TABLE:
-            return create_hash_map(capacity, hash_func, compare, 1);
+            return create_hash_map(capacity, hasher, compare, 1, 0);
+        case HASH_MAP_INCREMENTAL:
+            return create_hash_map(capacity, hasher, compare, 0, 1);
+        case HASH_MAP_FLAT:
+            return create_flat_hash_map(capacity, hasher, compare);
+        case HASH_MAP_CONCURRENT:
+            return create_concurrent_hash_map(capacity, hasher, compare);
         default:
             return NULL;
     }
 }
 
+map *create_map(map_type type, int capacity, int (*hash_func)(void *, int), comparator compare) {
+    map_hasher hasher = {hash_func, NULL};
+    if (!hash_func) {
+        hasher.hash64 = wyhash64;
+    }
+    return create_map_with_hasher(type, capacity, hasher, compare);
+}
+
+map *create_map_hash64(map_type type, int capacity, hash64_func_t hash, comparator compare) {
+    map_hasher hasher = {NULL, hash ? hash : wyhash64};
+    return create_map_with_hasher(type, capacity, hasher, compare);
+}
+
+map *create_map_with_pool(map_type type, int capacity, hash_func_t hash_func, comparator compare,
+                          memory_pool *pool) {
+    map *m = create_map(type, capacity, hash_func, compare);
+    if (!m) {
+        return NULL;
+    }
+
+    ova_error_code err = OVA_SUCCESS;
+    switch (type) {
+        case HASH_MAP:
+        case HASH_TABLE:
+        case HASH_MAP_INCREMENTAL:
+            err = hash_map_impl_use_pool(map_impl_from_map(m), pool);
+            break;
+        case HASH_MAP_CONCURRENT:
+            /* Segments are written in parallel; a shared pool has no lock. */
+            err = concurrent_hash_map_use_slabs(m);
+            break;
+        case HASH_MAP_FLAT:
+        default:
+            break;
+    }
+
+    if (err != OVA_SUCCESS) {
+        m->free(m);
+        return NULL;
+    }
+    return m;
+}
+
 hash_func_t hash_functions[HASH_FUNC_COUNT] = {
     bernstein_hash,
     fnv1a_hash,
@@ -31,7 +84,7 @@ int bernstein_hash(void *key, int capacity) {
     while ((c = *str++)) {
         hash = ((hash << 5) + hash) + (unsigned long)c;
     }
-    return (int)(hash % (unsigned long)capacity);
+    return (int)map_reduce((uint64_t)hash, (uint32_t)capacity);
 }
 
 int fnv1a_hash(void *key, int capacity) {
@@ -45,7 +98,7 @@ int fnv1a_hash(void *key, int capacity) {
         hash ^= (unsigned long)(*str++);
         hash *= 16777619;
     }
-    return (int)(hash % (unsigned long)capacity);
+    return (int)map_reduce((uint64_t)hash, (uint32_t)capacity);
 }
 
 int xor_hash(void *key, int capacity) {
@@ -58,7 +111,7 @@ int xor_hash(void *key, int capacity) {
     while (*str) {
         hash ^= (hash << 5) + (hash >> 2) + (unsigned long)(*str++);
     }
-    return (int)(hash % (unsigned long)capacity);
+    return (int)map_reduce((uint64_t)hash, (uint32_t)capacity);
 }
 
 int rotational_hash(void *key, int capacity) {
@@ -71,7 +124,7 @@ int rotational_hash(void *key, int capacity) {
     while (*str) {
         hash = (hash << 4) ^ (hash >> 28) ^ (unsigned long)(*str++);
     }
-    return (int)(hash % (unsigned long)capacity);
+    return (int)map_reduce((uint64_t)hash, (uint32_t)capacity);
 }
 
 int additive_hash(void *key, int capacity) {
@@ -84,5 +137,124 @@ int additive_hash(void *key, int capacity) {
     while (*str) {
         hash += (unsigned long)(*str++);
     }
-    return (int)(hash % (unsigned long)capacity);
+    return (int)map_reduce((uint64_t)hash, (uint32_t)capacity);
+}
+
+uint64_t fnv1a_hash64(const void *key) {
+    if (key == NULL) {
+        return 0;
+    }
+
+    const unsigned char *str = (const unsigned char *)key;
+    uint64_t hash = 14695981039346656037ULL;
+    while (*str) {
+        hash ^= (uint64_t)(*str++);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/*
+ * wyhash-style bytes hash: the input is consumed 16 or 48 bytes at a time as
+ * 64-bit words and folded with full 64x64->128 multiplies, whose high and low
+ * halves are xored together ("mum"). Short keys read overlapping words so no
+ * path loops per byte.
+ */
+#define WY_SECRET0 0xa0761d6478bd642fULL
+#define WY_SECRET1 0xe7037ed1a0b428dbULL
+#define WY_SECRET2 0x8ebc6af09c88c6e3ULL
+#define WY_SECRET3 0x589965cc75374cc3ULL
+
+static inline void wy_mum(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)*a * *b;
+    *a = (uint64_t)product;
+    *b = (uint64_t)(product >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    uint64_t t = ll + (hl << 32);
+    uint64_t carry = (uint64_t)(t < ll);
+    uint64_t lo = t + (lh << 32);
+    carry += (uint64_t)(lo < t);
+    *a = lo;
+    *b = hh + (hl >> 32) + (lh >> 32) + carry;
+#endif
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b) {
+    wy_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t wy_read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t wy_read32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/* First, middle and last byte: covers every length from 1 to 3. */
+static inline uint64_t wy_read_small(const unsigned char *p, size_t len) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | (uint64_t)p[len - 1];
+}
+
+uint64_t hash_bytes64(const void *data, size_t len, uint64_t seed) {
+    if (data == NULL) {
+        len = 0;
+    }
+
+    const unsigned char *p = (const unsigned char *)data;
+    uint64_t a = 0;
+    uint64_t b = 0;
+    seed ^= wy_mix(seed ^ WY_SECRET0, WY_SECRET1);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t mid = (len >> 3) << 2;
+            a = (wy_read32(p) << 32) | wy_read32(p + mid);
+            b = (wy_read32(p + len - 4) << 32) | wy_read32(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = wy_read_small(p, len);
+        }
+    } else {
+        size_t remaining = len;
+        if (remaining > 48) {
+            uint64_t lane1 = seed;
+            uint64_t lane2 = seed;
+            do {
+                seed = wy_mix(wy_read64(p) ^ WY_SECRET1, wy_read64(p + 8) ^ seed);
+                lane1 = wy_mix(wy_read64(p + 16) ^ WY_SECRET2, wy_read64(p + 24) ^ lane1);
+                lane2 = wy_mix(wy_read64(p + 32) ^ WY_SECRET3, wy_read64(p + 40) ^ lane2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (remaining > 16) {
+            seed = wy_mix(wy_read64(p) ^ WY_SECRET1, wy_read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        /* The final 16 bytes may overlap words already consumed. */
+        a = wy_read64(p + remaining - 16);
+        b = wy_read64(p + remaining - 8);
+    }
+
+    a ^= WY_SECRET1;
+    b ^= seed;
+    wy_mum(&a, &b);
+    return wy_mix(a ^ WY_SECRET0 ^ (uint64_t)len, b ^ WY_SECRET1);
+}
+
+uint64_t wyhash64(const void *key) {
+    if (key == NULL) {
+        return 0;
+    }
+    return hash_bytes64(key, strlen((const char *)key), 0);
 }
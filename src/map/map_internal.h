@@ -2,27 +2,115 @@
 #define MAP_INTERNAL_H
 
 #include "../../include/map.h"
+#include "../../include/memory_pool.h"
 
+#include <limits.h>
 #include <pthread.h>
+#include <stdint.h>
 
 typedef struct map_entry {
     void *key;
     void *data;
+    uint64_t hash;
     struct map_entry *next;
 } map_entry;
 
+/*
+ * Hash source for a map: either a 64-bit hash used as-is, or a legacy
+ * bucket-index hash adapted by asking for an index in [0, INT_MAX) and
+ * mixing the result over 64 bits.
+ */
+typedef struct map_hasher {
+    hash_func_t legacy;
+    hash64_func_t hash64;
+} map_hasher;
+
+/*
+ * Every backend impl starts with its map_type so internal helpers can
+ * dispatch on a map without knowing which backend created it.
+ */
 typedef struct map_impl {
     map_type type;
     map_entry **buckets;
     int capacity;
     int size;
-    int (*hash_func)(void *key, int capacity);
+    double max_load;
+    map_hasher hasher;
     comparator key_compare;
     pthread_mutex_t *lock;
+    /* Incremental resize: while old_buckets is set, buckets below
+     * migrate_pos have already been moved into buckets, migrate_budget at a
+     * time per mutating call. */
+    int incremental;
+    map_entry **old_buckets;
+    int old_capacity;
+    int migrate_pos;
+    int migrate_budget;
+    /* Entry allocator: NULL means malloc/free per node. An owned pool is
+     * private to this table, so clear and destroy drop it wholesale. */
+    memory_pool *pool;
+    int owns_pool;
 } map_impl;
 
+/* Keys hashed and prefetched together by the bulk operations. */
+#define MAP_BULK_BATCH 16
+
+#if defined(__GNUC__) || defined(__clang__)
+#define map_prefetch(addr) __builtin_prefetch(addr)
+#else
+#define map_prefetch(addr) ((void)(addr))
+#endif
+
+/* splitmix64 finalizer: spreads narrow hashes over all 64 bits. */
+static inline uint64_t map_mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/*
+ * Map a 64-bit hash onto [0, range) without a division: a Fibonacci multiply
+ * folds every input bit into the top word, whose high 32 bits are then scaled
+ * by range (Lemire's fastrange). Unlike `%`, weak or identity hashes whose
+ * entropy sits in a few bits still spread over the whole range.
+ */
+static inline uint32_t map_reduce(uint64_t hash, uint32_t range) {
+    uint64_t folded = (hash * 0x9e3779b97f4a7c15ULL) >> 32;
+    return (uint32_t)((folded * (uint64_t)range) >> 32);
+}
+
+/*
+ * Backends read the high bits directly (flat H1/H2 tags, concurrent segment
+ * choice), so every hash but the already well-mixed wyhash64 is finalized
+ * with map_mix64; an identity hash on integer ids would otherwise leave
+ * those bits zero.
+ */
+static inline uint64_t map_hasher_apply(const map_hasher *hasher, void *key) {
+    if (key == NULL) {
+        return 0;
+    }
+    if (hasher->hash64 == wyhash64) {
+        return wyhash64(key);
+    }
+    if (hasher->hash64) {
+        return map_mix64(hasher->hash64(key));
+    }
+    return map_mix64((uint64_t)(unsigned int)hasher->legacy(key, INT_MAX));
+}
+
+static inline int map_load_factor_valid(double load_factor) {
+    return load_factor >= LOAD_FACTOR_MIN && load_factor <= LOAD_FACTOR_MAX;
+}
+
 static inline map_impl *map_impl_from_map(const map *m) {
     return m ? (map_impl *)m->impl : NULL;
 }
 
+static inline map_type map_backend_type(const map *m) {
+    return (m && m->impl) ? *(const map_type *)m->impl : HASH_MAP;
+}
+
 #endif // MAP_INTERNAL_H
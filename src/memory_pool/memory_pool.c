@@ -47,12 +47,11 @@ static size_t align_up(size_t size, size_t alignment) {
 }
 
 /**
- * Initialise the free list for a newly allocated chunk.
+ * Push every block of @p c onto the free list.
  * The usable area starts right after the @c chunk header.
  */
-static void init_chunk_free_list(memory_pool *pool, chunk *c) {
-    unsigned char *base = c->data;
-    unsigned char *ptr = base;
+static void thread_chunk_blocks(memory_pool *pool, chunk *c) {
+    unsigned char *ptr = c->data;
 
     for (int i = 0; i < pool->blocks_per_chunk; i++) {
         free_node *node = (free_node *)(void *)ptr;
@@ -60,6 +59,13 @@ static void init_chunk_free_list(memory_pool *pool, chunk *c) {
         pool->free_list  = node;
         ptr += pool->aligned_block;
     }
+}
+
+/**
+ * Initialise the free list for a newly allocated chunk.
+ */
+static void init_chunk_free_list(memory_pool *pool, chunk *c) {
+    thread_chunk_blocks(pool, c);
 
     pool->total_blocks += (size_t)pool->blocks_per_chunk;
     pool->free_blocks  += (size_t)pool->blocks_per_chunk;
@@ -155,6 +161,29 @@ size_t memory_pool_active_count(const memory_pool *pool) {
     return pool->total_blocks - pool->free_blocks;
 }
 
+size_t memory_pool_free_count(const memory_pool *pool) {
+    if (!pool) {
+        return 0;
+    }
+    return pool->free_blocks;
+}
+
+void memory_pool_reset(memory_pool *pool) {
+    if (!pool) {
+        return;
+    }
+
+    pool->free_list = NULL;
+    for (chunk *c = pool->chunks; c; c = c->next) {
+        thread_chunk_blocks(pool, c);
+    }
+    pool->free_blocks = pool->total_blocks;
+}
+
+size_t memory_pool_block_size(const memory_pool *pool) {
+    return pool ? pool->block_size : 0;
+}
+
 void memory_pool_destroy(memory_pool *pool) {
     if (!pool) {
         return;
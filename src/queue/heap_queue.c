@@ -1,6 +1,7 @@
 #include "heap_queue.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 static queue *priority_clone_shallow(const queue *self);
 static queue *priority_clone_deep(const queue *self, element_copier copier);
@@ -64,7 +65,7 @@ int priority_size(const queue *self) {
     return (impl && impl->p_heap) ? impl->p_heap->size(impl->p_heap) : 0;
 }
 
-queue *create_heap_queue(int capacity, comparator compare) {
+static queue *heap_queue_create(int capacity, comparator compare, size_t element_size) {
     queue *out = (queue *)calloc(1, sizeof(queue));
     if (!out) {
         return NULL;
@@ -79,7 +80,9 @@ queue *create_heap_queue(int capacity, comparator compare) {
     impl->type = QUEUE_TYPE_PRIORITY;
     impl->cmp = compare;
     impl->initial_capacity = capacity;
-    impl->p_heap = create_heap(BINARY_HEAP, capacity, compare);
+    impl->element_size = element_size;
+    impl->p_heap = element_size > 0 ? create_heap_of(BINARY_HEAP, element_size, capacity, compare)
+                                    : create_heap(BINARY_HEAP, capacity, compare);
     if (!impl->p_heap) {
         free(impl);
         free(out);
@@ -99,6 +102,28 @@ queue *create_heap_queue(int capacity, comparator compare) {
     return out;
 }
 
+queue *create_heap_queue(int capacity, comparator compare) {
+    return heap_queue_create(capacity, compare, 0);
+}
+
+queue *create_heap_queue_of(size_t element_size, int capacity, comparator compare) {
+    return element_size > 0 ? heap_queue_create(capacity, compare, element_size) : NULL;
+}
+
+/*
+ * Pops all @p n elements of @p h into @p elems. Inline values are copied
+ * into @p values first, since a popped pointer only lasts until the next put.
+ */
+static void drain_heap(heap *h, int n, void **elems, unsigned char *values, size_t element_size) {
+    for (int i = 0; i < n; i++) {
+        elems[i] = h->pop(h);
+        if (values) {
+            memcpy(values + (size_t)i * element_size, elems[i], element_size);
+            elems[i] = values + (size_t)i * element_size;
+        }
+    }
+}
+
 static queue *priority_clone_shallow(const queue *self) {
     if (!self) {
         return NULL;
@@ -110,9 +135,9 @@ static queue *priority_clone_shallow(const queue *self) {
     }
 
     int n = impl->p_heap->size(impl->p_heap);
-    queue *copy = create_heap_queue(
+    queue *copy = heap_queue_create(
         n > impl->initial_capacity ? n : impl->initial_capacity,
-        impl->cmp);
+        impl->cmp, impl->element_size);
     if (!copy) {
         return NULL;
     }
@@ -122,18 +147,20 @@ static queue *priority_clone_shallow(const queue *self) {
     void **elems = NULL;
     if (n > 0) {
         elems = (void **)malloc((size_t)n * sizeof(void *));
-        if (!elems) {
+        unsigned char *values = impl->element_size > 0 ? malloc((size_t)n * impl->element_size) : NULL;
+        if (!elems || (impl->element_size > 0 && !values)) {
+            free(values);
+            free(elems);
             copy->free(copy);
             return NULL;
         }
         heap *orig_heap = impl->p_heap;
-        for (int i = 0; i < n; i++) {
-            elems[i] = orig_heap->pop(orig_heap);
-        }
+        drain_heap(orig_heap, n, elems, values, impl->element_size);
         for (int i = 0; i < n; i++) {
             orig_heap->put(orig_heap, elems[i]);
             copy->enqueue(copy, elems[i]);
         }
+        free(values);
         free(elems);
     }
 
@@ -142,11 +169,14 @@ static queue *priority_clone_shallow(const queue *self) {
 }
 
 static queue *priority_clone_deep(const queue *self, element_copier copier) {
+    queue_impl *impl = queue_impl_from_queue(self);
+    if (impl && impl->element_size > 0) {
+        return priority_clone_shallow(self);
+    }
     if (!self || !copier) {
         return NULL;
     }
 
-    queue_impl *impl = queue_impl_from_queue(self);
     if (!impl || !impl->p_heap) {
         return NULL;
     }
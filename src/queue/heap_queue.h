@@ -11,5 +11,6 @@ void priority_free(queue *self);
 int priority_size(const queue *self);
 
 queue *create_heap_queue (int capacity, comparator compare);
+queue *create_heap_queue_of(size_t element_size, int capacity, comparator compare);
 
 #endif // HEAP_QUEUE_H
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include "heap_queue.h"
 #include "linked_queue.h"
+#include "value_queue.h"
 
 queue *create_queue(queue_type type, int capacity, comparator compare) {
     switch (type) {
@@ -12,3 +13,14 @@ queue *create_queue(queue_type type, int capacity, comparator compare) {
             return NULL;
     }
 }
+
+queue *create_queue_of(queue_type type, size_t element_size, int capacity, comparator compare) {
+    switch (type) {
+        case QUEUE_TYPE_NORMAL:
+            return create_value_queue(element_size, capacity);
+        case QUEUE_TYPE_PRIORITY:
+            return create_heap_queue_of(element_size, capacity, compare);
+        default:
+            return NULL;
+    }
+}
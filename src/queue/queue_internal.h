@@ -18,6 +18,7 @@ typedef struct queue_impl {
     int initial_capacity;
     queue_entry *freelist;
     int freelist_size;
+    size_t element_size; /* bytes per inline value, 0 for pointer payloads */
 } queue_impl;
 
 static inline queue_impl *queue_impl_from_queue(const queue *q) {
@@ -0,0 +1,98 @@
+#include "value_queue.h"
+#include "../../include/deque.h"
+
+#include <stdlib.h>
+
+/*
+ * FIFO queue of inline values, backed by a value deque: enqueue pushes at
+ * the back and dequeue pops the front, so both are O(1) with no per-element
+ * allocation.
+ */
+
+static deque *value_queue_deque(const queue *self) {
+    return self ? (deque *)self->impl : NULL;
+}
+
+static ova_error_code value_enqueue(queue *self, void *data) {
+    deque *dq = value_queue_deque(self);
+    return dq ? dq->push_back(dq, data) : OVA_ERROR_INVALID_ARG;
+}
+
+static void *value_dequeue(queue *self) {
+    deque *dq = value_queue_deque(self);
+    return dq ? dq->pop_front(dq) : NULL;
+}
+
+static int value_is_empty(const queue *self) {
+    deque *dq = value_queue_deque(self);
+    return dq ? dq->is_empty(dq) : 1;
+}
+
+static int value_size(const queue *self) {
+    deque *dq = value_queue_deque(self);
+    return dq ? dq->size(dq) : 0;
+}
+
+static void value_clear(queue *self) {
+    deque *dq = value_queue_deque(self);
+    while (dq && !dq->is_empty(dq)) {
+        dq->pop_front(dq);
+    }
+}
+
+static void value_free(queue *self) {
+    if (!self) {
+        return;
+    }
+    deque *dq = value_queue_deque(self);
+    if (dq) {
+        dq->free(dq);
+    }
+    free(self);
+}
+
+static queue *value_wrap(deque *dq);
+
+static queue *value_clone_shallow(const queue *self) {
+    deque *dq = value_queue_deque(self);
+    if (!dq) {
+        return NULL;
+    }
+    queue *copy = value_wrap(dq->clone_shallow(dq));
+    if (copy) {
+        copy->user_data = self->user_data;
+    }
+    return copy;
+}
+
+static queue *value_clone_deep(const queue *self, element_copier copier) {
+    (void)copier;
+    return value_clone_shallow(self);
+}
+
+/* Queue over @p dq; takes ownership of @p dq. */
+static queue *value_wrap(deque *dq) {
+    if (!dq) {
+        return NULL;
+    }
+    queue *out = (queue *)calloc(1, sizeof(queue));
+    if (!out) {
+        dq->free(dq);
+        return NULL;
+    }
+
+    out->impl = dq;
+    out->enqueue = value_enqueue;
+    out->dequeue = value_dequeue;
+    out->is_empty = value_is_empty;
+    out->size = value_size;
+    out->clear = value_clear;
+    out->free = value_free;
+    out->clone_shallow = value_clone_shallow;
+    out->clone_deep = value_clone_deep;
+    return out;
+}
+
+queue *create_value_queue(size_t element_size, int capacity) {
+    return value_wrap(create_deque_of(element_size, capacity));
+}
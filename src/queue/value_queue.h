@@ -0,0 +1,8 @@
+#ifndef VALUE_QUEUE_H
+#define VALUE_QUEUE_H
+
+#include "../../include/queue.h"
+
+queue *create_value_queue(size_t element_size, int capacity);
+
+#endif // VALUE_QUEUE_H
@@ -0,0 +1,192 @@
+#include "set_internal.h"
+
+#include "../../include/bitset.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * SET_BITMAP elements are non-negative integers carried in the pointer
+ * itself, so 0 travels as NULL. Iteration runs in ascending order.
+ */
+typedef struct {
+    bitset *bits;
+} bitmap_set_impl;
+
+static bitmap_set_impl *bitmap_set_impl_from_state(const set_impl *state) {
+    return state ? (bitmap_set_impl *)state->backend_impl : NULL;
+}
+
+static size_t bitmap_set_value(const void *element) {
+    return (size_t)(uintptr_t)element;
+}
+
+static void *bitmap_set_element(size_t value) {
+    return (void *)(uintptr_t)value;
+}
+
+static bool bitmap_set_add(set_impl *state, void *element) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    return impl && bitset_add(impl->bits, bitmap_set_value(element));
+}
+
+static bool bitmap_set_contains(const set_impl *state, void *element) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    return impl && bitset_contains(impl->bits, bitmap_set_value(element));
+}
+
+static bool bitmap_set_remove(set_impl *state, void *element) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    return impl && bitset_remove(impl->bits, bitmap_set_value(element));
+}
+
+static int bitmap_set_size(const set_impl *state) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    return impl ? (int)bitset_size(impl->bits) : 0;
+}
+
+static void bitmap_set_for_each(const set_impl *state, set_visitor visit, void *ctx) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    if (!impl || !visit) {
+        return;
+    }
+
+    size_t bit = 0;
+    size_t from = 0;
+    while (bitset_next(impl->bits, from, &bit)) {
+        visit(bitmap_set_element(bit), ctx);
+        from = bit + 1;
+    }
+}
+
+static void bitmap_set_collect(void *element, void *ctx) {
+    list *out = (list *)ctx;
+    out->insert(out, element, out->size(out));
+}
+
+static list *bitmap_set_to_list(const set_impl *state) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    if (!impl) {
+        return NULL;
+    }
+
+    int n = bitmap_set_size(state);
+    list *out = create_list(ARRAY_LIST, n > 0 ? n : 4, NULL);
+    if (!out) {
+        return NULL;
+    }
+
+    bitmap_set_for_each(state, bitmap_set_collect, out);
+    return out;
+}
+
+/* cursor.index is the next bit to examine; removal only clears bits already passed. */
+static void bitmap_set_iter_begin(const set_impl *state, set_iterator *it) {
+    (void)state;
+    it->cursor.index = 0;
+    it->cursor.entry = NULL;
+}
+
+static bool bitmap_set_iter_next(const set_impl *state, set_iterator *it) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    size_t bit = 0;
+    if (!impl || !bitset_next(impl->bits, it->cursor.index, &bit)) {
+        it->cursor.entry = NULL;
+        return false;
+    }
+    it->cursor.index = bit + 1;
+    it->cursor.entry = impl;
+    it->element = bitmap_set_element(bit);
+    return true;
+}
+
+static bool bitmap_set_iter_remove(set_impl *state, set_iterator *it) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    if (!impl || !it->cursor.entry) {
+        return false;
+    }
+    it->cursor.entry = NULL;
+    return bitset_remove(impl->bits, it->cursor.index - 1);
+}
+
+static bool bitmap_set_fill_copy(set_impl *state, const set_impl *src, int extra) {
+    (void)extra;
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    bitmap_set_impl *from = bitmap_set_impl_from_state(src);
+    if (!impl || !from) {
+        return false;
+    }
+
+    bitset *copy = bitset_clone(from->bits);
+    if (!copy) {
+        return false;
+    }
+    bitset_free(impl->bits);
+    impl->bits = copy;
+    return true;
+}
+
+static bool bitmap_set_combine(set_impl *state, const set_impl *other, set_merge_op op) {
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    bitmap_set_impl *rhs = bitmap_set_impl_from_state(other);
+    if (!impl || !rhs) {
+        return false;
+    }
+
+    switch (op) {
+        case SET_MERGE_UNION:
+            return bitset_union_into(impl->bits, rhs->bits) == OVA_SUCCESS;
+        case SET_MERGE_INTERSECTION:
+            bitset_intersect_into(impl->bits, rhs->bits);
+            return true;
+        case SET_MERGE_DIFFERENCE:
+            bitset_difference_into(impl->bits, rhs->bits);
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void bitmap_set_destroy(set_impl *state) {
+    if (!state) {
+        return;
+    }
+
+    bitmap_set_impl *impl = bitmap_set_impl_from_state(state);
+    if (impl) {
+        bitset_free(impl->bits);
+        free(impl);
+        state->backend_impl = NULL;
+    }
+}
+
+void *bitmap_set_create_impl(int capacity) {
+    bitmap_set_impl *impl = (bitmap_set_impl *)calloc(1, sizeof(bitmap_set_impl));
+    if (!impl) {
+        return NULL;
+    }
+
+    impl->bits = create_bitset(capacity > 0 ? (size_t)capacity : 0);
+    if (!impl->bits) {
+        free(impl);
+        return NULL;
+    }
+    return impl;
+}
+
+const set_ops bitmap_set_ops = {
+    .add = bitmap_set_add,
+    .contains = bitmap_set_contains,
+    .remove = bitmap_set_remove,
+    .size = bitmap_set_size,
+    .to_list = bitmap_set_to_list,
+    .for_each = bitmap_set_for_each,
+    .iter_begin = bitmap_set_iter_begin,
+    .iter_next = bitmap_set_iter_next,
+    .iter_remove = bitmap_set_iter_remove,
+    .reserve = NULL,
+    .fill_sorted = NULL,
+    .fill_copy = bitmap_set_fill_copy,
+    .combine = bitmap_set_combine,
+    .destroy = bitmap_set_destroy,
+};
@@ -1,91 +1,308 @@
 #include "set_internal.h"
 
 #include "../map/map_internal.h"
+#include "../utils/open_addressing.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+/*
+ * Keys-only open-addressing table. Each slot holds the element pointer and a
+ * 32-bit tag taken from its hash: the tag picks the home slot, filters
+ * comparator calls, and lets resizes and backward-shift deletion relocate
+ * elements without hashing them again. A zero tag marks an empty slot.
+ */
+#define HASH_SET_TAG_BIT 0x80000000u
 
 typedef struct {
-    map *m;
+    void **keys;
+    uint32_t *tags;
+    size_t mask;
+    int size;
+    comparator cmp;
+    hash_func_t hash;
 } hash_set_impl;
 
-static char hash_set_marker;
-
 static hash_set_impl *hash_set_impl_from_state(const set_impl *state) {
     return state ? (hash_set_impl *)state->backend_impl : NULL;
 }
 
-static bool hash_set_add(set_impl *state, void *element) {
-    if (!state || !element) {
-        return false;
+static uint32_t hash_set_tag(const hash_set_impl *impl, void *element) {
+    uint64_t h = map_mix64((uint64_t)(unsigned int)impl->hash(element, INT_MAX));
+    return (uint32_t)h | HASH_SET_TAG_BIT;
+}
+
+/* Slot holding @p element, or the empty slot that ends its probe run. */
+static size_t hash_set_probe(const hash_set_impl *impl, void *element, uint32_t tag) {
+    size_t i = tag & impl->mask;
+    while (impl->tags[i] != 0) {
+        if (impl->tags[i] == tag && impl->cmp(impl->keys[i], element) == 0) {
+            return i;
+        }
+        i = (i + 1) & impl->mask;
     }
+    return i;
+}
 
-    hash_set_impl *impl = hash_set_impl_from_state(state);
-    if (!impl || !impl->m) {
+static bool hash_set_alloc_slots(hash_set_impl *impl, size_t slots) {
+    impl->keys = (void **)calloc(slots, sizeof(void *));
+    impl->tags = (uint32_t *)calloc(slots, sizeof(uint32_t));
+    if (!impl->keys || !impl->tags) {
+        free(impl->keys);
+        free(impl->tags);
+        impl->keys = NULL;
+        impl->tags = NULL;
         return false;
     }
+    impl->mask = slots - 1;
+    return true;
+}
 
-    int before = impl->m->size(impl->m);
-    impl->m->put(impl->m, element, &hash_set_marker);
-    return impl->m->size(impl->m) > before;
+/* Place every tagged element of @p keys into the table by its stored tag. */
+static void hash_set_insert_all(hash_set_impl *impl, void **keys, const uint32_t *tags, size_t slots) {
+    for (size_t i = 0; i < slots; i++) {
+        if (tags[i] == 0) {
+            continue;
+        }
+        size_t j = tags[i] & impl->mask;
+        while (impl->tags[j] != 0) {
+            j = (j + 1) & impl->mask;
+        }
+        impl->keys[j] = keys[i];
+        impl->tags[j] = tags[i];
+    }
 }
 
-static bool hash_set_contains(const set_impl *state, void *element) {
-    if (!state || !element) {
+static bool hash_set_rehash(hash_set_impl *impl, size_t slots) {
+    void **old_keys = impl->keys;
+    uint32_t *old_tags = impl->tags;
+    size_t old_slots = impl->mask + 1;
+
+    if (!hash_set_alloc_slots(impl, slots)) {
+        impl->keys = old_keys;
+        impl->tags = old_tags;
         return false;
     }
+    hash_set_insert_all(impl, old_keys, old_tags, old_slots);
+    free(old_keys);
+    free(old_tags);
+    return true;
+}
 
+static bool hash_set_reserve_impl(hash_set_impl *impl, size_t entries) {
+    size_t slots = open_addressing_slots_for(entries);
+    return slots <= impl->mask + 1 || hash_set_rehash(impl, slots);
+}
+
+static bool hash_set_add(set_impl *state, void *element) {
     hash_set_impl *impl = hash_set_impl_from_state(state);
-    if (!impl || !impl->m) {
+    if (!impl || !element) {
         return false;
     }
 
-    return impl->m->get(impl->m, element) != NULL;
+    uint32_t tag = hash_set_tag(impl, element);
+    size_t i = hash_set_probe(impl, element, tag);
+    if (impl->tags[i] != 0) {
+        return false;
+    }
+
+    size_t wanted = (size_t)impl->size + 1;
+    if (open_addressing_over_load(wanted, impl->mask + 1)) {
+        if (impl->mask + 1 >= OPEN_ADDRESSING_MAX_SLOTS) {
+            if (wanted > impl->mask) {
+                return false;
+            }
+        } else {
+            if (!hash_set_rehash(impl, (impl->mask + 1) << 1)) {
+                return false;
+            }
+            i = hash_set_probe(impl, element, tag);
+        }
+    }
+
+    impl->keys[i] = element;
+    impl->tags[i] = tag;
+    impl->size++;
+    return true;
 }
 
-static bool hash_set_remove(set_impl *state, void *element) {
-    if (!state || !element) {
+static bool hash_set_contains(const set_impl *state, void *element) {
+    hash_set_impl *impl = hash_set_impl_from_state(state);
+    if (!impl || !element) {
         return false;
     }
+    return impl->tags[hash_set_probe(impl, element, hash_set_tag(impl, element))] != 0;
+}
+
+static bool hash_set_slot_occupied(const void *table, size_t index) {
+    return ((const hash_set_impl *)table)->tags[index] != 0;
+}
+
+static size_t hash_set_slot_home(const void *table, size_t index) {
+    const hash_set_impl *impl = (const hash_set_impl *)table;
+    return impl->tags[index] & impl->mask;
+}
+
+static void hash_set_slot_move(void *table, size_t to, size_t from) {
+    hash_set_impl *impl = (hash_set_impl *)table;
+    impl->keys[to] = impl->keys[from];
+    impl->tags[to] = impl->tags[from];
+}
+
+static const open_addressing_ops hash_set_slot_ops = {
+    hash_set_slot_occupied, hash_set_slot_home, hash_set_slot_move,
+};
 
+static void hash_set_erase_at(hash_set_impl *impl, size_t hole) {
+    hole = open_addressing_erase(impl, impl->mask, hole, &hash_set_slot_ops);
+    impl->keys[hole] = NULL;
+    impl->tags[hole] = 0;
+    impl->size--;
+}
+
+static bool hash_set_remove(set_impl *state, void *element) {
     hash_set_impl *impl = hash_set_impl_from_state(state);
-    if (!impl || !impl->m) {
+    if (!impl || !element) {
         return false;
     }
 
-    return impl->m->remove(impl->m, element) != NULL;
+    size_t i = hash_set_probe(impl, element, hash_set_tag(impl, element));
+    if (impl->tags[i] == 0) {
+        return false;
+    }
+    hash_set_erase_at(impl, i);
+    return true;
 }
 
 static int hash_set_size(const set_impl *state) {
     hash_set_impl *impl = hash_set_impl_from_state(state);
-    return (impl && impl->m) ? impl->m->size(impl->m) : 0;
+    return impl ? impl->size : 0;
 }
 
-static list *hash_set_to_list(const set_impl *state) {
+static void hash_set_for_each(const set_impl *state, set_visitor visit, void *ctx) {
     hash_set_impl *impl = hash_set_impl_from_state(state);
-    if (!impl || !impl->m) {
-        return NULL;
+    if (!impl || !visit) {
+        return;
+    }
+
+    for (size_t i = 0; i <= impl->mask; i++) {
+        if (impl->tags[i] != 0) {
+            visit(impl->keys[i], ctx);
+        }
     }
+}
 
-    map_impl *map_state = map_impl_from_map(impl->m);
-    if (!map_state) {
+static void hash_set_collect(void *element, void *ctx) {
+    list *out = (list *)ctx;
+    out->insert(out, element, out->size(out));
+}
+
+static list *hash_set_to_list(const set_impl *state) {
+    hash_set_impl *impl = hash_set_impl_from_state(state);
+    if (!impl) {
         return NULL;
     }
 
-    int n = impl->m->size(impl->m);
-    list *out = create_list(ARRAY_LIST, n > 0 ? n : 4, NULL);
+    list *out = create_list(ARRAY_LIST, impl->size > 0 ? impl->size : 4, NULL);
     if (!out) {
         return NULL;
     }
 
-    for (int i = 0; i < map_state->capacity; i++) {
-        map_entry *node = map_state->buckets ? map_state->buckets[i] : NULL;
-        while (node) {
-            out->insert(out, node->key, out->size(out));
-            node = node->next;
+    hash_set_for_each(state, hash_set_collect, out);
+    return out;
+}
+
+/*
+ * The cursor walks the slots cyclically starting just after an empty slot.
+ * Backward-shift deletion never moves an element across an empty slot, so
+ * removing through the cursor only pulls not-yet-visited elements into the
+ * current slot, which the next step then re-examines.
+ */
+static void hash_set_iter_begin(const set_impl *state, set_iterator *it) {
+    hash_set_impl *impl = hash_set_impl_from_state(state);
+    if (!impl) {
+        return;
+    }
+
+    size_t start = 0;
+    while (impl->tags[start] != 0) {
+        start++;
+    }
+    it->cursor.start = start;
+    it->cursor.index = 0;
+    it->cursor.entry = NULL;
+}
+
+static bool hash_set_iter_next(const set_impl *state, set_iterator *it) {
+    hash_set_impl *impl = hash_set_impl_from_state(state);
+    if (!impl) {
+        return false;
+    }
+
+    size_t slots = impl->mask + 1;
+    while (it->cursor.index < slots) {
+        size_t slot = (it->cursor.start + 1 + it->cursor.index) & impl->mask;
+        it->cursor.index++;
+        if (impl->tags[slot] != 0) {
+            it->cursor.entry = &impl->tags[slot];
+            it->element = impl->keys[slot];
+            return true;
         }
     }
+    it->cursor.entry = NULL;
+    return false;
+}
 
-    return out;
+static bool hash_set_iter_remove(set_impl *state, set_iterator *it) {
+    hash_set_impl *impl = hash_set_impl_from_state(state);
+    if (!impl || !it->cursor.entry) {
+        return false;
+    }
+
+    hash_set_erase_at(impl, (size_t)((uint32_t *)it->cursor.entry - impl->tags));
+    it->cursor.entry = NULL;
+    it->cursor.index--;
+    return true;
+}
+
+static bool hash_set_reserve(set_impl *state, int count) {
+    hash_set_impl *impl = hash_set_impl_from_state(state);
+    return impl && count >= 0 && hash_set_reserve_impl(impl, (size_t)count);
+}
+
+/* Copy @p src's table into an empty set, sized for @p extra more elements. */
+static bool hash_set_fill_copy(set_impl *state, const set_impl *src, int extra) {
+    hash_set_impl *impl = hash_set_impl_from_state(state);
+    hash_set_impl *from = hash_set_impl_from_state(src);
+    if (!impl || !from || impl->size != 0) {
+        return false;
+    }
+
+    size_t wanted = (size_t)from->size + (size_t)(extra > 0 ? extra : 0);
+    size_t slots = open_addressing_slots_for(wanted);
+    if (slots < from->mask + 1) {
+        slots = from->mask + 1;
+    }
+    if (slots != impl->mask + 1) {
+        void **old_keys = impl->keys;
+        uint32_t *old_tags = impl->tags;
+        if (!hash_set_alloc_slots(impl, slots)) {
+            impl->keys = old_keys;
+            impl->tags = old_tags;
+            return false;
+        }
+        free(old_keys);
+        free(old_tags);
+    }
+
+    if (slots == from->mask + 1) {
+        memcpy(impl->keys, from->keys, slots * sizeof(void *));
+        memcpy(impl->tags, from->tags, slots * sizeof(uint32_t));
+    } else {
+        hash_set_insert_all(impl, from->keys, from->tags, from->mask + 1);
+    }
+    impl->size = from->size;
+    return true;
 }
 
 static void hash_set_destroy(set_impl *state) {
@@ -95,10 +312,8 @@ static void hash_set_destroy(set_impl *state) {
 
     hash_set_impl *impl = hash_set_impl_from_state(state);
     if (impl) {
-        if (impl->m) {
-            impl->m->free(impl->m);
-            impl->m = NULL;
-        }
+        free(impl->keys);
+        free(impl->tags);
         free(impl);
         state->backend_impl = NULL;
     }
@@ -109,18 +324,17 @@ void *hash_set_create_impl(int capacity, comparator cmp, hash_func_t hash) {
         return NULL;
     }
 
-    map *m = create_map(HASH_MAP, capacity, hash, cmp);
-    if (!m) {
-        return NULL;
-    }
-
     hash_set_impl *impl = (hash_set_impl *)calloc(1, sizeof(hash_set_impl));
     if (!impl) {
-        m->free(m);
         return NULL;
     }
 
-    impl->m = m;
+    impl->cmp = cmp;
+    impl->hash = hash;
+    if (!hash_set_alloc_slots(impl, open_addressing_slots_for(capacity > 0 ? (size_t)capacity : 0))) {
+        free(impl);
+        return NULL;
+    }
     return impl;
 }
 
@@ -130,5 +344,13 @@ const set_ops hash_set_ops = {
     .remove = hash_set_remove,
     .size = hash_set_size,
     .to_list = hash_set_to_list,
+    .for_each = hash_set_for_each,
+    .iter_begin = hash_set_iter_begin,
+    .iter_next = hash_set_iter_next,
+    .iter_remove = hash_set_iter_remove,
+    .reserve = hash_set_reserve,
+    .fill_sorted = NULL,
+    .fill_copy = hash_set_fill_copy,
+    .combine = NULL,
     .destroy = hash_set_destroy,
 };
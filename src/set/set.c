@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 int set_default_ptr_compare(const void *a, const void *b) {
     uintptr_t lhs = (uintptr_t)a;
@@ -33,6 +34,11 @@ static void set_add_bulk_method(set *self, void **elements, int count) {
     if (!self || !elements || count <= 0) {
         return;
     }
+
+    set_impl *state = set_impl_from_public(self);
+    if (state && state->ops && state->ops->reserve) {
+        state->ops->reserve(state, state->ops->size(state) + count);
+    }
     for (int i = 0; i < count; i++) {
         self->add(self, elements[i]);
     }
@@ -58,6 +64,50 @@ static list *set_to_list_method(const set *self) {
     return (state && state->ops && state->ops->to_list) ? state->ops->to_list(state) : NULL;
 }
 
+static void set_for_each_method(const set *self, set_visitor visit, void *ctx) {
+    set_impl *state = set_impl_from_public(self);
+    if (state && state->ops && state->ops->for_each && visit) {
+        state->ops->for_each(state, visit, ctx);
+    }
+}
+
+static void set_iter_begin_method(const set *self, set_iterator *it) {
+    if (!it) {
+        return;
+    }
+    memset(it, 0, sizeof(*it));
+
+    set_impl *state = set_impl_from_public(self);
+    if (state && state->ops && state->ops->iter_begin) {
+        state->ops->iter_begin(state, it);
+    }
+}
+
+static bool set_iter_next_method(const set *self, set_iterator *it) {
+    set_impl *state = set_impl_from_public(self);
+    if (!it || !state || !state->ops || !state->ops->iter_next) {
+        return false;
+    }
+    if (!state->ops->iter_next(state, it)) {
+        it->element = NULL;
+        return false;
+    }
+    return true;
+}
+
+static bool set_iter_remove_method(set *self, set_iterator *it) {
+    set_impl *state = set_impl_from_public(self);
+    if (!it || !state || !state->ops || !state->ops->iter_remove) {
+        return false;
+    }
+    return state->ops->iter_remove(state, it);
+}
+
+static void set_add_visitor(void *element, void *ctx) {
+    set *out = (set *)ctx;
+    out->add(out, element);
+}
+
 static int sets_are_compatible(const set_impl *lhs, const set_impl *rhs) {
     if (!lhs || !rhs || !lhs->ops || !rhs->ops) {
         return 0;
@@ -76,6 +126,8 @@ static int sets_are_compatible(const set_impl *lhs, const set_impl *rhs) {
 static set *set_union_with_method(const set *self, const set *other);
 static set *set_intersection_with_method(const set *self, const set *other);
 static set *set_difference_with_method(const set *self, const set *other);
+static ova_error_code set_union_into_method(set *self, const set *other);
+static ova_error_code set_intersect_into_method(set *self, const set *other);
 static bool set_is_subset_of_method(const set *self, const set *other);
 static void set_free_method(set *self);
 static set *set_clone_shallow_method(const set *self);
@@ -119,6 +171,11 @@ static set *create_set_with_capacity(set_type type, comparator cmp, hash_func_t
         state->hash = NULL;
         state->ops = &tree_set_ops;
         state->backend_impl = tree_set_create_impl(cmp);
+    } else if (type == SET_BITMAP) {
+        state->cmp = set_default_ptr_compare;
+        state->hash = NULL;
+        state->ops = &bitmap_set_ops;
+        state->backend_impl = bitmap_set_create_impl(capacity_hint);
     } else {
         free(state);
         free(out);
@@ -138,9 +195,15 @@ static set *create_set_with_capacity(set_type type, comparator cmp, hash_func_t
     out->remove = set_remove_method;
     out->size = set_size_method;
     out->to_list = set_to_list_method;
+    out->for_each = set_for_each_method;
+    out->iter_begin = set_iter_begin_method;
+    out->iter_next = set_iter_next_method;
+    out->iter_remove = set_iter_remove_method;
     out->union_with = set_union_with_method;
     out->intersection_with = set_intersection_with_method;
     out->difference_with = set_difference_with_method;
+    out->union_into = set_union_into_method;
+    out->intersect_into = set_intersect_into_method;
     out->is_subset_of = set_is_subset_of_method;
     out->free = set_free_method;
     out->clone_shallow = set_clone_shallow_method;
@@ -148,6 +211,143 @@ static set *create_set_with_capacity(set_type type, comparator cmp, hash_func_t
     return out;
 }
 
+/*
+ * Probing each element of the smaller side costs about small * log2(big)
+ * comparisons in a tree; a linear merge costs small + big. Hash probes are
+ * O(1), so hash sets always probe.
+ */
+static bool set_probe_is_cheaper(const set_impl *state, int small, int big) {
+    if (!state->ops->fill_sorted) {
+        return true;
+    }
+    int depth = 1;
+    while (depth < 31 && (1 << depth) <= big) {
+        depth++;
+    }
+    return (long)small * depth < (long)small + big;
+}
+
+typedef struct {
+    void **items;
+    int count;
+} set_array;
+
+static void set_array_push(void *element, void *ctx) {
+    set_array *array = (set_array *)ctx;
+    array->items[array->count++] = element;
+}
+
+/* Elements of @p s in iteration order (ascending for tree sets). */
+static bool set_collect(const set *s, set_array *out) {
+    int n = s->size(s);
+    out->count = 0;
+    out->items = (void **)malloc((size_t)(n > 0 ? n : 1) * sizeof(void *));
+    if (!out->items) {
+        return false;
+    }
+    s->for_each(s, set_array_push, out);
+    return true;
+}
+
+/* One pass over two ascending arrays; @p out holds at least a->count + b->count. */
+static int set_merge_sorted(comparator cmp, const set_array *a, const set_array *b, set_merge_op op,
+                            void **out) {
+    int i = 0, j = 0, n = 0;
+    while (i < a->count && j < b->count) {
+        int c = cmp(a->items[i], b->items[j]);
+        if (c < 0) {
+            if (op != SET_MERGE_INTERSECTION) {
+                out[n++] = a->items[i];
+            }
+            i++;
+        } else if (c > 0) {
+            if (op == SET_MERGE_UNION) {
+                out[n++] = b->items[j];
+            }
+            j++;
+        } else {
+            if (op != SET_MERGE_DIFFERENCE) {
+                out[n++] = a->items[i];
+            }
+            i++;
+            j++;
+        }
+    }
+    if (op != SET_MERGE_INTERSECTION) {
+        while (i < a->count) {
+            out[n++] = a->items[i++];
+        }
+    }
+    if (op == SET_MERGE_UNION) {
+        while (j < b->count) {
+            out[n++] = b->items[j++];
+        }
+    }
+    return n;
+}
+
+/*
+ * Ordered backends: merge both in-order sequences, then build the result in
+ * O(n). A NULL @p other acts as the empty set.
+ */
+static set *set_merge_method(const set *self, const set *other, set_merge_op op) {
+    set_impl *state = set_impl_from_public(self);
+    set_array a = {NULL, 0};
+    set_array b = {NULL, 0};
+    void **merged = NULL;
+    set *out = NULL;
+
+    if (set_collect(self, &a) && (!other || set_collect(other, &b))) {
+        merged = (void **)malloc((size_t)(a.count + b.count + 1) * sizeof(void *));
+    }
+    if (merged) {
+        int n = set_merge_sorted(state->cmp, &a, &b, op, merged);
+        out = create_set_with_capacity(state->type, state->cmp, state->hash, n);
+        set_impl *out_state = set_impl_from_public(out);
+        if (out && !out_state->ops->fill_sorted(out_state, merged, n)) {
+            out->free(out);
+            out = NULL;
+        }
+    }
+
+    free(merged);
+    free(a.items);
+    free(b.items);
+    return out;
+}
+
+/* Start a result as a structural copy of @p src, with room for @p extra more. */
+static set *set_copy_with_room(const set *src, int extra) {
+    set_impl *state = set_impl_from_public(src);
+    if (!state) {
+        return NULL;
+    }
+    set *out = create_set_with_capacity(state->type, state->cmp, state->hash, 0);
+    if (!out) {
+        return NULL;
+    }
+    set_impl *out_state = set_impl_from_public(out);
+    if (!out_state->ops->fill_copy(out_state, state, extra)) {
+        out->free(out);
+        return NULL;
+    }
+    return out;
+}
+
+/* Backends with a native bulk operation: copy @p self, then combine in place. */
+static set *set_combine_method(const set *self, const set *other, set_merge_op op) {
+    set *out = set_copy_with_room(self, 0);
+    if (!out) {
+        return NULL;
+    }
+    set_impl *out_state = set_impl_from_public(out);
+    if (!out_state->ops->combine(out_state, set_impl_from_public(other), op)) {
+        out->free(out);
+        return NULL;
+    }
+    return out;
+}
+
 static set *set_union_with_method(const set *self, const set *other) {
     set_impl *lhs = set_impl_from_public(self);
     set_impl *rhs = set_impl_from_public(other);
@@ -155,32 +355,35 @@ static set *set_union_with_method(const set *self, const set *other) {
         return NULL;
     }
 
-    int cap = self->size(self) + other->size(other);
-    set *out = create_set_with_capacity(lhs->type, lhs->cmp, lhs->hash, cap);
-    if (!out) {
-        return NULL;
+    if (lhs->ops->combine) {
+        return set_combine_method(self, other, SET_MERGE_UNION);
     }
 
-    list *la = self->to_list(self);
-    if (!la) {
-        out->free(out);
-        return NULL;
+    if (lhs->ops->fill_sorted) {
+        return set_merge_method(self, other, SET_MERGE_UNION);
     }
-    for (int i = 0, n = la->size(la); i < n; i++) {
-        out->add(out, la->get(la, i));
+
+    const set *big = self;
+    const set *small = other;
+    if (self->size(self) < other->size(other)) {
+        big = other;
+        small = self;
     }
-    la->free(la);
 
-    list *lb = other->to_list(other);
-    if (!lb) {
-        out->free(out);
-        return NULL;
+    set *out;
+    if (lhs->ops->fill_copy) {
+        out = set_copy_with_room(big, small->size(small));
+    } else {
+        out = create_set_with_capacity(lhs->type, lhs->cmp, lhs->hash, self->size(self) + other->size(other));
+        if (out) {
+            big->for_each(big, set_add_visitor, out);
+        }
     }
-    for (int i = 0, n = lb->size(lb); i < n; i++) {
-        out->add(out, lb->get(lb, i));
+    if (!out) {
+        return NULL;
     }
-    lb->free(lb);
 
+    small->for_each(small, set_add_visitor, out);
     return out;
 }
 
@@ -191,6 +394,10 @@ static set *set_intersection_with_method(const set *self, const set *other) {
         return NULL;
     }
 
+    if (lhs->ops->combine) {
+        return set_combine_method(self, other, SET_MERGE_INTERSECTION);
+    }
+
     const set *iter = self;
     const set *match = other;
     if (other->size(other) < self->size(self)) {
@@ -198,25 +405,22 @@ static set *set_intersection_with_method(const set *self, const set *other) {
         match = self;
     }
 
-    set *out = create_set_with_capacity(lhs->type, lhs->cmp, lhs->hash, iter->size(iter));
-    if (!out) {
-        return NULL;
+    if (!set_probe_is_cheaper(lhs, iter->size(iter), match->size(match))) {
+        return set_merge_method(self, other, SET_MERGE_INTERSECTION);
     }
 
-    list *items = iter->to_list(iter);
-    if (!items) {
-        out->free(out);
+    set *out = create_set_with_capacity(lhs->type, lhs->cmp, lhs->hash, iter->size(iter));
+    if (!out) {
         return NULL;
     }
 
-    for (int i = 0, n = items->size(items); i < n; i++) {
-        void *element = items->get(items, i);
-        if (match->contains(match, element)) {
-            out->add(out, element);
+    set_iterator it;
+    iter->iter_begin(iter, &it);
+    while (iter->iter_next(iter, &it)) {
+        if (match->contains(match, it.element)) {
+            out->add(out, it.element);
         }
     }
-
-    items->free(items);
     return out;
 }
 
@@ -227,50 +431,113 @@ static set *set_difference_with_method(const set *self, const set *other) {
         return NULL;
     }
 
-    set *out = create_set_with_capacity(lhs->type, lhs->cmp, lhs->hash, self->size(self));
-    if (!out) {
-        return NULL;
+    if (lhs->ops->combine) {
+        return set_combine_method(self, other, SET_MERGE_DIFFERENCE);
     }
 
-    list *items = self->to_list(self);
-    if (!items) {
-        out->free(out);
-        return NULL;
+    if (lhs->ops->fill_sorted) {
+        return set_merge_method(self, other, SET_MERGE_DIFFERENCE);
     }
 
-    for (int i = 0, n = items->size(items); i < n; i++) {
-        void *element = items->get(items, i);
-        if (!other->contains(other, element)) {
-            out->add(out, element);
+    set *out;
+    if (lhs->ops->fill_copy) {
+        /* Copy self, then probe from whichever side is smaller. */
+        out = set_copy_with_room(self, 0);
+        if (!out) {
+            return NULL;
+        }
+        set_iterator it;
+        if (other->size(other) < self->size(self)) {
+            other->iter_begin(other, &it);
+            while (other->iter_next(other, &it)) {
+                out->remove(out, it.element);
+            }
+        } else {
+            out->iter_begin(out, &it);
+            while (out->iter_next(out, &it)) {
+                if (other->contains(other, it.element)) {
+                    out->iter_remove(out, &it);
+                }
+            }
         }
+        return out;
     }
 
-    items->free(items);
+    out = create_set_with_capacity(lhs->type, lhs->cmp, lhs->hash, self->size(self));
+    if (!out) {
+        return NULL;
+    }
+
+    set_iterator it;
+    self->iter_begin(self, &it);
+    while (self->iter_next(self, &it)) {
+        if (!other->contains(other, it.element)) {
+            out->add(out, it.element);
+        }
+    }
     return out;
 }
 
-static bool set_is_subset_of_method(const set *self, const set *other) {
+static ova_error_code set_union_into_method(set *self, const set *other) {
     set_impl *lhs = set_impl_from_public(self);
     set_impl *rhs = set_impl_from_public(other);
     if (!sets_are_compatible(lhs, rhs)) {
-        return false;
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (self == other) {
+        return OVA_SUCCESS;
     }
 
-    list *items = self->to_list(self);
-    if (!items) {
-        return false;
+    if (lhs->ops->combine) {
+        return lhs->ops->combine(lhs, rhs, SET_MERGE_UNION) ? OVA_SUCCESS : OVA_ERROR_MEMORY;
+    }
+
+    if (lhs->ops->reserve) {
+        lhs->ops->reserve(lhs, self->size(self) + other->size(other));
+    }
+    other->for_each(other, set_add_visitor, self);
+    return OVA_SUCCESS;
+}
+
+static ova_error_code set_intersect_into_method(set *self, const set *other) {
+    set_impl *lhs = set_impl_from_public(self);
+    set_impl *rhs = set_impl_from_public(other);
+    if (!sets_are_compatible(lhs, rhs)) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+    if (self == other) {
+        return OVA_SUCCESS;
+    }
+
+    if (lhs->ops->combine) {
+        return lhs->ops->combine(lhs, rhs, SET_MERGE_INTERSECTION) ? OVA_SUCCESS : OVA_ERROR_MEMORY;
     }
 
-    bool result = true;
-    for (int i = 0, n = items->size(items); i < n; i++) {
-        if (!other->contains(other, items->get(items, i))) {
-            result = false;
-            break;
+    set_iterator it;
+    self->iter_begin(self, &it);
+    while (self->iter_next(self, &it)) {
+        if (!other->contains(other, it.element)) {
+            self->iter_remove(self, &it);
         }
     }
+    return OVA_SUCCESS;
+}
+
+static bool set_is_subset_of_method(const set *self, const set *other) {
+    set_impl *lhs = set_impl_from_public(self);
+    set_impl *rhs = set_impl_from_public(other);
+    if (!sets_are_compatible(lhs, rhs)) {
+        return false;
+    }
 
-    items->free(items);
-    return result;
+    set_iterator it;
+    self->iter_begin(self, &it);
+    while (self->iter_next(self, &it)) {
+        if (!other->contains(other, it.element)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 static void set_free_method(set *self) {
@@ -304,60 +571,53 @@ static set *set_clone_shallow_method(const set *self) {
         return NULL;
     }
 
-    list *items = self->to_list(self);
-    if (!items) {
-        return NULL;
+    set *copy;
+    if (state->ops->fill_copy) {
+        copy = set_copy_with_room(self, 0);
+    } else if (state->ops->fill_sorted) {
+        copy = set_merge_method(self, NULL, SET_MERGE_UNION);
+    } else {
+        copy = create_set_with_capacity(state->type, state->cmp, state->hash, self->size(self));
+        if (copy) {
+            self->for_each(self, set_add_visitor, copy);
+        }
     }
-
-    int n = items->size(items);
-    set *copy = create_set_with_capacity(state->type, state->cmp, state->hash, n);
     if (!copy) {
-        items->free(items);
         return NULL;
     }
 
-    for (int i = 0; i < n; i++) {
-        copy->add(copy, items->get(items, i));
-    }
-
-    items->free(items);
     copy->user_data = self->user_data;
     return copy;
 }
 
 static set *set_clone_deep_method(const set *self, element_copier copier) {
-    if (!self || !copier) {
-        return NULL;
-    }
-
-    set_impl *state = set_impl_from_public(self);
+    set_impl *state = self ? set_impl_from_public(self) : NULL;
     if (!state) {
         return NULL;
     }
-
-    list *items = self->to_list(self);
-    if (!items) {
+    if (state->type == SET_BITMAP) {
+        return set_clone_shallow_method(self); // Elements are integers, not pointers to copy
+    }
+    if (!copier) {
         return NULL;
     }
 
-    int n = items->size(items);
-    set *copy = create_set_with_capacity(state->type, state->cmp, state->hash, n);
+    set *copy = create_set_with_capacity(state->type, state->cmp, state->hash, self->size(self));
     if (!copy) {
-        items->free(items);
         return NULL;
     }
 
-    for (int i = 0; i < n; i++) {
-        void *dup = copier(items->get(items, i));
+    set_iterator it;
+    self->iter_begin(self, &it);
+    while (self->iter_next(self, &it)) {
+        void *dup = copier(it.element);
         if (!dup) {
-            items->free(items);
             copy->free(copy);
             return NULL;
         }
         copy->add(copy, dup);
     }
 
-    items->free(items);
     copy->user_data = self->user_data;
     return copy;
 }
@@ -5,12 +5,30 @@
 
 typedef struct set_impl set_impl;
 
+typedef enum {
+    SET_MERGE_UNION,
+    SET_MERGE_INTERSECTION,
+    SET_MERGE_DIFFERENCE
+} set_merge_op;
+
 typedef struct set_ops {
     bool (*add)(set_impl *state, void *element);
     bool (*contains)(const set_impl *state, void *element);
     bool (*remove)(set_impl *state, void *element);
     int (*size)(const set_impl *state);
     list *(*to_list)(const set_impl *state);
+    void (*for_each)(const set_impl *state, set_visitor visit, void *ctx);
+    void (*iter_begin)(const set_impl *state, set_iterator *it);
+    bool (*iter_next)(const set_impl *state, set_iterator *it);
+    bool (*iter_remove)(set_impl *state, set_iterator *it);
+    /* Optional: presize for @p count elements in total. */
+    bool (*reserve)(set_impl *state, int count);
+    /* Optional bulk fills of an empty set; set algebra falls back to
+     * element-wise adds when a backend leaves them NULL. */
+    bool (*fill_sorted)(set_impl *state, void **elements, int count);
+    bool (*fill_copy)(set_impl *state, const set_impl *src, int extra);
+    /* Optional: apply @p op to @p state in place, word-parallel. */
+    bool (*combine)(set_impl *state, const set_impl *other, set_merge_op op);
     void (*destroy)(set_impl *state);
 } set_ops;
 
@@ -35,4 +53,7 @@ extern const set_ops hash_set_ops;
 void *tree_set_create_impl(comparator cmp);
 extern const set_ops tree_set_ops;
 
+void *bitmap_set_create_impl(int capacity);
+extern const set_ops bitmap_set_ops;
+
 #endif // SET_INTERNAL_H
@@ -1,6 +1,7 @@
 #include "set_internal.h"
 
 #include "../../include/tree.h"
+#include "../tree/tree_internal.h"
 
 #include <stdlib.h>
 
@@ -64,14 +65,29 @@ static int tree_set_size(const set_impl *state) {
     return (impl && impl->t) ? impl->t->size(impl->t) : 0;
 }
 
-static list *tree_set_to_list_out = NULL;
+static void tree_set_walk(const tree_impl *t, const tree_node *node, set_visitor visit, void *ctx) {
+    while (!tree_node_is_nil(t, node)) {
+        tree_set_walk(t, node->left, visit, ctx);
+        visit(node->key, ctx);
+        node = node->right;
+    }
+}
 
-static void tree_set_collect_cb(void *key, void *value) {
-    (void)value;
-    if (!tree_set_to_list_out) {
+static void tree_set_for_each(const set_impl *state, set_visitor visit, void *ctx) {
+    tree_set_impl *impl = tree_set_impl_from_state(state);
+    if (!impl || !impl->t || !visit) {
         return;
     }
-    tree_set_to_list_out->insert(tree_set_to_list_out, key, tree_set_to_list_out->size(tree_set_to_list_out));
+
+    const tree_impl *t = tree_impl_from_tree(impl->t);
+    if (t) {
+        tree_set_walk(t, t->root, visit, ctx);
+    }
+}
+
+static void tree_set_collect(void *element, void *ctx) {
+    list *out = (list *)ctx;
+    out->insert(out, element, out->size(out));
 }
 
 static list *tree_set_to_list(const set_impl *state) {
@@ -86,12 +102,57 @@ static list *tree_set_to_list(const set_impl *state) {
         return NULL;
     }
 
-    tree_set_to_list_out = out;
-    impl->t->in_order_traverse(impl->t, tree_set_collect_cb);
-    tree_set_to_list_out = NULL;
+    tree_set_for_each(state, tree_set_collect, out);
     return out;
 }
 
+/*
+ * The cursor remembers the last element returned and asks the tree for its
+ * successor, which works whether or not that element is still stored; that
+ * is what makes removal during iteration safe.
+ */
+static void tree_set_iter_begin(const set_impl *state, set_iterator *it) {
+    (void)state;
+    it->cursor.key = NULL;
+    it->cursor.entry = NULL;
+}
+
+static bool tree_set_iter_next(const set_impl *state, set_iterator *it) {
+    tree_set_impl *impl = tree_set_impl_from_state(state);
+    if (!impl || !impl->t) {
+        return false;
+    }
+
+    void *next = it->started ? impl->t->successor(impl->t, it->cursor.key) : impl->t->min(impl->t);
+    it->started = true;
+    it->cursor.entry = next;
+    if (!next) {
+        return false;
+    }
+    it->cursor.key = next;
+    it->element = next;
+    return true;
+}
+
+static bool tree_set_iter_remove(set_impl *state, set_iterator *it) {
+    tree_set_impl *impl = tree_set_impl_from_state(state);
+    if (!impl || !impl->t || !it->cursor.entry) {
+        return false;
+    }
+
+    it->cursor.entry = NULL;
+    return impl->t->delete(impl->t, it->cursor.key) == OVA_SUCCESS;
+}
+
+/* @p elements are distinct and ascending, as produced by an in-order walk. */
+static bool tree_set_fill_sorted(set_impl *state, void **elements, int count) {
+    tree_set_impl *impl = tree_set_impl_from_state(state);
+    if (!impl || !impl->t || count < 0) {
+        return false;
+    }
+    return tree_build_sorted(tree_impl_from_tree(impl->t), elements, NULL, (size_t)count) == OVA_SUCCESS;
+}
+
 static void tree_set_destroy(set_impl *state) {
     if (!state) {
         return;
@@ -134,5 +195,13 @@ const set_ops tree_set_ops = {
     .remove = tree_set_remove,
     .size = tree_set_size,
     .to_list = tree_set_to_list,
+    .for_each = tree_set_for_each,
+    .iter_begin = tree_set_iter_begin,
+    .iter_next = tree_set_iter_next,
+    .iter_remove = tree_set_iter_remove,
+    .reserve = NULL,
+    .fill_sorted = tree_set_fill_sorted,
+    .fill_copy = NULL,
+    .combine = NULL,
     .destroy = tree_set_destroy,
 };
@@ -1,9 +1,42 @@
 #include "../../include/sort.h"
+#include "../list/array_list.h"
+#include "../list/linked_list.h"
+#include <pthread.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+/* Upper bound on the worker threads one parallel sort may use. */
+#define PARALLEL_SORT_MAX_THREADS 256
+/* Below this many elements a sort or merge task stays on its own thread. */
+#define PARALLEL_SORT_MIN_TASK 16384
+
+/* Keys a batched binary search advances together to overlap cache misses. */
+#define SEARCH_BATCH_LANES 16
+
+#if defined(__GNUC__) || defined(__clang__)
+#define sort_prefetch(addr) __builtin_prefetch(addr)
+#else
+#define sort_prefetch(addr) ((void)(addr))
+#endif
+
+/* Below this many elements the radix sorters defer to the comparator. */
+#define RADIX_SORT_MIN_ELEMENTS 64
+/* LSD radix digit width; 11 bits covers a 64-bit key in six passes. */
+#define RADIX_DIGIT_BITS 11u
+#define RADIX_BUCKETS ((size_t)1 << RADIX_DIGIT_BITS)
+#define RADIX_DIGITS ((64u + RADIX_DIGIT_BITS - 1) / RADIX_DIGIT_BITS)
+/* MSD string buckets smaller than this finish with insertion sort. */
+#define RADIX_STRING_CUTOFF 32
 
 typedef struct sorter_impl {
     comparator cmp;
+    int threads; /* worker threads for the parallel sorter; 1 elsewhere */
+    sort_key_u64 key_u64;       /* radix sorter key, or NULL */
+    sort_key_string key_string; /* string radix sorter key, or NULL */
+    void **merge_buf;           /* TimSort merge buffer kept between calls */
+    size_t merge_cap;
 } sorter_impl;
 
 static sorter_impl *sorter_impl_from_self(const sorter *self) {
@@ -15,39 +48,94 @@ static void sorter_free(sorter *self) {
         return;
     }
 
-    free(self->impl);
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (impl) {
+        free(impl->merge_buf);
+    }
+    free(impl);
     self->impl = NULL;
     free(self);
 }
 
 /**
- * @brief Snapshot a list into a freshly allocated pointer array.
+ * @brief Replace the contents of @p lst with @p arr in O(n).
  *
- * Returns NULL on allocation failure or empty list. Caller must free.
+ * Both array_list and linked_list provide O(1) append at the tail,
+ * so a clear-and-bulk-append is linear in the number of elements.
  */
-static void **list_snapshot(list *lst, int *out_size) {
-    int n = lst->size(lst);
-    *out_size = n;
-    if (n <= 0) return NULL;
-    void **arr = malloc((size_t)n * sizeof(void *));
-    if (!arr) return NULL;
+static void list_replace_with(list *lst, void **arr, int n) {
+    /* The items of an inline-value list point into its own storage, so copy
+     * the values out before clearing it. */
+    size_t width = lst->_element_size;
+    unsigned char *values = NULL;
+    if (width > 0) {
+        values = malloc((size_t)n * width);
+        if (!values) return;
+        for (int i = 0; i < n; i++) {
+            memcpy(values + (size_t)i * width, arr[i], width);
+        }
+    }
+    lst->clear(lst);
     for (int i = 0; i < n; i++) {
-        arr[i] = lst->get(lst, i);
+        lst->insert(lst, values ? values + (size_t)i * width : arr[i], i);
     }
-    return arr;
+    free(values);
 }
 
 /**
- * @brief Replace the contents of @p lst with @p arr in O(n).
+ * @brief Pointer array that sort, shuffle and reverse permute.
  *
- * Both array_list and linked_list provide O(1) append at the tail,
- * so a clear-and-bulk-append is linear in the number of elements.
+ * For an array list this is the list's own buffer, permuted in place with
+ * no copy. Any other list is snapshotted into a temporary array that
+ * list_view_close() writes back. A linked list keeps its nodes and only has
+ * their payloads reassigned; sorting by relinking the nodes instead chases
+ * pointers across the heap and measured several times slower.
  */
-static void list_replace_with(list *lst, void **arr, int n) {
-    lst->clear(lst);
-    for (int i = 0; i < n; i++) {
-        lst->insert(lst, arr[i], i);
+typedef struct {
+    void **items;
+    int size;
+    bool borrowed;
+} list_view;
+
+/**
+ * @brief Open a view over @p lst.
+ *
+ * Returns false, with nothing to close, when the list has fewer than two
+ * items or the snapshot cannot be allocated.
+ */
+static bool list_view_open(list *lst, list_view *view) {
+    view->size = lst->size(lst);
+    view->items = NULL;
+    view->borrowed = false;
+    if (view->size < 2) return false;
+
+    void **data = array_list_data(lst);
+    if (data) {
+        view->items = data;
+        view->borrowed = true;
+        return true;
+    }
+
+    view->items = malloc((size_t)view->size * sizeof(void *));
+    if (!view->items) return false;
+    for (int i = 0; i < view->size; i++) {
+        view->items[i] = lst->get(lst, i);
     }
+    return true;
+}
+
+/**
+ * @brief Release a view, first writing a snapshot back when @p changed.
+ *
+ * Linked lists get their payloads reassigned node by node; other lists are
+ * cleared and refilled.
+ */
+static void list_view_close(list *lst, list_view *view, bool changed) {
+    if (view->borrowed) return;
+    if (changed && !linked_list_assign(lst, view->items, view->size)) {
+        list_replace_with(lst, view->items, view->size);
+    }
+    free(view->items);
 }
 
 /**
@@ -56,7 +144,7 @@ static void list_replace_with(list *lst, void **arr, int n) {
  * Public swap helper preserved for backwards compatibility. It dispatches
  * through the list's own get/remove/insert API and therefore costs O(n)
  * for array-backed lists. Internal sort/shuffle/reverse routines avoid it
- * by operating on a snapshot pointer buffer with true O(1) swaps.
+ * by operating on a list_view pointer buffer with true O(1) swaps.
  *
  * @param self A pointer to the sorter structure.
  * @param lst A pointer to the list structure.
@@ -68,6 +156,18 @@ void sorter_swap(sorter *self, list *lst, int index1, int index2) {
     if (index1 == index2) return;
     void *temp1 = lst->get(lst, index1);
     void *temp2 = lst->get(lst, index2);
+    if (lst->_element_size > 0) {
+        /* Inline values: swap the bytes where they sit. */
+        if (!temp1 || !temp2) return;
+        unsigned char *a = temp1;
+        unsigned char *b = temp2;
+        for (size_t k = 0; k < lst->_element_size; k++) {
+            unsigned char t = a[k];
+            a[k] = b[k];
+            b[k] = t;
+        }
+        return;
+    }
 
     lst->remove(lst, index1);
     lst->insert(lst, temp2, index1);
@@ -81,234 +181,1423 @@ static inline void buffer_swap(void **arr, int i, int j) {
     arr[j] = t;
 }
 
-/**
- * @brief Partitions a contiguous pointer buffer for quicksort.
- *
- * Uses Lomuto partitioning with O(1) swaps over the raw buffer instead of
- * dispatching through the list interface. This keeps quicksort at the
- * advertised O(n log n) average even for array-backed lists, where the
- * old per-swap remove+insert path made the algorithm O(n^3).
- */
-static int buffer_partition(void **arr, int low, int high, comparator cmp) {
-    void *pivot = arr[high];
-    int i = low - 1;
+/*
+ * Pattern-defeating quicksort (pdqsort) over a contiguous pointer buffer.
+ *
+ * Median-of-three pivots (ninther above PDQ_NINTHER_THRESHOLD), an insertion
+ * sort cutoff, block partitioning that records comparison results in offset
+ * buffers instead of branching on them, a fast path that sweeps runs of keys
+ * equal to the previous pivot, detection of already-partitioned ranges, and
+ * a heapsort fallback once too many unbalanced partitions were seen keep the
+ * worst case at O(n log n).
+ */
+#define PDQ_INSERTION_SORT_THRESHOLD 24
+#define PDQ_NINTHER_THRESHOLD 128
+#define PDQ_PARTIAL_INSERTION_SORT_LIMIT 8
+#define PDQ_BLOCK_SIZE 64
+
+static inline void ptr_swap(void **a, void **b) {
+    void *t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static void pdq_insertion_sort(void **begin, void **end, comparator cmp) {
+    if (begin == end) return;
+    for (void **cur = begin + 1; cur != end; ++cur) {
+        void **sift = cur;
+        void **sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0) {
+            void *tmp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+
+/* Insertion sort that relies on *(begin - 1) not exceeding any element. */
+static void pdq_unguarded_insertion_sort(void **begin, void **end, comparator cmp) {
+    if (begin == end) return;
+    for (void **cur = begin + 1; cur != end; ++cur) {
+        void **sift = cur;
+        void **sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0) {
+            void *tmp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+
+/* Insertion sort that gives up once it has moved too many elements. */
+static bool pdq_partial_insertion_sort(void **begin, void **end, comparator cmp) {
+    if (begin == end) return true;
+    size_t moved = 0;
+    for (void **cur = begin + 1; cur != end; ++cur) {
+        void **sift = cur;
+        void **sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0) {
+            void *tmp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+            moved += (size_t)(cur - sift);
+        }
+        if (moved > PDQ_PARTIAL_INSERTION_SORT_LIMIT) return false;
+    }
+    return true;
+}
+
+static inline void pdq_sort2(void **a, void **b, comparator cmp) {
+    if (cmp(*b, *a) < 0) ptr_swap(a, b);
+}
+
+static inline void pdq_sort3(void **a, void **b, void **c, comparator cmp) {
+    pdq_sort2(a, b, cmp);
+    pdq_sort2(b, c, cmp);
+    pdq_sort2(a, b, cmp);
+}
+
+static void pdq_sift_down(void **arr, size_t root, size_t n, comparator cmp) {
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= n) return;
+        if (child + 1 < n && cmp(arr[child], arr[child + 1]) < 0) child++;
+        if (cmp(arr[root], arr[child]) >= 0) return;
+        ptr_swap(&arr[root], &arr[child]);
+        root = child;
+    }
+}
+
+static void pdq_heapsort(void **begin, void **end, comparator cmp) {
+    size_t n = (size_t)(end - begin);
+    for (size_t i = n / 2; i-- > 0;) {
+        pdq_sift_down(begin, i, n, cmp);
+    }
+    for (size_t i = n; i-- > 1;) {
+        ptr_swap(&begin[0], &begin[i]);
+        pdq_sift_down(begin, 0, i, cmp);
+    }
+}
+
+/*
+ * Exchange @p num misplaced pairs named by the offset buffers. When the
+ * counts differ the pairs are rotated through one temporary, which moves
+ * each element once instead of twice.
+ */
+static void pdq_swap_offsets(void **first, void **last, const unsigned char *offsets_l,
+                             const unsigned char *offsets_r, size_t num, bool use_swaps) {
+    if (use_swaps) {
+        for (size_t i = 0; i < num; ++i) {
+            ptr_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+    } else if (num > 0) {
+        void **l = first + offsets_l[0];
+        void **r = last - offsets_r[0];
+        void *tmp = *l;
+        *l = *r;
+        for (size_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = *l;
+            r = last - offsets_r[i];
+            *l = *r;
+        }
+        *r = tmp;
+    }
+}
+
+/*
+ * Partition the unscanned range [*first_io, *last_io) around @p pivot.
+ * Blocks of PDQ_BLOCK_SIZE elements from each end are scanned first, storing
+ * the offsets of misplaced elements without a data-dependent branch, and the
+ * recorded pairs are then swapped in bulk. On return *first_io is one past
+ * the last element smaller than the pivot.
+ */
+static void pdq_partition_blocks(void ***first_io, void ***last_io, void *pivot, comparator cmp) {
+    void **first = *first_io;
+    void **last = *last_io;
+
+    unsigned char offsets_l[PDQ_BLOCK_SIZE];
+    unsigned char offsets_r[PDQ_BLOCK_SIZE];
+    size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (last - first > 2 * PDQ_BLOCK_SIZE) {
+        if (num_l == 0) {
+            start_l = 0;
+            void **it = first;
+            for (unsigned char i = 0; i < PDQ_BLOCK_SIZE;) {
+                offsets_l[num_l] = i++;
+                num_l += !(cmp(*it, pivot) < 0);
+                ++it;
+            }
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            void **it = last;
+            for (unsigned char i = 0; i < PDQ_BLOCK_SIZE;) {
+                offsets_r[num_r] = ++i;
+                num_r += cmp(*--it, pivot) < 0;
+            }
+        }
+
+        size_t num = num_l < num_r ? num_l : num_r;
+        pdq_swap_offsets(first, last, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) first += PDQ_BLOCK_SIZE;
+        if (num_r == 0) last -= PDQ_BLOCK_SIZE;
+    }
+
+    /* Fewer than two blocks remain; split what is unscanned between the ends. */
+    size_t l_size = 0, r_size = 0;
+    size_t unknown = (size_t)(last - first) - ((num_r || num_l) ? PDQ_BLOCK_SIZE : 0);
+    if (num_r) {
+        l_size = unknown;
+        r_size = PDQ_BLOCK_SIZE;
+    } else if (num_l) {
+        l_size = PDQ_BLOCK_SIZE;
+        r_size = unknown;
+    } else {
+        l_size = unknown / 2;
+        r_size = unknown - l_size;
+    }
+
+    if (unknown && !num_l) {
+        start_l = 0;
+        void **it = first;
+        for (unsigned char i = 0; i < l_size;) {
+            offsets_l[num_l] = i++;
+            num_l += !(cmp(*it, pivot) < 0);
+            ++it;
+        }
+    }
+    if (unknown && !num_r) {
+        start_r = 0;
+        void **it = last;
+        for (unsigned char i = 0; i < r_size;) {
+            offsets_r[num_r] = ++i;
+            num_r += cmp(*--it, pivot) < 0;
+        }
+    }
+
+    size_t num = num_l < num_r ? num_l : num_r;
+    pdq_swap_offsets(first, last, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+    num_l -= num;
+    num_r -= num;
+    start_l += num;
+    start_r += num;
+    if (num_l == 0) first += l_size;
+    if (num_r == 0) last -= r_size;
+
+    /* One side may still hold misplaced elements; move them across. */
+    if (num_l) {
+        while (num_l--) {
+            ptr_swap(first + offsets_l[start_l + num_l], --last);
+        }
+        first = last;
+    }
+    if (num_r) {
+        while (num_r--) {
+            ptr_swap(last - offsets_r[start_r + num_r], first);
+            ++first;
+        }
+        last = first;
+    }
+    *first_io = first;
+    *last_io = last;
+}
+
+/*
+ * Partition [begin, end) around *begin: smaller elements go left, the rest
+ * right. Reports through @p already_partitioned whether no element had to
+ * move, which hints that the range may already be sorted.
+ */
+static void **pdq_partition_right(void **begin, void **end, comparator cmp, bool *already_partitioned) {
+    void *pivot = *begin;
+    void **first = begin;
+    void **last = end;
+
+    while (cmp(*++first, pivot) < 0) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !(cmp(*--last, pivot) < 0)) {
+        }
+    } else {
+        while (!(cmp(*--last, pivot) < 0)) {
+        }
+    }
+
+    *already_partitioned = first >= last;
+    if (!*already_partitioned) {
+        ptr_swap(first, last);
+        ++first;
+        pdq_partition_blocks(&first, &last, pivot, cmp);
+    }
+
+    void **pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+/*
+ * Partition [begin, end) around *begin with equal elements on the left.
+ * Used when the pivot equals the element before the range, so every key
+ * equal to it is already in its final place and can be skipped.
+ */
+static void **pdq_partition_left(void **begin, void **end, comparator cmp) {
+    void *pivot = *begin;
+    void **first = begin;
+    void **last = end;
+
+    while (cmp(pivot, *--last) < 0) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !(cmp(pivot, *++first) < 0)) {
+        }
+    } else {
+        while (!(cmp(pivot, *++first) < 0)) {
+        }
+    }
+
+    while (first < last) {
+        ptr_swap(first, last);
+        while (cmp(pivot, *--last) < 0) {
+        }
+        while (!(cmp(pivot, *++first) < 0)) {
+        }
+    }
+
+    void **pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+/*
+ * Move the pivot to *begin: median of three, or Tukey's ninther on large
+ * ranges, with the samples left in guarding positions at both ends.
+ */
+static void pdq_choose_pivot(void **begin, void **end, comparator cmp) {
+    size_t size = (size_t)(end - begin);
+    size_t s2 = size / 2;
+    if (size > PDQ_NINTHER_THRESHOLD) {
+        pdq_sort3(begin, begin + s2, end - 1, cmp);
+        pdq_sort3(begin + 1, begin + (s2 - 1), end - 2, cmp);
+        pdq_sort3(begin + 2, begin + (s2 + 1), end - 3, cmp);
+        pdq_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), cmp);
+        ptr_swap(begin, begin + s2);
+    } else {
+        pdq_sort3(begin + s2, begin, end - 1, cmp);
+    }
+}
+
+/* After an unbalanced partition, shuffle a few elements on each side. */
+static void pdq_break_patterns(void **begin, void **pivot_pos, void **end) {
+    size_t l_size = (size_t)(pivot_pos - begin);
+    size_t r_size = (size_t)(end - (pivot_pos + 1));
+    if (l_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+        ptr_swap(begin, begin + l_size / 4);
+        ptr_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > PDQ_NINTHER_THRESHOLD) {
+            ptr_swap(begin + 1, begin + (l_size / 4 + 1));
+            ptr_swap(begin + 2, begin + (l_size / 4 + 2));
+            ptr_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+            ptr_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+    }
+    if (r_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+        ptr_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        ptr_swap(end - 1, end - r_size / 4);
+        if (r_size > PDQ_NINTHER_THRESHOLD) {
+            ptr_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+            ptr_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+            ptr_swap(end - 2, end - (1 + r_size / 4));
+            ptr_swap(end - 3, end - (2 + r_size / 4));
+        }
+    }
+}
+
+static void pdq_loop(void **begin, void **end, comparator cmp, int bad_allowed, bool leftmost) {
+    for (;;) {
+        size_t size = (size_t)(end - begin);
+        if (size < PDQ_INSERTION_SORT_THRESHOLD) {
+            if (leftmost) {
+                pdq_insertion_sort(begin, end, cmp);
+            } else {
+                pdq_unguarded_insertion_sort(begin, end, cmp);
+            }
+            return;
+        }
+
+        pdq_choose_pivot(begin, end, cmp);
+
+        /* Pivot equal to the previous pivot: sweep its duplicates in one pass. */
+        if (!leftmost && !(cmp(*(begin - 1), *begin) < 0)) {
+            begin = pdq_partition_left(begin, end, cmp) + 1;
+            continue;
+        }
+
+        bool already_partitioned = false;
+        void **pivot_pos = pdq_partition_right(begin, end, cmp, &already_partitioned);
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = (size_t)(end - (pivot_pos + 1));
+
+        if (l_size < size / 8 || r_size < size / 8) {
+            if (--bad_allowed == 0) {
+                pdq_heapsort(begin, end, cmp);
+                return;
+            }
+            /* Break up patterns that keep producing bad pivots. */
+            pdq_break_patterns(begin, pivot_pos, end);
+        } else if (already_partitioned && pdq_partial_insertion_sort(begin, pivot_pos, cmp) &&
+                   pdq_partial_insertion_sort(pivot_pos + 1, end, cmp)) {
+            /* The partition moved nothing and both sides are nearly sorted. */
+            return;
+        }
+
+        /* Recurse into the left side and loop on the right. */
+        pdq_loop(begin, pivot_pos, cmp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+/**
+ * @brief Sort @p n pointers in place with pdqsort.
+ */
+static void pdq_sort(void **arr, size_t n, comparator cmp) {
+    int log2n = 0;
+    for (size_t m = n; m > 1; m >>= 1) {
+        log2n++;
+    }
+    pdq_loop(arr, arr + n, cmp, log2n, true);
+}
+
+/**
+ * @brief Sorts a list using pattern-defeating quicksort over a list_view.
+ *
+ * An array list's buffer is sorted in place with pdq_sort(); other lists go
+ * through a snapshot that is written back in O(n). Sorted, reversed and many-duplicate inputs run in linear or O(n log n)
+ * time, and the heapsort fallback bounds every input at O(n log n).
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst A pointer to the list to be sorted.
+ */
+static void sorter_quick(sorter *self, list *lst) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp) return;
+
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
+
+    pdq_sort(view.items, (size_t)view.size, impl->cmp);
+
+    list_view_close(lst, &view, true);
+}
+
+/**
+ * @brief Merges two sorted sub-arrays within a temporary buffer.
+ *
+ * @param arr  Array of payload pointers.
+ * @param tmp  Temporary buffer for merging.
+ * @param low  Start index of the first half.
+ * @param mid  End index of the first half (exclusive start of second half).
+ * @param high End index of the range (exclusive).
+ * @param cmp  Comparator function.
+ */
+static void merge(void **arr, void **tmp, int low, int mid, int high,
+                  comparator cmp) {
+    memcpy(tmp + low, arr + low, (size_t)(high - low) * sizeof(void *));
+
+    int i = low;
+    int j = mid;
+    int k = low;
+
+    while (i < mid && j < high) {
+        if (cmp(tmp[i], tmp[j]) <= 0) {
+            arr[k++] = tmp[i++];
+        } else {
+            arr[k++] = tmp[j++];
+        }
+    }
+    while (i < mid) {
+        arr[k++] = tmp[i++];
+    }
+    while (j < high) {
+        arr[k++] = tmp[j++];
+    }
+}
+
+/**
+ * @brief Recursively sorts a sub-array using cache-oblivious merge sort.
+ *
+ * The recursive halving naturally creates sub-problems that fit into each
+ * level of the cache hierarchy without requiring any tuning parameters.
+ *
+ * @param arr  Array of payload pointers.
+ * @param tmp  Temporary buffer for merging.
+ * @param low  Start index (inclusive).
+ * @param high End index (exclusive).
+ * @param cmp  Comparator function.
+ */
+static void merge_sort_recursive(void **arr, void **tmp, int low, int high,
+                                 comparator cmp) {
+    if (high - low < 2) {
+        return;
+    }
+    int mid = low + (high - low) / 2;
+    merge_sort_recursive(arr, tmp, low, mid, cmp);
+    merge_sort_recursive(arr, tmp, mid, high, cmp);
+    merge(arr, tmp, low, mid, high, cmp);
+}
+
+/**
+ * @brief Sorts a list using cache-oblivious merge sort.
+ *
+ * An array list's buffer is sorted in place, other lists through a
+ * contiguous snapshot, using a recursive merge sort (which naturally adapts
+ * to all cache levels).  This guarantees O(n log n) worst-case time
+ * complexity.
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst  A pointer to the list to be sorted.
+ */
+static void sorter_merge(sorter *self, list *lst) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp) return;
+
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
+
+    void **tmp = malloc((size_t)view.size * sizeof(void *));
+    if (!tmp) {
+        list_view_close(lst, &view, false);
+        return;
+    }
+
+    merge_sort_recursive(view.items, tmp, 0, view.size, impl->cmp);
+
+    list_view_close(lst, &view, true);
+    free(tmp);
+}
+
+/**
+ * @brief Run @p left on a new thread and @p right on this one, then join.
+ *
+ * Falls back to running both inline when no thread can be started, so the
+ * result never depends on thread availability.
+ */
+static void parallel_fork(void *(*task)(void *), void *left, void *right) {
+    pthread_t tid;
+    int spawned = pthread_create(&tid, NULL, task, left) == 0;
+    if (!spawned) {
+        task(left);
+    }
+    task(right);
+    if (spawned) {
+        pthread_join(tid, NULL);
+    }
+}
+
+/**
+ * @brief Merge src[a_low, a_high) and src[b_low, b_high) into @p out.
+ *
+ * Ties take the element from the first run, keeping the sort stable.
+ */
+static void merge_runs(void **src, int a_low, int a_high, int b_low, int b_high,
+                       void **out, comparator cmp) {
+    int k = 0;
+    while (a_low < a_high && b_low < b_high) {
+        if (cmp(src[a_low], src[b_low]) <= 0) {
+            out[k++] = src[a_low++];
+        } else {
+            out[k++] = src[b_low++];
+        }
+    }
+    while (a_low < a_high) {
+        out[k++] = src[a_low++];
+    }
+    while (b_low < b_high) {
+        out[k++] = src[b_low++];
+    }
+}
+
+/* First index in [low, high) whose element is not less than @p key. */
+static int lower_bound(void **arr, int low, int high, void *key, comparator cmp) {
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (cmp(arr[mid], key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* First index in [low, high) whose element is greater than @p key. */
+static int upper_bound(void **arr, int low, int high, void *key, comparator cmp) {
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (cmp(arr[mid], key) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+typedef struct {
+    void **src;
+    int a_low, a_high;
+    int b_low, b_high;
+    void **out;
+    int threads;
+    comparator cmp;
+} parallel_merge_task;
+
+/**
+ * @brief Merge two sorted runs with up to @p threads threads.
+ *
+ * The middle element of the longer run is placed directly at its final
+ * position, found by binary search in the other run, and the two halves on
+ * either side of it are merged independently. Equal keys keep their run
+ * order, so the result matches the sequential merge exactly.
+ */
+static void *parallel_merge_run(void *arg) {
+    parallel_merge_task *t = (parallel_merge_task *)arg;
+    int na = t->a_high - t->a_low;
+    int nb = t->b_high - t->b_low;
+    if (t->threads < 2 || na + nb < PARALLEL_SORT_MIN_TASK) {
+        merge_runs(t->src, t->a_low, t->a_high, t->b_low, t->b_high, t->out, t->cmp);
+        return NULL;
+    }
+
+    int a_split, b_split, k;
+    parallel_merge_task left = *t;
+    parallel_merge_task right = *t;
+    if (na >= nb) {
+        int a_mid = t->a_low + na / 2;
+        b_split = lower_bound(t->src, t->b_low, t->b_high, t->src[a_mid], t->cmp);
+        k = (a_mid - t->a_low) + (b_split - t->b_low);
+        t->out[k] = t->src[a_mid];
+        a_split = a_mid;
+        right.a_low = a_mid + 1;
+        right.b_low = b_split;
+    } else {
+        int b_mid = t->b_low + nb / 2;
+        a_split = upper_bound(t->src, t->a_low, t->a_high, t->src[b_mid], t->cmp);
+        k = (a_split - t->a_low) + (b_mid - t->b_low);
+        t->out[k] = t->src[b_mid];
+        b_split = b_mid;
+        right.a_low = a_split;
+        right.b_low = b_mid + 1;
+    }
+    left.a_high = a_split;
+    left.b_high = b_split;
+    left.threads = t->threads / 2;
+    right.out = t->out + k + 1;
+    right.threads = t->threads - left.threads;
+
+    parallel_fork(parallel_merge_run, &left, &right);
+    return NULL;
+}
+
+typedef struct {
+    void **arr;
+    void **tmp;
+    int low;
+    int high;
+    int threads;
+    comparator cmp;
+} parallel_sort_task;
+
+/**
+ * @brief Sort arr[low, high) with up to @p threads threads.
+ *
+ * Splits the range in half and the thread budget with it, sorts both halves
+ * concurrently, then merges them in parallel. Each leaf task runs the
+ * sequential merge sort, so the output is identical to sorter_merge().
+ */
+static void *parallel_sort_run(void *arg) {
+    parallel_sort_task *t = (parallel_sort_task *)arg;
+    if (t->threads < 2 || t->high - t->low < 2 * PARALLEL_SORT_MIN_TASK) {
+        merge_sort_recursive(t->arr, t->tmp, t->low, t->high, t->cmp);
+        return NULL;
+    }
+
+    int mid = t->low + (t->high - t->low) / 2;
+    parallel_sort_task left = {t->arr, t->tmp, t->low, mid, t->threads / 2, t->cmp};
+    parallel_sort_task right = {t->arr, t->tmp, mid, t->high, t->threads - t->threads / 2, t->cmp};
+    parallel_fork(parallel_sort_run, &left, &right);
+
+    memcpy(t->tmp + t->low, t->arr + t->low, (size_t)(t->high - t->low) * sizeof(void *));
+    parallel_merge_task merge_task = {t->tmp, t->low, mid, mid, t->high, t->arr + t->low, t->threads, t->cmp};
+    parallel_merge_run(&merge_task);
+    return NULL;
+}
+
+/**
+ * @brief Sorts a list using merge sort spread over the sorter's threads.
+ *
+ * Opens a list_view like sorter_merge() and sorts it with
+ * parallel_sort_run(); only a snapshot needs writing back.
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst  A pointer to the list to be sorted.
+ */
+static void sorter_parallel(sorter *self, list *lst) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp) return;
+
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
+
+    void **tmp = malloc((size_t)view.size * sizeof(void *));
+    if (!tmp) {
+        list_view_close(lst, &view, false);
+        return;
+    }
+
+    parallel_sort_task task = {view.items, tmp, 0, view.size, impl->threads, impl->cmp};
+    parallel_sort_run(&task);
+
+    list_view_close(lst, &view, true);
+    free(tmp);
+}
+
+typedef struct {
+    uint64_t key;
+    void *item;
+} radix_u64_entry;
+
+/**
+ * @brief Stable LSD radix sort of @p a by key, RADIX_DIGIT_BITS per pass.
+ *
+ * All digit histograms are built in a single read, and a pass whose digit is
+ * the same for every key is skipped, so 32-bit keys cost three scatter
+ * passes and narrower ranges fewer still. Returns whichever of @p a and
+ * @p aux holds the result, or NULL when the histograms cannot be allocated.
+ */
+static radix_u64_entry *radix_sort_u64(radix_u64_entry *a, radix_u64_entry *aux, size_t n) {
+    size_t *counts = calloc(RADIX_DIGITS * RADIX_BUCKETS, sizeof(size_t));
+    if (!counts) return NULL;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t k = a[i].key;
+        for (unsigned d = 0; d < RADIX_DIGITS; d++) {
+            counts[d * RADIX_BUCKETS + ((k >> (d * RADIX_DIGIT_BITS)) & (RADIX_BUCKETS - 1))]++;
+        }
+    }
+
+    for (unsigned d = 0; d < RADIX_DIGITS; d++) {
+        size_t *count = counts + d * RADIX_BUCKETS;
+        unsigned shift = d * RADIX_DIGIT_BITS;
+        if (count[(a[0].key >> shift) & (RADIX_BUCKETS - 1)] == n) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t b = 0; b < RADIX_BUCKETS; b++) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            aux[count[(a[i].key >> shift) & (RADIX_BUCKETS - 1)]++] = a[i];
+        }
+        radix_u64_entry *t = a;
+        a = aux;
+        aux = t;
+    }
+    free(counts);
+    return a;
+}
+
+/**
+ * @brief Sorts a list by its integer keys with LSD radix sort.
+ *
+ * Each key is extracted once into a (key, item) buffer, so sorting makes no
+ * comparator calls and runs in linear time. Lists shorter than
+ * RADIX_SORT_MIN_ELEMENTS go through pdqsort with the sorter's comparator
+ * when one was supplied.
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst A pointer to the list to be sorted.
+ */
+static void sorter_radix_u64(sorter *self, list *lst) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->key_u64) return;
+
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
+
+    void **arr = view.items;
+    size_t n = (size_t)view.size;
+    radix_u64_entry *entries = NULL;
+    radix_u64_entry *aux = NULL;
+    if (n < RADIX_SORT_MIN_ELEMENTS && impl->cmp) {
+        pdq_sort(arr, n, impl->cmp);
+    } else {
+        entries = malloc(n * sizeof(radix_u64_entry));
+        aux = malloc(n * sizeof(radix_u64_entry));
+        if (!entries || !aux) {
+            free(entries);
+            free(aux);
+            list_view_close(lst, &view, false);
+            return;
+        }
+        for (size_t i = 0; i < n; i++) {
+            entries[i].key = impl->key_u64(arr[i]);
+            entries[i].item = arr[i];
+        }
+        radix_u64_entry *sorted = radix_sort_u64(entries, aux, n);
+        if (!sorted) {
+            free(entries);
+            free(aux);
+            list_view_close(lst, &view, false);
+            return;
+        }
+        for (size_t i = 0; i < n; i++) {
+            arr[i] = sorted[i].item;
+        }
+    }
+
+    list_view_close(lst, &view, true);
+    free(entries);
+    free(aux);
+}
+
+typedef struct {
+    const unsigned char *key;
+    void *item;
+} radix_string_entry;
+
+typedef struct {
+    size_t low;
+    size_t n;
+    size_t depth;
+} radix_string_range;
+
+/* Stable insertion sort of a bucket whose keys agree on the first @p depth bytes. */
+static void radix_string_insertion(radix_string_entry *a, size_t n, size_t depth) {
+    for (size_t i = 1; i < n; i++) {
+        radix_string_entry cur = a[i];
+        size_t j = i;
+        while (j > 0 && strcmp((const char *)a[j - 1].key + depth, (const char *)cur.key + depth) > 0) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = cur;
+    }
+}
+
+/**
+ * @brief Stable MSD radix sort of @p a by key bytes.
+ *
+ * Each range is distributed on the byte at its depth, with strings that end
+ * there kept first in their own finished bucket. Pending buckets live on a
+ * heap stack rather than the call stack, so long shared prefixes cannot
+ * overflow it, and a range that lands entirely in one bucket just advances
+ * its depth.
+ *
+ * @return false on allocation failure, leaving @p a a permutation of its input.
+ */
+static bool radix_sort_strings(radix_string_entry *a, radix_string_entry *aux, size_t n) {
+    size_t cap = 64;
+    size_t top = 0;
+    radix_string_range *stack = malloc(cap * sizeof(radix_string_range));
+    if (!stack) return false;
+    stack[top++] = (radix_string_range){0, n, 0};
+
+    while (top > 0) {
+        radix_string_range r = stack[--top];
+        radix_string_entry *part = a + r.low;
+        if (r.n < RADIX_STRING_CUTOFF) {
+            radix_string_insertion(part, r.n, r.depth);
+            continue;
+        }
+
+        size_t count[257];
+        memset(count, 0, sizeof(count));
+        for (size_t i = 0; i < r.n; i++) {
+            count[part[i].key[r.depth]]++;
+        }
+        if (count[0] == r.n) {
+            continue;
+        }
+        unsigned only = part[0].key[r.depth];
+        if (count[only] == r.n) {
+            stack[top++] = (radix_string_range){r.low, r.n, r.depth + 1};
+            continue;
+        }
+
+        size_t offset = 0;
+        for (unsigned d = 0; d < 256; d++) {
+            size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        count[256] = offset;
+        for (size_t i = 0; i < r.n; i++) {
+            aux[count[part[i].key[r.depth]]++] = part[i];
+        }
+        memcpy(part, aux, r.n * sizeof(radix_string_entry));
+
+        /* count[d] is now the end of bucket d; bucket 0 holds finished keys. */
+        for (unsigned d = 1; d < 256; d++) {
+            size_t end = count[d];
+            size_t start = count[d - 1];
+            if (end - start < 2) {
+                continue;
+            }
+            if (top == cap) {
+                radix_string_range *grown = realloc(stack, 2 * cap * sizeof(radix_string_range));
+                if (!grown) {
+                    free(stack);
+                    return false;
+                }
+                stack = grown;
+                cap *= 2;
+            }
+            stack[top++] = (radix_string_range){r.low + start, end - start, r.depth + 1};
+        }
+    }
+
+    free(stack);
+    return true;
+}
+
+/**
+ * @brief Sorts a list by its string keys with MSD radix sort.
+ *
+ * Keys are extracted once and compared byte by byte as unsigned values, the
+ * same order strcmp() gives. A NULL key sorts as the empty string. Short
+ * lists defer to pdqsort with the comparator, as in sorter_radix_u64().
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst A pointer to the list to be sorted.
+ */
+static void sorter_radix_string(sorter *self, list *lst) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->key_string) return;
+
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
+
+    void **arr = view.items;
+    size_t n = (size_t)view.size;
+    if (n < RADIX_SORT_MIN_ELEMENTS && impl->cmp) {
+        pdq_sort(arr, n, impl->cmp);
+        list_view_close(lst, &view, true);
+        return;
+    }
+
+    radix_string_entry *entries = malloc(n * sizeof(radix_string_entry));
+    radix_string_entry *aux = malloc(n * sizeof(radix_string_entry));
+    bool sorted = false;
+    if (entries && aux) {
+        for (size_t i = 0; i < n; i++) {
+            const char *key = impl->key_string(arr[i]);
+            entries[i].key = (const unsigned char *)(key ? key : "");
+            entries[i].item = arr[i];
+        }
+        sorted = radix_sort_strings(entries, aux, n);
+        if (sorted) {
+            for (size_t i = 0; i < n; i++) {
+                arr[i] = entries[i].item;
+            }
+        }
+    }
+
+    list_view_close(lst, &view, sorted);
+    free(entries);
+    free(aux);
+}
+
+/*
+ * TimSort: natural runs are found (descending runs reversed in place),
+ * extended to a minimum length with binary insertion sort, and merged
+ * under the run-stack invariants that keep merges balanced. Merges trim the
+ * prefix and suffix that are already in place by galloping, and switch to
+ * galloping mode while one side keeps winning. The merge buffer belongs to
+ * the sorter and only grows, so repeated sorts do not reallocate it.
+ */
+#define TIM_MIN_MERGE 64
+#define TIM_MIN_GALLOP 7
+/* Enough pending runs for any array size under the stack invariants. */
+#define TIM_MAX_RUNS 85
+
+typedef struct {
+    size_t base;
+    size_t len;
+} tim_run;
+
+typedef struct {
+    void **arr;
+    comparator cmp;
+    sorter_impl *impl; /* owner of the merge buffer */
+    size_t min_gallop;
+    tim_run runs[TIM_MAX_RUNS];
+    int run_count;
+    bool failed;
+} tim_state;
+
+static size_t tim_min_run(size_t n) {
+    size_t r = 0;
+    while (n >= TIM_MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+/* Length of the run starting at @p lo; a strictly descending run is reversed. */
+static size_t tim_count_run(void **arr, size_t lo, size_t hi, comparator cmp) {
+    size_t end = lo + 1;
+    if (end == hi) return 1;
+    if (cmp(arr[end++], arr[lo]) < 0) {
+        while (end < hi && cmp(arr[end], arr[end - 1]) < 0) end++;
+        for (size_t i = lo, j = end - 1; i < j; i++, j--) {
+            ptr_swap(&arr[i], &arr[j]);
+        }
+    } else {
+        while (end < hi && cmp(arr[end], arr[end - 1]) >= 0) end++;
+    }
+    return end - lo;
+}
+
+/* Insert arr[start, hi) into the sorted prefix arr[lo, start), keeping ties stable. */
+static void tim_binary_insertion(void **arr, size_t lo, size_t hi, size_t start, comparator cmp) {
+    for (; start < hi; start++) {
+        void *pivot = arr[start];
+        size_t left = lo;
+        size_t right = start;
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (cmp(pivot, arr[mid]) < 0) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        memmove(&arr[left + 1], &arr[left], (start - left) * sizeof(void *));
+        arr[left] = pivot;
+    }
+}
+
+/*
+ * Position of @p key in sorted a[0, n): leftmost for gallop_left (before
+ * equal elements), rightmost for gallop_right. The search starts at
+ * @p hint and probes 1, 3, 7, ... away before finishing with a binary
+ * search, so keys near the hint are found in O(log distance).
+ */
+static size_t tim_gallop_left(void *key, void **a, size_t n, size_t hint, comparator cmp) {
+    ptrdiff_t last = 0;
+    ptrdiff_t ofs = 1;
+    ptrdiff_t h = (ptrdiff_t)hint;
+    if (cmp(a[hint], key) < 0) {
+        ptrdiff_t max = (ptrdiff_t)n - h;
+        while (ofs < max && cmp(a[h + ofs], key) < 0) {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max) ofs = max;
+        last += h;
+        ofs += h;
+    } else {
+        ptrdiff_t max = h + 1;
+        while (ofs < max && !(cmp(a[h - ofs], key) < 0)) {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max) ofs = max;
+        ptrdiff_t k = last;
+        last = h - ofs;
+        ofs = h - k;
+    }
+    /* a[last] < key <= a[ofs]; narrow down (last, ofs]. */
+    last++;
+    while (last < ofs) {
+        ptrdiff_t mid = last + ((ofs - last) >> 1);
+        if (cmp(a[mid], key) < 0) {
+            last = mid + 1;
+        } else {
+            ofs = mid;
+        }
+    }
+    return (size_t)ofs;
+}
+
+static size_t tim_gallop_right(void *key, void **a, size_t n, size_t hint, comparator cmp) {
+    ptrdiff_t last = 0;
+    ptrdiff_t ofs = 1;
+    ptrdiff_t h = (ptrdiff_t)hint;
+    if (cmp(key, a[hint]) < 0) {
+        ptrdiff_t max = h + 1;
+        while (ofs < max && cmp(key, a[h - ofs]) < 0) {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max) ofs = max;
+        ptrdiff_t k = last;
+        last = h - ofs;
+        ofs = h - k;
+    } else {
+        ptrdiff_t max = (ptrdiff_t)n - h;
+        while (ofs < max && !(cmp(key, a[h + ofs]) < 0)) {
+            last = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max) ofs = max;
+        last += h;
+        ofs += h;
+    }
+    /* a[last] <= key < a[ofs]; narrow down (last, ofs]. */
+    last++;
+    while (last < ofs) {
+        ptrdiff_t mid = last + ((ofs - last) >> 1);
+        if (cmp(key, a[mid]) < 0) {
+            ofs = mid;
+        } else {
+            last = mid + 1;
+        }
+    }
+    return (size_t)ofs;
+}
 
-    for (int j = low; j < high; j++) {
-        if (cmp(arr[j], pivot) <= 0) {
-            i++;
-            buffer_swap(arr, i, j);
+static void **tim_buffer(tim_state *st, size_t need) {
+    sorter_impl *impl = st->impl;
+    if (need > impl->merge_cap) {
+        size_t cap = impl->merge_cap ? impl->merge_cap : 256;
+        while (cap < need) cap *= 2;
+        void **grown = realloc(impl->merge_buf, cap * sizeof(void *));
+        if (!grown) {
+            st->failed = true;
+            return NULL;
         }
+        impl->merge_buf = grown;
+        impl->merge_cap = cap;
     }
-    buffer_swap(arr, i + 1, high);
-    return i + 1;
+    return impl->merge_buf;
 }
 
-/**
- * @brief Sorts a list using quicksort over a snapshot pointer buffer.
- *
- * Snapshots the list into a contiguous pointer buffer, sorts it in place
- * with O(1) swaps, then writes the result back via clear+append in O(n).
- *
- * @param self A pointer to the sorter structure.
- * @param lst A pointer to the list to be sorted.
- */
-static void sorter_quick(sorter *self, list *lst) {
-    sorter_impl *impl = sorter_impl_from_self(self);
-    if (!impl || !impl->cmp) return;
+/* Merge adjacent runs pa[0, na) and pb[0, nb) with na <= nb, left to right. */
+static void tim_merge_lo(tim_state *st, void **pa, size_t na, void **pb, size_t nb) {
+    void **buf = tim_buffer(st, na);
+    if (!buf) return;
+    comparator cmp = st->cmp;
+    memcpy(buf, pa, na * sizeof(void *));
+    void **dest = pa;
+    pa = buf;
 
-    int size = 0;
-    void **arr = list_snapshot(lst, &size);
-    if (size < 2) {
-        free(arr);
-        return;
-    }
-    if (!arr) return;
+    *dest++ = *pb++;
+    if (--nb == 0) goto done;
+    if (na == 1) goto copy_b;
 
-    int *stack = malloc(sizeof(int) * (size_t)size * 2);
-    if (!stack) {
-        free(arr);
-        return;
+    size_t min_gallop = st->min_gallop;
+    for (;;) {
+        size_t acount = 0;
+        size_t bcount = 0;
+        /* One element at a time until one side wins min_gallop times in a row. */
+        for (;;) {
+            if (cmp(*pb, *pa) < 0) {
+                *dest++ = *pb++;
+                bcount++;
+                acount = 0;
+                if (--nb == 0) goto done;
+                if (bcount >= min_gallop) break;
+            } else {
+                *dest++ = *pa++;
+                acount++;
+                bcount = 0;
+                if (--na == 1) goto copy_b;
+                if (acount >= min_gallop) break;
+            }
+        }
+
+        /* Galloping: copy whole stretches found by exponential search. */
+        min_gallop++;
+        do {
+            min_gallop -= min_gallop > 1;
+            st->min_gallop = min_gallop;
+            size_t k = tim_gallop_right(*pb, pa, na, 0, cmp);
+            acount = k;
+            if (k) {
+                memcpy(dest, pa, k * sizeof(void *));
+                dest += k;
+                pa += k;
+                na -= k;
+                if (na == 1) goto copy_b;
+                if (na == 0) goto done; /* only with an inconsistent comparator */
+            }
+            *dest++ = *pb++;
+            if (--nb == 0) goto done;
+
+            k = tim_gallop_left(*pa, pb, nb, 0, cmp);
+            bcount = k;
+            if (k) {
+                memmove(dest, pb, k * sizeof(void *));
+                dest += k;
+                pb += k;
+                nb -= k;
+                if (nb == 0) goto done;
+            }
+            *dest++ = *pa++;
+            if (--na == 1) goto copy_b;
+        } while (acount >= TIM_MIN_GALLOP || bcount >= TIM_MIN_GALLOP);
+        min_gallop++;
+        st->min_gallop = min_gallop;
     }
 
-    int top = 0;
-    stack[top++] = 0;
-    stack[top++] = size - 1;
+done:
+    if (na) memcpy(dest, pa, na * sizeof(void *));
+    return;
+copy_b:
+    /* The last A element belongs after everything left in B. */
+    memmove(dest, pb, nb * sizeof(void *));
+    dest[nb] = *pa;
+}
 
-    while (top > 0) {
-        int high = stack[--top];
-        int low = stack[--top];
-        int pi = buffer_partition(arr, low, high, impl->cmp);
+/* Merge adjacent runs pa[0, na) and pb[0, nb) with na >= nb, right to left. */
+static void tim_merge_hi(tim_state *st, void **pa, size_t na, void **pb, size_t nb) {
+    void **buf = tim_buffer(st, nb);
+    if (!buf) return;
+    comparator cmp = st->cmp;
+    memcpy(buf, pb, nb * sizeof(void *));
+    void **base_a = pa;
+    void **dest = pb + nb - 1;
+    pb = buf + nb - 1;
+    pa += na - 1;
 
-        if (pi - 1 > low) {
-            stack[top++] = low;
-            stack[top++] = pi - 1;
-        }
-        if (pi + 1 < high) {
-            stack[top++] = pi + 1;
-            stack[top++] = high;
+    *dest-- = *pa--;
+    if (--na == 0) goto done;
+    if (nb == 1) goto copy_a;
+
+    size_t min_gallop = st->min_gallop;
+    for (;;) {
+        size_t acount = 0;
+        size_t bcount = 0;
+        for (;;) {
+            if (cmp(*pb, *pa) < 0) {
+                *dest-- = *pa--;
+                acount++;
+                bcount = 0;
+                if (--na == 0) goto done;
+                if (acount >= min_gallop) break;
+            } else {
+                *dest-- = *pb--;
+                bcount++;
+                acount = 0;
+                if (--nb == 1) goto copy_a;
+                if (bcount >= min_gallop) break;
+            }
         }
+
+        min_gallop++;
+        do {
+            min_gallop -= min_gallop > 1;
+            st->min_gallop = min_gallop;
+            size_t k = na - tim_gallop_right(*pb, base_a, na, na - 1, cmp);
+            acount = k;
+            if (k) {
+                dest -= k;
+                pa -= k;
+                memmove(dest + 1, pa + 1, k * sizeof(void *));
+                na -= k;
+                if (na == 0) goto done;
+            }
+            *dest-- = *pb--;
+            if (--nb == 1) goto copy_a;
+
+            k = nb - tim_gallop_left(*pa, buf, nb, nb - 1, cmp);
+            bcount = k;
+            if (k) {
+                dest -= k;
+                pb -= k;
+                memcpy(dest + 1, pb + 1, k * sizeof(void *));
+                nb -= k;
+                if (nb == 1) goto copy_a;
+                if (nb == 0) goto done; /* only with an inconsistent comparator */
+            }
+            *dest-- = *pa--;
+            if (--na == 0) goto done;
+        } while (acount >= TIM_MIN_GALLOP || bcount >= TIM_MIN_GALLOP);
+        min_gallop++;
+        st->min_gallop = min_gallop;
     }
-    free(stack);
 
-    list_replace_with(lst, arr, size);
-    free(arr);
+done:
+    if (nb) memcpy(dest - (nb - 1), buf, nb * sizeof(void *));
+    return;
+copy_a:
+    /* The last B element belongs before everything left in A. */
+    dest -= na;
+    pa -= na;
+    memmove(dest + 1, pa + 1, na * sizeof(void *));
+    *dest = *pb;
 }
 
-/**
- * @brief Merges two sorted sub-arrays within a temporary buffer.
- *
- * @param arr  Array of payload pointers.
- * @param tmp  Temporary buffer for merging.
- * @param low  Start index of the first half.
- * @param mid  End index of the first half (exclusive start of second half).
- * @param high End index of the range (exclusive).
- * @param cmp  Comparator function.
- */
-static void merge(void **arr, void **tmp, int low, int mid, int high,
-                  comparator cmp) {
-    memcpy(tmp + low, arr + low, (size_t)(high - low) * sizeof(void *));
+/* Merge runs i and i + 1 of the pending stack. */
+static void tim_merge_at(tim_state *st, int i) {
+    void **pa = st->arr + st->runs[i].base;
+    size_t na = st->runs[i].len;
+    void **pb = st->arr + st->runs[i + 1].base;
+    size_t nb = st->runs[i + 1].len;
 
-    int i = low;
-    int j = mid;
-    int k = low;
+    st->runs[i].len = na + nb;
+    if (i == st->run_count - 3) {
+        st->runs[i + 1] = st->runs[i + 2];
+    }
+    st->run_count--;
 
-    while (i < mid && j < high) {
-        if (cmp(tmp[i], tmp[j]) <= 0) {
-            arr[k++] = tmp[i++];
-        } else {
-            arr[k++] = tmp[j++];
-        }
+    /* Elements of A already below B's first, and of B above A's last, stay put. */
+    size_t k = tim_gallop_right(*pb, pa, na, 0, st->cmp);
+    pa += k;
+    na -= k;
+    if (na == 0) return;
+    nb = tim_gallop_left(pa[na - 1], pb, nb, nb - 1, st->cmp);
+    if (nb == 0) return;
+
+    if (na <= nb) {
+        tim_merge_lo(st, pa, na, pb, nb);
+    } else {
+        tim_merge_hi(st, pa, na, pb, nb);
     }
-    while (i < mid) {
-        arr[k++] = tmp[i++];
+}
+
+/* Restore the invariants len[i-2] > len[i-1] + len[i] and len[i-1] > len[i]. */
+static void tim_merge_collapse(tim_state *st) {
+    while (st->run_count > 1 && !st->failed) {
+        int i = st->run_count - 2;
+        tim_run *r = st->runs;
+        if ((i > 0 && r[i - 1].len <= r[i].len + r[i + 1].len) ||
+            (i > 1 && r[i - 2].len <= r[i - 1].len + r[i].len)) {
+            if (r[i - 1].len < r[i + 1].len) i--;
+        } else if (r[i].len > r[i + 1].len) {
+            break;
+        }
+        tim_merge_at(st, i);
     }
-    while (j < high) {
-        arr[k++] = tmp[j++];
+}
+
+static void tim_merge_force_collapse(tim_state *st) {
+    while (st->run_count > 1 && !st->failed) {
+        int i = st->run_count - 2;
+        if (i > 0 && st->runs[i - 1].len < st->runs[i + 1].len) i--;
+        tim_merge_at(st, i);
     }
 }
 
 /**
- * @brief Recursively sorts a sub-array using cache-oblivious merge sort.
- *
- * The recursive halving naturally creates sub-problems that fit into each
- * level of the cache hierarchy without requiring any tuning parameters.
+ * @brief Sort @p n pointers in place with TimSort.
  *
- * @param arr  Array of payload pointers.
- * @param tmp  Temporary buffer for merging.
- * @param low  Start index (inclusive).
- * @param high End index (exclusive).
- * @param cmp  Comparator function.
+ * @return false when the merge buffer could not grow; @p arr is then still
+ *         a permutation of its input.
  */
-static void merge_sort_recursive(void **arr, void **tmp, int low, int high,
-                                 comparator cmp) {
-    if (high - low < 2) {
-        return;
+static bool tim_sort(sorter_impl *impl, void **arr, size_t n) {
+    tim_state st;
+    st.arr = arr;
+    st.cmp = impl->cmp;
+    st.impl = impl;
+    st.min_gallop = TIM_MIN_GALLOP;
+    st.run_count = 0;
+    st.failed = false;
+
+    size_t min_run = tim_min_run(n);
+    size_t lo = 0;
+    while (lo < n && !st.failed) {
+        size_t run = tim_count_run(arr, lo, n, st.cmp);
+        if (run < min_run) {
+            size_t forced = n - lo < min_run ? n - lo : min_run;
+            tim_binary_insertion(arr, lo, lo + forced, lo + run, st.cmp);
+            run = forced;
+        }
+        st.runs[st.run_count].base = lo;
+        st.runs[st.run_count].len = run;
+        st.run_count++;
+        tim_merge_collapse(&st);
+        lo += run;
     }
-    int mid = low + (high - low) / 2;
-    merge_sort_recursive(arr, tmp, low, mid, cmp);
-    merge_sort_recursive(arr, tmp, mid, high, cmp);
-    merge(arr, tmp, low, mid, high, cmp);
+    tim_merge_force_collapse(&st);
+    return !st.failed;
 }
 
 /**
- * @brief Sorts a list using cache-oblivious merge sort.
+ * @brief Sorts a list using TimSort over a list_view.
  *
- * Elements are copied into a contiguous array for cache-friendly access,
- * sorted using a recursive merge sort (which naturally adapts to all cache
- * levels), and then written back to the list.  This guarantees O(n log n)
- * worst-case time complexity.
+ * Already sorted or reversed input takes one pass, and input made of a few
+ * sorted batches costs little more than merging them. If the merge buffer
+ * cannot grow the sort stops early; an array list is then left partly
+ * sorted, but no element is lost or duplicated.
  *
  * @param self A pointer to the sorter structure.
- * @param lst  A pointer to the list to be sorted.
+ * @param lst A pointer to the list to be sorted.
  */
-static void sorter_merge(sorter *self, list *lst) {
+static void sorter_tim(sorter *self, list *lst) {
     sorter_impl *impl = sorter_impl_from_self(self);
-    if (!impl) return;
-
-    int size = lst->size(lst);
-    if (size < 2) {
-        return;
-    }
-
-    void **arr = malloc((size_t)size * sizeof(void *));
-    if (!arr) return;
-
-    void **tmp = malloc((size_t)size * sizeof(void *));
-    if (!tmp) {
-        free(arr);
-        return;
-    }
-
-    for (int i = 0; i < size; i++) {
-        arr[i] = lst->get(lst, i);
-    }
-
-    merge_sort_recursive(arr, tmp, 0, size, impl->cmp);
+    if (!impl || !impl->cmp) return;
 
-    list_replace_with(lst, arr, size);
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
 
-    free(tmp);
-    free(arr);
+    bool sorted = tim_sort(impl, view.items, (size_t)view.size);
+    list_view_close(lst, &view, sorted);
 }
 
 /**
  * @brief Shuffle the elements in a list using the Fisher-Yates algorithm.
  *
- * Operates on a snapshot pointer buffer with O(1) swaps and writes the
- * result back via clear+append, giving O(n) total work instead of the
- * O(n^2) cost incurred when swapping through the list interface.
+ * Operates on a list_view pointer buffer with O(1) swaps, giving O(n)
+ * total work instead of the O(n^2) cost incurred when swapping through the
+ * list interface.
  *
  * @param self A pointer to the sorter structure.
  * @param lst A pointer to the list to be shuffled.
  */
 void collections_shuffle(sorter *self, list *lst) {
     (void)self;
-    int n = 0;
-    void **arr = list_snapshot(lst, &n);
-    if (n < 2) {
-        free(arr);
-        return;
-    }
-    if (!arr) return;
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
 
-    for (int i = n - 1; i > 0; i--) {
+    for (int i = view.size - 1; i > 0; i--) {
         int j = rand() % (i + 1);
-        buffer_swap(arr, i, j);
+        buffer_swap(view.items, i, j);
     }
 
-    list_replace_with(lst, arr, n);
-    free(arr);
+    list_view_close(lst, &view, true);
 }
 
 /**
  * @brief Reverse the elements in a list.
  *
- * Snapshots the list into a pointer buffer, reverses in place with O(1)
- * swaps, and writes the result back in O(n).
+ * Reverses a list_view pointer buffer in place with O(1) swaps; a snapshot
+ * is written back in O(n).
  *
  * @param self A pointer to the sorter instance.
  * @param lst The list to be reversed.
  */
 void collections_reverse(sorter *self, list *lst) {
     (void)self;
-    int n = 0;
-    void **arr = list_snapshot(lst, &n);
-    if (n < 2) {
-        free(arr);
-        return;
-    }
-    if (!arr) return;
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
 
     int i = 0;
-    int j = n - 1;
+    int j = view.size - 1;
     while (i < j) {
-        buffer_swap(arr, i, j);
+        buffer_swap(view.items, i, j);
         i++;
         j--;
     }
 
-    list_replace_with(lst, arr, n);
-    free(arr);
+    list_view_close(lst, &view, true);
 }
 
 /**
@@ -322,16 +1611,18 @@ void collections_reverse(sorter *self, list *lst) {
  * @param self A pointer to the sorter structure.
  * @param lst A pointer to the sorted list.
  * @param item A pointer to the item to be searched.
- * @return The index of the item in the list, or -1 if the item is not found.
+ * @return The index of the item in the list, or -1 if the item is not found
+ *         or the sorter has no comparator.
  */
 int collections_binary_search(sorter *self, list *lst, void *item) {
     sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp) return -1;
     int low = 0;
     int high = lst->size(lst) - 1;
     while (low <= high) {
         int mid = low + (high - low) / 2;
         void *mid_item = lst->get(lst, mid);
-        int cmp_result = impl ? impl->cmp(mid_item, item) : 0;
+        int cmp_result = impl->cmp(mid_item, item);
 
         if (cmp_result == 0) {
             return mid;
@@ -344,6 +1635,89 @@ int collections_binary_search(sorter *self, list *lst, void *item) {
     return -1;
 }
 
+/*
+ * Branchless lower bound for up to SEARCH_BATCH_LANES keys at once. All
+ * lanes share the same shrinking length, so each round does one step per
+ * lane and prefetches the slot every lane probes next.
+ */
+static void search_lower_bounds(void **arr, size_t n, void *const *keys, size_t lanes,
+                                size_t *pos, comparator cmp) {
+    for (size_t l = 0; l < lanes; l++) {
+        pos[l] = 0;
+    }
+    size_t len = n;
+    while (len > 1) {
+        size_t half = len / 2;
+        for (size_t l = 0; l < lanes; l++) {
+            pos[l] += cmp(arr[pos[l] + half], keys[l]) < 0 ? half : 0;
+        }
+        len -= half;
+        for (size_t l = 0; l < lanes; l++) {
+            sort_prefetch(&arr[pos[l] + len / 2]);
+        }
+    }
+    for (size_t l = 0; l < lanes; l++) {
+        pos[l] += cmp(arr[pos[l]], keys[l]) < 0 ? 1 : 0;
+    }
+}
+
+/**
+ * @brief Performs binary search for a batch of keys on a sorted list.
+ *
+ * Searches an array list's buffer directly and any other list through one
+ * snapshot shared by the whole batch. Keys are resolved in groups of
+ * SEARCH_BATCH_LANES, with every group stepping in lockstep so the memory
+ * latency of one probe hides behind the others.
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst A pointer to the sorted list.
+ * @param keys The keys to search for.
+ * @param count The number of keys.
+ * @param out Receives the index of the first match for each key, or -1.
+ * @return The number of keys found, or -1 on invalid arguments or
+ *         allocation failure.
+ */
+int collections_binary_search_batch(sorter *self, list *lst, void *const *keys, int count, int *out) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp || !lst || count < 0 || (count > 0 && (!keys || !out))) return -1;
+
+    int size = lst->size(lst);
+    if (size == 0) {
+        for (int i = 0; i < count; i++) {
+            out[i] = -1;
+        }
+        return 0;
+    }
+
+    void **arr = array_list_data(lst);
+    void **snapshot = NULL;
+    if (!arr) {
+        snapshot = malloc((size_t)size * sizeof(void *));
+        if (!snapshot) return -1;
+        for (int i = 0; i < size; i++) {
+            snapshot[i] = lst->get(lst, i);
+        }
+        arr = snapshot;
+    }
+
+    int found = 0;
+    size_t n = (size_t)size;
+    size_t pos[SEARCH_BATCH_LANES];
+    for (int first = 0; first < count; first += SEARCH_BATCH_LANES) {
+        size_t lanes = (size_t)(count - first);
+        if (lanes > SEARCH_BATCH_LANES) lanes = SEARCH_BATCH_LANES;
+        search_lower_bounds(arr, n, keys + first, lanes, pos, impl->cmp);
+        for (size_t l = 0; l < lanes; l++) {
+            bool hit = pos[l] < n && impl->cmp(arr[pos[l]], keys[(size_t)first + l]) == 0;
+            out[(size_t)first + l] = hit ? (int)pos[l] : -1;
+            found += hit ? 1 : 0;
+        }
+    }
+
+    free(snapshot);
+    return found;
+}
+
 /**
  * @brief Copies the items from one list to another.
  *
@@ -368,6 +1742,8 @@ void collections_copy(sorter *self, list *src, list *dest) {
  *
  * This function finds the minimum and maximum elements in a given list using a custom sorter.
  * The minimum and maximum elements are returned through the `min` and `max` parameters, respectively.
+ * Items are taken in pairs, for about 3n/2 comparisons, and an array list is read straight from
+ * its buffer instead of through get().
  *
  * @param self A pointer to the sorter structure.
  * @param lst A pointer to the list containing the elements.
@@ -383,36 +1759,43 @@ void collections_min_max(sorter *self, list *lst, void **min, void **max) {
         return;
     }
 
+    void **data = array_list_data(lst);
+    comparator cmp = impl ? impl->cmp : NULL;
+    void *lo;
+    void *hi;
     int i;
     if (size % 2 == 0) {
-        void *a = lst->get(lst, 0);
-        void *b = lst->get(lst, 1);
-        if (impl && impl->cmp(a, b) > 0) {
-            *max = a;
-            *min = b;
+        void *a = data ? data[0] : lst->get(lst, 0);
+        void *b = data ? data[1] : lst->get(lst, 1);
+        if (cmp && cmp(a, b) > 0) {
+            hi = a;
+            lo = b;
         } else {
-            *min = a;
-            *max = b;
+            lo = a;
+            hi = b;
         }
         i = 2;
     } else {
-        *min = lst->get(lst, 0);
-        *max = *min;
+        lo = data ? data[0] : lst->get(lst, 0);
+        hi = lo;
         i = 1;
     }
 
-    for (; i + 1 < size; i += 2) {
-        void *first = lst->get(lst, i);
-        void *second = lst->get(lst, i + 1);
-
-        if (impl && impl->cmp(first, second) > 0) {
-            if (impl->cmp(first, *max) > 0) *max = first;
-            if (impl->cmp(second, *min) < 0) *min = second;
-        } else {
-            if (impl && impl->cmp(second, *max) > 0) *max = second;
-            if (impl && impl->cmp(first, *min) < 0) *min = first;
+    /* Order each pair first, then test only its smaller against the
+     * minimum and its larger against the maximum: 3 comparisons per pair. */
+    for (; cmp && i + 1 < size; i += 2) {
+        void *first = data ? data[i] : lst->get(lst, i);
+        void *second = data ? data[i + 1] : lst->get(lst, i + 1);
+        if (cmp(first, second) > 0) {
+            void *tmp = first;
+            first = second;
+            second = tmp;
         }
+        if (cmp(first, lo) < 0) lo = first;
+        if (cmp(second, hi) > 0) hi = second;
     }
+    *min = lo;
+    *max = hi;
 }
 
 
@@ -424,18 +1807,21 @@ void collections_min_max(sorter *self, list *lst, void **min, void **max) {
  *
  * @param self A pointer to the sorter structure.
  * @param lst A pointer to the list structure.
- * @return A pointer to the maximum element found in the list, or NULL if the list is empty.
+ * @return A pointer to the maximum element found in the list, or NULL if the list is empty
+ *         or the sorter has no comparator.
  */
 void *collections_max(sorter *self, list *lst) {
     sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp) return NULL;
     int size = lst->size(lst);
     if (size == 0) return NULL; // Lista vazia, retorna nulo
 
-    void *maximum = lst->get(lst, 0); // Inicia com o primeiro elemento
+    void **data = array_list_data(lst);
+    void *maximum = data ? data[0] : lst->get(lst, 0); // Inicia com o primeiro elemento
 
     for (int i = 1; i < size; i++) {
-        void *current = lst->get(lst, i);
-        if (impl && impl->cmp(current, maximum) > 0) {
+        void *current = data ? data[i] : lst->get(lst, i);
+        if (impl->cmp(current, maximum) > 0) {
             maximum = current; // Encontra novo máximo
         }
     }
@@ -451,18 +1837,21 @@ void *collections_max(sorter *self, list *lst) {
  *
  * @param self A pointer to the `sorter` struct which contains the comparison function.
  * @param lst A pointer to the `list` struct where the minimum element needs to be found.
- * @return A pointer to the minimum element found in the list, or NULL if the list is empty.
+ * @return A pointer to the minimum element found in the list, or NULL if the list is empty
+ *         or the sorter has no comparator.
  */
 void *collections_min(sorter *self, list *lst) {
     sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp) return NULL;
     int size = lst->size(lst);
     if (size == 0) return NULL; // Lista vazia, retorna nulo
 
-    void *minimum = lst->get(lst, 0); // Inicia com o primeiro elemento
+    void **data = array_list_data(lst);
+    void *minimum = data ? data[0] : lst->get(lst, 0); // Inicia com o primeiro elemento
 
     for (int i = 1; i < size; i++) {
-        void *current = lst->get(lst, i);
-        if (impl && impl->cmp(current, minimum) < 0) {
+        void *current = data ? data[i] : lst->get(lst, i);
+        if (impl->cmp(current, minimum) < 0) {
             minimum = current; // Encontra novo mínimo
         }
     }
@@ -470,6 +1859,182 @@ void *collections_min(sorter *self, list *lst) {
     return minimum;
 }
 
+/* Min-heap counterpart of pdq_sift_down(), for the bounded heap in top_k. */
+static void select_sift_down_min(void **arr, size_t root, size_t n, comparator cmp) {
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= n) return;
+        if (child + 1 < n && cmp(arr[child + 1], arr[child]) < 0) child++;
+        if (cmp(arr[child], arr[root]) >= 0) return;
+        ptr_swap(&arr[root], &arr[child]);
+        root = child;
+    }
+}
+
+/*
+ * Leave the k smallest of arr[0, n) in arr[0, k), as a max-heap: each later
+ * item only displaces the heap's root when it is smaller, so the scan costs
+ * O(n log k).
+ */
+static void heap_select(void **arr, size_t k, size_t n, comparator cmp) {
+    for (size_t i = k / 2; i-- > 0;) {
+        pdq_sift_down(arr, i, k, cmp);
+    }
+    for (size_t i = k; i < n; i++) {
+        if (cmp(arr[i], arr[0]) < 0) {
+            ptr_swap(&arr[0], &arr[i]);
+            pdq_sift_down(arr, 0, k, cmp);
+        }
+    }
+}
+
+/*
+ * Introselect: quickselect on pdqsort's pivots and partitions, narrowing to
+ * the side that holds @p nth. A pivot equal to the previous one sweeps its
+ * duplicates aside in one pass, and unbalanced partitions break up patterns
+ * as in pdq_loop(). After log2(n) bad partitions heap selection bounds the
+ * rest at O(n log n).
+ */
+static void intro_select(void **begin, void **nth, void **end, comparator cmp) {
+    void **first = begin;
+    int bad_allowed = 0;
+    for (size_t m = (size_t)(end - begin); m > 1; m >>= 1) {
+        bad_allowed++;
+    }
+
+    while (end - begin > PDQ_INSERTION_SORT_THRESHOLD) {
+        size_t size = (size_t)(end - begin);
+        pdq_choose_pivot(begin, end, cmp);
+
+        if (begin != first && !(cmp(*(begin - 1), *begin) < 0)) {
+            void **equal_end = pdq_partition_left(begin, end, cmp);
+            if (nth <= equal_end) return;
+            begin = equal_end + 1;
+            continue;
+        }
+
+        bool already_partitioned = false;
+        void **pivot_pos = pdq_partition_right(begin, end, cmp, &already_partitioned);
+        if (pivot_pos == nth) return;
+
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = size - l_size - 1;
+        if (l_size < size / 8 || r_size < size / 8) {
+            if (--bad_allowed == 0) {
+                heap_select(begin, (size_t)(nth - begin) + 1, size, cmp);
+                ptr_swap(begin, nth);
+                return;
+            }
+            pdq_break_patterns(begin, pivot_pos, end);
+        }
+        if (nth < pivot_pos) {
+            end = pivot_pos;
+        } else {
+            begin = pivot_pos + 1;
+        }
+    }
+    pdq_insertion_sort(begin, end, cmp);
+}
+
+/**
+ * @brief Sorts the @p k smallest items of a list into its first @p k slots.
+ *
+ * A max-heap of the first @p k items is kept while the rest of the list is
+ * scanned, then heap-sorted, so the cost is O(n log k) and the remaining
+ * items are left in unspecified order. With @p k at or past the list size
+ * this is a full pdqsort.
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst A pointer to the list.
+ * @param k Number of leading items to sort.
+ */
+void collections_partial_sort(sorter *self, list *lst, int k) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp || k <= 0) return;
+
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
+
+    if (k >= view.size) {
+        pdq_sort(view.items, (size_t)view.size, impl->cmp);
+    } else {
+        heap_select(view.items, (size_t)k, (size_t)view.size, impl->cmp);
+        pdq_heapsort(view.items, view.items + k, impl->cmp);
+    }
+
+    list_view_close(lst, &view, true);
+}
+
+/**
+ * @brief Puts the item that belongs at index @p n of the sorted list there.
+ *
+ * Afterwards no item before @p n compares greater than it and no item after
+ * compares less. Runs introselect in expected O(n).
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst A pointer to the list.
+ * @param n Zero-based index to select; out-of-range values do nothing.
+ */
+void collections_nth_element(sorter *self, list *lst, int n) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp || n < 0 || n >= lst->size(lst)) return;
+
+    list_view view;
+    if (!list_view_open(lst, &view)) return;
+
+    intro_select(view.items, view.items + n, view.items + view.size, impl->cmp);
+
+    list_view_close(lst, &view, true);
+}
+
+/**
+ * @brief Copies the @p k largest items of a list into @p out, largest first.
+ *
+ * A min-heap of the best @p k items seen so far lives in @p out itself, so
+ * the scan costs O(n log k), needs no extra memory and leaves the list
+ * untouched.
+ *
+ * @param self A pointer to the sorter structure.
+ * @param lst A pointer to the list.
+ * @param k Maximum number of items to return.
+ * @param out Receives up to @p k item pointers.
+ * @return The number of items written to @p out.
+ */
+int collections_top_k(sorter *self, list *lst, int k, void **out) {
+    sorter_impl *impl = sorter_impl_from_self(self);
+    if (!impl || !impl->cmp || !out || k <= 0) return 0;
+
+    int size = lst->size(lst);
+    void **data = array_list_data(lst);
+    size_t cap = (size_t)k;
+    size_t count = 0;
+    for (int i = 0; i < size; i++) {
+        void *item = data ? data[i] : lst->get(lst, i);
+        if (count < cap) {
+            out[count++] = item;
+            if (count == cap) {
+                for (size_t j = cap / 2; j-- > 0;) {
+                    select_sift_down_min(out, j, cap, impl->cmp);
+                }
+            }
+        } else if (impl->cmp(item, out[0]) > 0) {
+            out[0] = item;
+            select_sift_down_min(out, 0, cap, impl->cmp);
+        }
+    }
+
+    if (count < cap) {
+        for (size_t j = count / 2; j-- > 0;) {
+            select_sift_down_min(out, j, count, impl->cmp);
+        }
+    }
+    for (size_t j = count; j-- > 1;) {
+        ptr_swap(&out[0], &out[j]);
+        select_sift_down_min(out, 0, j, impl->cmp);
+    }
+    return (int)count;
+}
+
 /**
  * @brief Creates a sorter structure.
  *
@@ -492,6 +2057,11 @@ sorter *create_sorter(comparator cmp) {
     }
 
     impl->cmp = cmp;
+    impl->threads = 1;
+    impl->key_u64 = NULL;
+    impl->key_string = NULL;
+    impl->merge_buf = NULL;
+    impl->merge_cap = 0;
 
     s->impl = impl;
     s->sort = sorter_quick;
@@ -499,10 +2069,14 @@ sorter *create_sorter(comparator cmp) {
     s->shuffle = collections_shuffle;
     s->reverse = collections_reverse;
     s->binary_search = collections_binary_search;
+    s->binary_search_batch = collections_binary_search_batch;
     s->copy = collections_copy;
     s->min = collections_min;
     s->max = collections_max;
     s->min_max = collections_min_max;
+    s->partial_sort = collections_partial_sort;
+    s->nth_element = collections_nth_element;
+    s->top_k = collections_top_k;
     s->free = sorter_free;
     s->user_data = NULL;
 
@@ -528,3 +2102,96 @@ sorter *create_merge_sorter(comparator cmp) {
     s->sort = sorter_merge;
     return s;
 }
+
+/**
+ * @brief Creates a sorter whose sort runs a parallel merge sort.
+ *
+ * Identical to create_merge_sorter() except that sort() divides the work
+ * across up to @p threads POSIX threads.  The output, including the order of
+ * equal elements, matches create_merge_sorter().
+ *
+ * @param cmp The comparator function for sorting the data.
+ * @param threads Worker threads to use; 0 or less selects the number of
+ *                online CPUs.
+ * @return A pointer to the created sorter structure.
+ * @retval NULL If memory allocation failed.
+ */
+sorter *create_parallel_sorter(comparator cmp, int threads) {
+    sorter *s = create_sorter(cmp);
+    if (!s) return NULL;
+
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > PARALLEL_SORT_MAX_THREADS) {
+        threads = PARALLEL_SORT_MAX_THREADS;
+    }
+
+    sorter_impl_from_self(s)->threads = threads;
+    s->sort = sorter_parallel;
+    return s;
+}
+
+/**
+ * @brief Creates a sorter that radix-sorts by an unsigned 64-bit key.
+ *
+ * The sort function pointer runs an LSD radix sort on the keys returned by
+ * @p key; the remaining operations use @p cmp, which should order items the
+ * same way.
+ *
+ * @param cmp The comparator used by the non-sorting operations.
+ * @param key Extracts each item's key.
+ * @return A pointer to the created sorter structure.
+ * @retval NULL If @p key is NULL or memory allocation failed.
+ */
+sorter *create_radix_sorter(comparator cmp, sort_key_u64 key) {
+    if (!key) return NULL;
+    sorter *s = create_sorter(cmp);
+    if (!s) return NULL;
+
+    sorter_impl_from_self(s)->key_u64 = key;
+    s->sort = sorter_radix_u64;
+    return s;
+}
+
+/**
+ * @brief Creates a sorter that radix-sorts by a string key.
+ *
+ * The sort function pointer runs an MSD radix sort on the NUL-terminated
+ * keys returned by @p key, in strcmp() order; the remaining operations use
+ * @p cmp.
+ *
+ * @param cmp The comparator used by the non-sorting operations.
+ * @param key Extracts each item's key string.
+ * @return A pointer to the created sorter structure.
+ * @retval NULL If @p key is NULL or memory allocation failed.
+ */
+sorter *create_string_radix_sorter(comparator cmp, sort_key_string key) {
+    if (!key) return NULL;
+    sorter *s = create_sorter(cmp);
+    if (!s) return NULL;
+
+    sorter_impl_from_self(s)->key_string = key;
+    s->sort = sorter_radix_string;
+    return s;
+}
+
+/**
+ * @brief Creates a sorter that uses TimSort.
+ *
+ * Identical to create_sorter() but the sort function pointer runs an
+ * adaptive, stable natural-run merge sort whose merge buffer is kept
+ * between calls.
+ *
+ * @param cmp The comparator function for sorting the data.
+ * @return A pointer to the created sorter structure.
+ * @retval NULL If memory allocation failed.
+ */
+sorter *create_tim_sorter(comparator cmp) {
+    sorter *s = create_sorter(cmp);
+    if (!s) return NULL;
+
+    s->sort = sorter_tim;
+    return s;
+}
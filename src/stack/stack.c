@@ -12,26 +12,22 @@ static int stack_size(const stack *self);
 static stack *stack_clone_shallow(const stack *self);
 static stack *stack_clone_deep(const stack *self, element_copier copier);
 
-stack *create_stack(StackType type) {
+/* Stack of @p type over @p lst; takes ownership of @p lst. */
+static stack *stack_wrap(StackType type, list *lst) {
+    if (!lst) return NULL;
     stack *stk = malloc(sizeof(stack));
-    if (!stk) return NULL;
+    if (!stk) {
+        lst->free(lst);
+        return NULL;
+    }
 
+    stk->impl = lst;
     if (type == ARRAY_STACK) {
-        stk->impl = create_list(ARRAY_LIST, 10, NULL);
         stk->push = array_stack_push;
         stk->pop = array_stack_pop;
-    } else if (type == LINKED_STACK) {
-        stk->impl = create_list(LINKED_LIST, 10, NULL);
+    } else {
         stk->push = linked_stack_push;
         stk->pop = linked_stack_pop;
-    } else {
-        free(stk);
-        return NULL;
-    }
-
-    if (!stk->impl) {
-        free(stk);
-        return NULL;
     }
 
     stk->top = stack_top;
@@ -46,6 +42,26 @@ stack *create_stack(StackType type) {
     return stk;
 }
 
+stack *create_stack(StackType type) {
+    if (type == ARRAY_STACK) {
+        return stack_wrap(type, create_list(ARRAY_LIST, 10, NULL));
+    } else if (type == LINKED_STACK) {
+        return stack_wrap(type, create_list(LINKED_LIST, 10, NULL));
+    }
+    return NULL;
+}
+
+stack *create_stack_of(StackType type, size_t element_size) {
+    if (type != ARRAY_STACK) return NULL;
+    return stack_wrap(type, create_list_of(ARRAY_LIST, element_size, 10));
+}
+
+/* Empty stack of the same kind as @p self. */
+static stack *stack_create_like(const stack *self, const list *lst) {
+    StackType type = (self->push == array_stack_push) ? ARRAY_STACK : LINKED_STACK;
+    return lst->_element_size > 0 ? create_stack_of(type, lst->_element_size) : create_stack(type);
+}
+
 static void *stack_top(const stack *self) {
     list *lst = (list *)self->impl;
     if (!lst || lst->size(lst) == 0) return NULL;
@@ -87,8 +103,7 @@ static stack *stack_clone_shallow(const stack *self) {
         return NULL;
     }
 
-    StackType type = (self->push == array_stack_push) ? ARRAY_STACK : LINKED_STACK;
-    stack *copy = create_stack(type);
+    stack *copy = stack_create_like(self, lst);
     if (!copy) {
         return NULL;
     }
@@ -111,6 +126,9 @@ static stack *stack_clone_shallow(const stack *self) {
 
 
 static stack *stack_clone_deep(const stack *self, element_copier copier) {
+    if (self && self->impl && ((list *)self->impl)->_element_size > 0) {
+        return stack_clone_shallow(self);
+    }
     if (!self || !copier) {
         return NULL;
     }
@@ -120,8 +138,7 @@ static stack *stack_clone_deep(const stack *self, element_copier copier) {
         return NULL;
     }
 
-    StackType type = (self->push == array_stack_push) ? ARRAY_STACK : LINKED_STACK;
-    stack *copy = create_stack(type);
+    stack *copy = stack_create_like(self, lst);
     if (!copy) {
         return NULL;
     }
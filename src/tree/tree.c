@@ -86,6 +86,62 @@ static void tree_range_query_node(tree_impl *impl, tree_node *node, void *low, v
     }
 }
 
+/*
+ * Build the subtree for keys[lo, hi) around the middle element. Splitting at
+ * the middle fills every level but the last, so red-black trees stay valid by
+ * coloring only that partial level (depth >= red_depth) red.
+ */
+static tree_node *tree_build_range(tree_impl *impl, void **keys, void **values, size_t lo, size_t hi,
+                                   tree_node *parent, int depth, int red_depth, int *failed) {
+    tree_node *nil = impl->nil;
+    if (lo >= hi || *failed) {
+        return nil;
+    }
+
+    tree_node *node = (tree_node *)calloc(1, sizeof(tree_node));
+    if (!node) {
+        *failed = 1;
+        return nil;
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    node->key = keys[mid];
+    node->value = values ? values[mid] : keys[mid];
+    node->parent = parent;
+    node->color = depth >= red_depth ? RB_RED : RB_BLACK;
+    node->left = tree_build_range(impl, keys, values, lo, mid, node, depth + 1, red_depth, failed);
+    node->right = tree_build_range(impl, keys, values, mid + 1, hi, node, depth + 1, red_depth, failed);
+
+    int left_height = tree_node_is_nil(impl, node->left) ? 0 : node->left->height;
+    int right_height = tree_node_is_nil(impl, node->right) ? 0 : node->right->height;
+    node->height = 1 + (left_height > right_height ? left_height : right_height);
+    return node;
+}
+
+ova_error_code tree_build_sorted(tree_impl *impl, void **keys, void **values, size_t n) {
+    if (!impl || impl->size != 0 || (n > 0 && !keys)) {
+        return OVA_ERROR_INVALID_ARG;
+    }
+
+    int full_levels = 0;
+    while (((size_t)1 << (full_levels + 1)) - 1 <= n) {
+        full_levels++;
+    }
+
+    int failed = 0;
+    tree_node *root = tree_build_range(impl, keys, values, 0, n, impl->nil, 0, full_levels, &failed);
+    if (failed) {
+        tree_free_node(impl, root);
+        return OVA_ERROR_MEMORY;
+    }
+    if (!tree_node_is_nil(impl, root)) {
+        root->color = RB_BLACK;
+    }
+    impl->root = root;
+    impl->size = n;
+    return OVA_SUCCESS;
+}
+
 static ova_error_code tree_insert_method(tree *self, void *key, void *value) {
     tree_impl *impl = tree_impl_from_tree(self);
     if (!impl || !impl->cmp || !key) {
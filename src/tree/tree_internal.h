@@ -49,4 +49,11 @@ void avl_tree_delete(tree_impl *t, void *key);
 void rb_tree_insert(tree_impl *t, void *key, void *value);
 void rb_tree_delete(tree_impl *t, void *key);
 
+/*
+ * Fill an empty tree from @p n strictly ascending keys in O(n), producing a
+ * balanced tree without comparisons. A NULL @p values stores each key as its
+ * own value.
+ */
+ova_error_code tree_build_sorted(tree_impl *t, void **keys, void **values, size_t n);
+
 #endif // TREE_INTERNAL_H
@@ -0,0 +1,59 @@
+#ifndef OPEN_ADDRESSING_H
+#define OPEN_ADDRESSING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Sizing and deletion shared by the linear-probing tables (int_map and the
+ * SET_HASH backend). Tables are powers of two indexed through a mask.
+ */
+
+/* Smallest table and the largest one a size reported as int can describe. */
+#define OPEN_ADDRESSING_MIN_SLOTS ((size_t)16)
+#define OPEN_ADDRESSING_MAX_SLOTS ((size_t)1 << 30)
+
+/* Same 0.75 ceiling as the map's LOAD_FACTOR, kept in integer arithmetic. */
+static inline int open_addressing_over_load(size_t entries, size_t slots) {
+    return entries > slots / 4 * 3;
+}
+
+/* Smallest table that holds @p entries, capped at OPEN_ADDRESSING_MAX_SLOTS. */
+static inline size_t open_addressing_slots_for(size_t entries) {
+    size_t slots = OPEN_ADDRESSING_MIN_SLOTS;
+    while (slots < OPEN_ADDRESSING_MAX_SLOTS && open_addressing_over_load(entries, slots)) {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+/* Per-table slot access for open_addressing_erase(). */
+typedef struct open_addressing_ops {
+    bool (*occupied)(const void *table, size_t index);
+    size_t (*home)(const void *table, size_t index);
+    void (*move)(void *table, size_t to, size_t from);
+} open_addressing_ops;
+
+/*
+ * Backward-shift deletion: empty slot @p hole by pulling later members of
+ * its probe run back, unless that would move one in front of its home slot.
+ * Returns the slot left empty, which the caller clears. The ops are meant
+ * to be static functions so the calls inline.
+ */
+static inline size_t open_addressing_erase(void *table, size_t mask, size_t hole,
+                                           const open_addressing_ops *ops) {
+    size_t j = hole;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!ops->occupied(table, j)) {
+            return hole;
+        }
+        size_t home = ops->home(table, j);
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            ops->move(table, hole, j);
+            hole = j;
+        }
+    }
+}
+
+#endif /* OPEN_ADDRESSING_H */
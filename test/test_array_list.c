@@ -2,6 +2,7 @@
 #include "../include/list.h"
 #include "../src/utils/capacity_utils.h"
 #include <limits.h>
+#include <string.h>
 #include <time.h>
 
 extern size_t array_list_active_buffer_count(void);
@@ -263,6 +264,113 @@ void test_array_list_bulk_insert_error_codes(void) {
     lst->free(lst);
 }
 
+void test_array_list_range_operations(void) {
+    list *lst = create_list(ARRAY_LIST, 2, NULL);
+    int items[10];
+    void *ptrs[10];
+    for (int i = 0; i < 10; i++) {
+        items[i] = i;
+        ptrs[i] = &items[i];
+    }
+
+    /* {0, 1, 8, 9} then {0, 1, 2..7, 8, 9} */
+    int passed = lst->insert_range(lst, 0, ptrs, 2) == OVA_SUCCESS;
+    passed &= lst->insert_range(lst, 2, &ptrs[8], 2) == OVA_SUCCESS;
+    passed &= lst->insert_range(lst, 2, &ptrs[2], 6) == OVA_SUCCESS;
+    passed &= lst->insert_range(lst, 10, NULL, 0) == OVA_SUCCESS;
+    passed &= lst->size(lst) == 10;
+    for (int i = 0; i < 10 && passed; i++) {
+        passed = lst->get(lst, i) == ptrs[i];
+    }
+    print_test_result(passed, "Array List insert_range inserts in place and in order");
+
+    void **span = NULL;
+    int span_len = -1;
+    passed = lst->data_span(lst, &span, &span_len) == OVA_SUCCESS && span_len == 10;
+    for (int i = 0; i < span_len && passed; i++) {
+        passed = span[i] == ptrs[i];
+    }
+    print_test_result(passed, "Array List data_span exposes the item buffer");
+
+    passed = lst->remove_range(lst, 2, 8) == OVA_SUCCESS && lst->size(lst) == 4;
+    passed &= lst->get(lst, 1) == ptrs[1] && lst->get(lst, 2) == ptrs[8];
+    passed &= lst->remove_range(lst, 3, 3) == OVA_SUCCESS && lst->size(lst) == 4;
+    passed &= lst->remove_range(lst, 0, 4) == OVA_SUCCESS && lst->size(lst) == 0;
+    print_test_result(passed, "Array List remove_range closes the gap");
+
+    passed = lst->reserve(lst, 1000) == OVA_SUCCESS;
+    passed &= lst->data_span(lst, &span, &span_len) == OVA_SUCCESS;
+    void **before = span;
+    for (int i = 0; i < 1000 && passed; i++) {
+        passed = lst->insert(lst, ptrs[i % 10], i) == OVA_SUCCESS;
+    }
+    passed &= lst->data_span(lst, &span, &span_len) == OVA_SUCCESS && span == before && span_len == 1000;
+    print_test_result(passed, "Array List reserve avoids regrowing");
+
+    passed = lst->insert_range(lst, -1, ptrs, 1) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    passed &= lst->insert_range(lst, 1001, ptrs, 1) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    passed &= lst->insert_range(lst, 0, NULL, 1) == OVA_ERROR_INVALID_ARG;
+    passed &= lst->remove_range(lst, 5, 4) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    passed &= lst->remove_range(lst, 0, 1001) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    passed &= lst->reserve(lst, -1) == OVA_ERROR_INVALID_ARG;
+    passed &= lst->size(lst) == 1000;
+    print_test_result(passed, "Array List range operations reject bad arguments");
+
+    lst->free(lst);
+}
+
+typedef struct {
+    double x;
+    double y;
+} point;
+
+void test_array_list_of_values(void) {
+    list *lst = create_list_of(ARRAY_LIST, sizeof(point), 2);
+    int passed = lst != NULL;
+    for (int i = 0; i < 128 && passed; i++) {
+        point p = {i, -i};
+        passed = lst->insert(lst, &p, i) == OVA_SUCCESS;
+    }
+    /* The list owns copies, stored back to back. */
+    point *first = lst->get(lst, 0);
+    for (int i = 0; i < 128 && passed; i++) {
+        point *p = lst->get(lst, i);
+        passed = p == &first[i] && p->x == i && p->y == -i;
+    }
+    print_test_result(passed, "Array list of values copies elements into contiguous storage");
+
+    /* Inserting an element of the list itself while the list is full. */
+    passed = lst->insert(lst, lst->get(lst, 127), 0) == OVA_SUCCESS;
+    passed &= lst->insert(lst, lst->get(lst, 1), 129) == OVA_SUCCESS;
+    passed &= lst->size(lst) == 130 && ((point *)lst->get(lst, 129))->x == 0;
+    passed &= lst->remove_range(lst, 4, 129) == OVA_SUCCESS;
+    double expected_x[] = {127, 0, 1, 2, 0};
+    passed &= lst->size(lst) == 5;
+    for (int i = 0; i < 5 && passed; i++) {
+        passed = ((point *)lst->get(lst, i))->x == expected_x[i];
+    }
+    print_test_result(passed, "Array list of values can insert its own elements");
+
+    list *copy = lst->clone_shallow(lst);
+    list *deep = lst->clone_deep(lst, NULL);
+    passed = copy && deep && copy->size(copy) == 5 && copy->get(copy, 0) != lst->get(lst, 0);
+    for (int i = 0; i < 5 && passed; i++) {
+        passed = memcmp(copy->get(copy, i), lst->get(lst, i), sizeof(point)) == 0 &&
+                 memcmp(deep->get(deep, i), lst->get(lst, i), sizeof(point)) == 0;
+    }
+    void **span = NULL;
+    int span_len = 0;
+    passed &= lst->data_span(lst, &span, &span_len) == OVA_ERROR_INVALID_ARG;
+    passed &= create_list_of(LINKED_LIST, sizeof(point), 4) == NULL;
+    passed &= create_list_of(ARRAY_LIST, 0, 4) == NULL;
+    passed &= lst->insert(lst, NULL, 0) == OVA_ERROR_INVALID_ARG;
+    print_test_result(passed, "Array list of values clones by value and rejects bad arguments");
+
+    if (copy) copy->free(copy);
+    if (deep) deep->free(deep);
+    lst->free(lst);
+}
+
 void run_all_tests(void) {
     test_safe_double_capacity_normal();
     test_safe_double_capacity_overflow_protection();
@@ -279,6 +387,8 @@ void run_all_tests(void) {
     test_array_list_insert_error_codes();
     test_array_list_remove_error_codes();
     test_array_list_bulk_insert_error_codes();
+    test_array_list_range_operations();
+    test_array_list_of_values();
     //test_list_clear();
     //test_high_volume_array_list_insertions();
 }
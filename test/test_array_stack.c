@@ -72,12 +72,34 @@ void test_stack_push_error_codes(void) {
     stk->free(stk);
 }
 
+void test_stack_of_values(void) {
+    stack *stk = create_stack_of(ARRAY_STACK, sizeof(int));
+    int passed = stk != NULL;
+    for (int i = 0; i < 100 && passed; i++) {
+        passed = stk->push(stk, &i) == OVA_SUCCESS;
+    }
+    passed &= *(int *)stk->top(stk) == 99 && stk->size(stk) == 100;
+
+    stack *copy = stk->clone_deep(stk, NULL);
+    for (int i = 99; i >= 0 && passed; i--) {
+        passed = *(int *)stk->pop(stk) == i;
+    }
+    passed &= stk->is_empty(stk) && stk->pop(stk) == NULL;
+    passed &= copy && copy->size(copy) == 100 && *(int *)copy->top(copy) == 99;
+    passed &= create_stack_of(LINKED_STACK, sizeof(int)) == NULL;
+    print_test_result(passed, "Stack of values pushes copies and pops them in LIFO order");
+
+    if (copy) copy->free(copy);
+    stk->free(stk);
+}
+
 void run_all_tests(void) {
     test_linked_stack_push_pop();
     test_linked_stack_empty_after_pop();
     test_stack_top_behavior();
     test_stack_high_volume();
     test_stack_push_error_codes();
+    test_stack_of_values();
 }
 
 int main(void) {
@@ -80,6 +80,37 @@ void test_heap_put_error_codes(void) {
     h->free(h);
 }
 
+void test_heap_of_values(void) {
+    heap *values = create_heap_of(BINARY_HEAP, sizeof(int), 2, int_compare);
+    int passed = values != NULL;
+    long long sum = 0;
+    unsigned int state = 99u;
+    for (int i = 0; i < 500 && passed; i++) {
+        state = state * 1103515245u + 12345u;
+        int value = (int)((state >> 8) % 1000u);
+        sum += value;
+        passed = values->put(values, &value) == OVA_SUCCESS;
+    }
+    passed &= values->size(values) == 500;
+    int previous = *(int *)values->peek(values);
+    for (int i = 0; i < 499 && passed; i++) {
+        int current = *(int *)values->pop(values);
+        passed = int_compare(&previous, &current) >= 0;
+        previous = current;
+        sum -= current;
+    }
+    passed &= values->size(values) == 1;
+    int *last = values->pop(values);
+    passed &= last && int_compare(&previous, last) >= 0;
+    sum -= last ? *last : 0;
+    passed &= values->size(values) == 0 && values->pop(values) == NULL && sum == 0;
+    passed &= create_heap_of(FIBONACCI_HEAP, sizeof(int), 4, int_compare) == NULL;
+    passed &= values->put(values, NULL) == OVA_ERROR_INVALID_ARG;
+    print_test_result(passed, "Heap of values pops copies in comparator order");
+
+    if (values) values->free(values);
+}
+
 void run_all_heap_tests(void) {
     test_safe_double_capacity_for_binary_heap();
     test_heap_insert_and_extract_max();
@@ -88,6 +119,7 @@ void run_all_heap_tests(void) {
     test_heap_pop_empty();
     test_heap_high_volume();
     test_heap_put_error_codes();
+    test_heap_of_values();
 }
 
 int main(void) {
@@ -0,0 +1,265 @@
+#include "base_test.h"
+#include "../include/bitset.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/*  Basic operations                                                   */
+/* ------------------------------------------------------------------ */
+
+static void test_add_remove_contains(void) {
+    bitset *bs = create_bitset(0);
+    assert_not_null(bs);
+
+    int ok = bitset_add(bs, 0) && bitset_add(bs, 63) && bitset_add(bs, 64);
+    ok &= !bitset_add(bs, 63);
+    ok &= bitset_contains(bs, 0) && bitset_contains(bs, 63) && bitset_contains(bs, 64);
+    ok &= !bitset_contains(bs, 1) && !bitset_contains(bs, 100000);
+    ok &= bitset_size(bs) == 3;
+    print_test_result(ok, "bitset_add reports novelty and contains sees each bit");
+
+    ok = bitset_add(bs, 100000) && bitset_capacity(bs) > 100000 && bitset_size(bs) == 4;
+    ok &= bitset_remove(bs, 63) && !bitset_remove(bs, 63) && !bitset_remove(bs, 5000000);
+    ok &= !bitset_contains(bs, 63) && bitset_size(bs) == 3;
+    print_test_result(ok, "bitset grows on demand and removes bits once");
+
+    bitset_clear(bs);
+    ok = bitset_size(bs) == 0 && !bitset_contains(bs, 0) && bitset_capacity(bs) > 100000;
+    print_test_result(ok, "bitset_clear empties the set and keeps its capacity");
+
+    bitset_free(bs);
+}
+
+static void test_null_safety(void) {
+    size_t out = 0;
+    int ok = !bitset_add(NULL, 1) && !bitset_remove(NULL, 1) && !bitset_contains(NULL, 1);
+    ok &= bitset_size(NULL) == 0 && bitset_capacity(NULL) == 0;
+    ok &= bitset_reserve(NULL, 1) == OVA_ERROR_INVALID_ARG;
+    ok &= bitset_union_into(NULL, NULL) == OVA_ERROR_INVALID_ARG;
+    ok &= bitset_rank(NULL, 1) == 0 && !bitset_select(NULL, 0, &out) && !bitset_next(NULL, 0, &out);
+    ok &= bitset_clone(NULL) == NULL && bitset_serialized_size(NULL) == 0;
+    ok &= bitset_deserialize(NULL, 0) == NULL;
+    bitset_intersect_into(NULL, NULL);
+    bitset_difference_into(NULL, NULL);
+    bitset_clear(NULL);
+    bitset_free(NULL);
+    print_test_result(ok, "bitset functions tolerate NULL arguments");
+}
+
+/* ------------------------------------------------------------------ */
+/*  Bulk operations                                                    */
+/* ------------------------------------------------------------------ */
+
+enum { UNIVERSE = 5000 };
+
+static uint64_t next_random(uint64_t *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 33;
+}
+
+/* Fill @p bs and @p model with roughly one bit in @p every below @p limit. */
+static void fill_random(bitset *bs, bool *model, size_t limit, unsigned every, uint64_t *state) {
+    for (size_t i = 0; i < limit; i++) {
+        if (next_random(state) % every == 0) {
+            bitset_add(bs, i);
+            model[i] = true;
+        }
+    }
+}
+
+static int matches_model(const bitset *bs, const bool *model) {
+    size_t count = 0;
+    for (size_t i = 0; i < UNIVERSE; i++) {
+        if (bitset_contains(bs, i) != model[i]) {
+            return 0;
+        }
+        count += model[i] ? 1 : 0;
+    }
+    return bitset_size(bs) == count;
+}
+
+/*
+ * Operands of different lengths, so both the vector bodies and the scalar
+ * tails run and the shorter side's missing words count as zero.
+ */
+static void test_set_operations_match_model(void) {
+    static bool a_model[UNIVERSE], b_model[UNIVERSE], expect[UNIVERSE];
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    int ok = 1;
+
+    for (int round = 0; round < 3; round++) {
+        memset(a_model, 0, sizeof(a_model));
+        memset(b_model, 0, sizeof(b_model));
+        bitset *a = create_bitset(0);
+        bitset *b = create_bitset(0);
+        assert_not_null(a);
+        assert_not_null(b);
+        size_t a_limit = round == 1 ? UNIVERSE / 3 : UNIVERSE;
+        size_t b_limit = round == 2 ? UNIVERSE / 5 : UNIVERSE - 7;
+        fill_random(a, a_model, a_limit, 3, &state);
+        fill_random(b, b_model, b_limit, 4, &state);
+
+        bitset *u = bitset_clone(a);
+        bitset *x = bitset_clone(a);
+        bitset *d = bitset_clone(a);
+        assert_not_null(u);
+        assert_not_null(x);
+        assert_not_null(d);
+        ok &= bitset_union_into(u, b) == OVA_SUCCESS;
+        bitset_intersect_into(x, b);
+        bitset_difference_into(d, b);
+
+        for (size_t i = 0; i < UNIVERSE; i++) {
+            expect[i] = a_model[i] || b_model[i];
+        }
+        ok &= matches_model(u, expect);
+        for (size_t i = 0; i < UNIVERSE; i++) {
+            expect[i] = a_model[i] && b_model[i];
+        }
+        ok &= matches_model(x, expect);
+        for (size_t i = 0; i < UNIVERSE; i++) {
+            expect[i] = a_model[i] && !b_model[i];
+        }
+        ok &= matches_model(d, expect);
+        ok &= matches_model(a, a_model);
+
+        bitset_free(a);
+        bitset_free(b);
+        bitset_free(u);
+        bitset_free(x);
+        bitset_free(d);
+    }
+    print_test_result(ok, "bitset union, intersection and difference match a model");
+}
+
+/* ------------------------------------------------------------------ */
+/*  Rank, select and scanning                                          */
+/* ------------------------------------------------------------------ */
+
+static void test_rank_select_next(void) {
+    static bool model[UNIVERSE];
+    memset(model, 0, sizeof(model));
+    uint64_t state = 0x2545f4914f6cdd1dULL;
+    bitset *bs = create_bitset(0);
+    assert_not_null(bs);
+    fill_random(bs, model, UNIVERSE, 7, &state);
+
+    int ok = 1;
+    size_t rank = 0;
+    for (size_t i = 0; i < UNIVERSE && ok; i++) {
+        ok &= bitset_rank(bs, i) == rank;
+        if (model[i]) {
+            size_t pos = 0;
+            ok &= bitset_select(bs, rank, &pos) && pos == i;
+            rank++;
+        }
+    }
+    size_t pos = 0;
+    ok &= !bitset_select(bs, rank, &pos) && bitset_rank(bs, UNIVERSE * 4) == rank;
+    print_test_result(ok, "bitset_rank and bitset_select invert each other");
+
+    /* Mutations must invalidate the cached rank index. */
+    bitset_add(bs, 3);
+    bitset_remove(bs, 3);
+    bitset_add(bs, 2);
+    model[2] = true;
+    size_t below = 0;
+    for (size_t i = 0; i < 4000; i++) {
+        below += model[i] ? 1 : 0;
+    }
+    ok = bitset_rank(bs, 4000) == below;
+    ok &= bitset_select(bs, 0, &pos) && pos == (model[0] ? 0u : model[1] ? 1u : 2u);
+    print_test_result(ok, "bitset rank index is rebuilt after mutation");
+
+    ok = 1;
+    size_t from = 0;
+    size_t visited = 0;
+    while (bitset_next(bs, from, &pos)) {
+        ok &= model[pos];
+        for (size_t i = from; i < pos; i++) {
+            ok &= !model[i];
+        }
+        visited++;
+        from = pos + 1;
+    }
+    print_test_result(ok && visited == bitset_size(bs), "bitset_next scans set bits in ascending order");
+
+    bitset_free(bs);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Serialization                                                      */
+/* ------------------------------------------------------------------ */
+
+static int round_trips(const bitset *bs) {
+    size_t size = bitset_serialized_size(bs);
+    unsigned char *buf = (unsigned char *)malloc(size);
+    if (!buf) {
+        return 0;
+    }
+    int ok = bitset_serialize(bs, buf, size - 1) == 0;
+    ok &= bitset_serialize(bs, buf, size) == size;
+    bitset *copy = bitset_deserialize(buf, size);
+    ok &= copy != NULL && bitset_size(copy) == bitset_size(bs);
+    size_t pos = 0;
+    size_t from = 0;
+    while (ok && bitset_next(bs, from, &pos)) {
+        ok &= bitset_contains(copy, pos);
+        from = pos + 1;
+    }
+    bitset_free(copy);
+    free(buf);
+    return ok;
+}
+
+static void test_serialize_round_trip(void) {
+    bitset *dense = create_bitset(0);
+    bitset *sparse = create_bitset(0);
+    bitset *empty = create_bitset(128);
+    assert_not_null(dense);
+    assert_not_null(sparse);
+    assert_not_null(empty);
+    for (size_t i = 0; i < 4096; i += 2) {
+        bitset_add(dense, i);
+    }
+    bitset_add(sparse, 7);
+    bitset_add(sparse, 70000);
+    bitset_add(sparse, 1000000);
+
+    int ok = round_trips(dense) && round_trips(sparse) && round_trips(empty);
+    ok &= bitset_serialized_size(sparse) < 32;
+    ok &= bitset_serialized_size(dense) < 4096 / 8 + 16;
+    print_test_result(ok, "bitset serialization round-trips dense, sparse and empty sets");
+
+    size_t size = bitset_serialized_size(sparse);
+    unsigned char buf[64];
+    bitset_serialize(sparse, buf, sizeof(buf));
+    ok = bitset_deserialize(buf, size - 1) == NULL;
+    buf[0] = 'X';
+    ok &= bitset_deserialize(buf, size) == NULL;
+    buf[0] = 'O';
+    buf[4] = 99;
+    ok &= bitset_deserialize(buf, size) == NULL;
+    print_test_result(ok, "bitset_deserialize rejects truncated or corrupt input");
+
+    bitset_free(dense);
+    bitset_free(sparse);
+    bitset_free(empty);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Runner                                                             */
+/* ------------------------------------------------------------------ */
+
+static void run_all_tests(void) {
+    test_add_remove_contains();
+    test_null_safety();
+    test_set_operations_match_model();
+    test_rank_select_next();
+    test_serialize_round_trip();
+}
+
+int main(void) {
+    run_all_tests();
+    return 0;
+}
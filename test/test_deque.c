@@ -397,6 +397,40 @@ void test_deque_push_error_codes(void) {
     d->free(d);
 }
 
+void test_deque_of_values(void) {
+    deque *d = create_deque_of(sizeof(long long), 2);
+    int passed = d != NULL;
+    /* Alternate ends so the ring wraps while growing. */
+    for (long long i = 0; i < 1000 && passed; i++) {
+        passed = (i % 2 ? d->push_back(d, &i) : d->push_front(d, &i)) == OVA_SUCCESS;
+    }
+    passed &= d->size(d) == 1000;
+    passed &= *(long long *)d->peek_front(d) == 998 && *(long long *)d->peek_back(d) == 999;
+    passed &= *(long long *)d->get(d, 500) == 1;
+    print_test_result(passed, "Deque of values stores copies at both ends");
+
+    /* Push an element of the deque itself while it regrows. */
+    while (d->size(d) < 1024) {
+        d->push_back(d, d->peek_front(d));
+    }
+    passed = d->push_back(d, d->get(d, 1)) == OVA_SUCCESS;
+    passed &= *(long long *)d->peek_back(d) == 996;
+
+    deque *copy = d->clone_shallow(d);
+    passed &= copy && copy->size(copy) == d->size(d) && copy->get(copy, 0) != d->get(d, 0);
+    for (int i = 0; i < d->size(d) && passed; i++) {
+        passed = *(long long *)copy->get(copy, i) == *(long long *)d->get(d, i);
+    }
+    long long front = *(long long *)d->pop_front(d);
+    long long back = *(long long *)d->pop_back(d);
+    passed &= front == 998 && back == 996 && d->size(d) == 1023;
+    passed &= create_deque_of(0, 4) == NULL && d->push_back(d, NULL) == OVA_ERROR_INVALID_ARG;
+    print_test_result(passed, "Deque of values handles self-insertion, clones and pops");
+
+    if (copy) copy->free(copy);
+    d->free(d);
+}
+
 void run_all_deque_tests(void) {
     test_safe_double_capacity_for_deque();
     test_deque_create();
@@ -418,6 +452,7 @@ void run_all_deque_tests(void) {
     test_deque_with_string_data();
     test_deque_alternating_operations();
     test_deque_push_error_codes();
+    test_deque_of_values();
 }
 
 int main(void) {
@@ -1,5 +1,6 @@
 #include "base_test.h"
 #include "../include/map.h"
+#include "../src/map/map_internal.h"
 #include "../src/utils/capacity_utils.h"
 #include <limits.h>
 #include <pthread.h>
@@ -402,6 +403,888 @@ void test_map_put_error_codes(void) {
     m->free(m);
 }
 
+void test_flat_map_basic_operations(void) {
+    map *m = create_map(HASH_MAP_FLAT, 10, NULL, string_compare);
+    char k1[] = "alpha", k2[] = "beta", k3[] = "gamma";
+    char v1[] = "1", v2[] = "2", v3[] = "3", v4[] = "4";
+
+    print_test_result(m != NULL, "Flat map creation succeeds");
+    m->put(m, k1, v1);
+    m->put(m, k2, v2);
+    m->put(m, k3, v3);
+    m->put(m, k1, v4);
+
+    char lookup[] = "alpha";
+    print_test_result(m->size(m) == 3, "Flat map size counts distinct keys");
+    print_test_result(m->get(m, lookup) == v4, "Flat map update replaces the value");
+    print_test_result(m->remove(m, k2) == v2 && m->get(m, k2) == NULL, "Flat map remove returns the value");
+    print_test_result(m->size(m) == 2, "Flat map size drops after remove");
+
+    m->put(m, NULL, v1);
+    print_test_result(m->get(m, NULL) == v1, "Flat map stores a NULL key");
+    print_test_result(m->remove(m, NULL) == v1, "Flat map removes a NULL key");
+
+    m->clear(m);
+    print_test_result(m->size(m) == 0 && m->get(m, k3) == NULL, "Flat map clear empties the table");
+    m->free(m);
+}
+
+void test_flat_map_growth(void) {
+    map *m = create_map(HASH_MAP_FLAT, 10, int_hash, int_compare);
+    enum { N = 5000 };
+    int *keys = malloc(N * sizeof(int));
+    for (int i = 0; i < N; i++) {
+        keys[i] = i * 7;
+        m->put(m, &keys[i], &keys[i]);
+    }
+
+    int ok = m->size(m) == N;
+    for (int i = 0; i < N; i++) {
+        int probe = i * 7;
+        if (m->get(m, &probe) != &keys[i]) {
+            ok = 0;
+        }
+    }
+    print_test_result(ok, "Flat map keeps every entry across growth");
+    print_test_result(m->capacity(m) >= N, "Flat map capacity grows with size");
+    m->free(m);
+    free(keys);
+}
+
+void test_flat_map_collision_removal(void) {
+    map *m = create_map(HASH_MAP_FLAT, 10, constant_hash, int_compare);
+    enum { N = 64 };
+    int keys[N];
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+        m->put(m, &keys[i], &keys[i]);
+    }
+
+    /* Every key shares one probe run; removing from the middle must shift
+     * the tail back without losing reachability. */
+    for (int i = 0; i < N; i += 3) {
+        m->remove(m, &keys[i]);
+    }
+
+    int ok = 1;
+    for (int i = 0; i < N; i++) {
+        void *found = m->get(m, &keys[i]);
+        if ((i % 3 == 0) ? found != NULL : found != &keys[i]) {
+            ok = 0;
+        }
+    }
+    print_test_result(ok, "Flat map removal inside a collision run keeps other keys reachable");
+    m->free(m);
+}
+
+void test_flat_map_matches_chained_map(void) {
+    map *flat = create_map(HASH_MAP_FLAT, 10, int_hash, int_compare);
+    map *chained = create_map(HASH_MAP, 10, int_hash, int_compare);
+    enum { KEYS = 512, OPS = 20000 };
+    int keys[KEYS];
+    for (int i = 0; i < KEYS; i++) {
+        keys[i] = i;
+    }
+
+    int ok = 1;
+    srand(42);
+    for (int op = 0; op < OPS && ok; op++) {
+        int *k = &keys[rand() % KEYS];
+        switch (rand() % 3) {
+            case 0:
+                flat->put(flat, k, k);
+                chained->put(chained, k, k);
+                break;
+            case 1:
+                ok = flat->remove(flat, k) == chained->remove(chained, k);
+                break;
+            default:
+                ok = flat->get(flat, k) == chained->get(chained, k);
+                break;
+        }
+        if (flat->size(flat) != chained->size(chained)) {
+            ok = 0;
+        }
+    }
+    print_test_result(ok, "Flat map agrees with chained map under random put/get/remove");
+    flat->free(flat);
+    chained->free(chained);
+}
+
+void test_flat_map_clone(void) {
+    map *m = create_map(HASH_MAP_FLAT, 10, NULL, string_compare);
+    char k1[] = "one", k2[] = "two";
+    char v1[] = "1", v2[] = "2";
+    m->put(m, k1, v1);
+    m->put(m, k2, v2);
+
+    map *copy = m->clone_shallow(m);
+    print_test_result(copy && copy->size(copy) == 2 && copy->get(copy, k2) == v2,
+                      "Flat map shallow clone shares entries");
+    copy->remove(copy, k1);
+    print_test_result(m->get(m, k1) == v1, "Flat map clone is independent of the original");
+
+    copy->free(copy);
+    m->free(m);
+}
+
+static int hash64_calls = 0;
+static int counted_compare_calls = 0;
+
+static uint64_t counted_int_hash64(const void *key) {
+    hash64_calls++;
+    uint64_t x = (uint64_t)(unsigned int)*(const int *)key;
+    x *= 0x9E3779B97F4A7C15ULL;
+    return x ^ (x >> 29);
+}
+
+static int counted_int_compare(const void *a, const void *b) {
+    counted_compare_calls++;
+    return int_compare(a, b);
+}
+
+static void check_hash64_backend(map_type type, const char *label) {
+    map *m = create_map_hash64(type, 10, counted_int_hash64, counted_int_compare);
+    enum { N = 2000 };
+    int *keys = malloc(N * sizeof(int));
+    char msg[128];
+
+    hash64_calls = 0;
+    counted_compare_calls = 0;
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+        m->put(m, &keys[i], &keys[i]);
+    }
+    snprintf(msg, sizeof(msg), "%s: growth never re-hashes stored keys", label);
+    print_test_result(hash64_calls == N, msg);
+    snprintf(msg, sizeof(msg), "%s: distinct hashes skip the comparator on insert", label);
+    print_test_result(counted_compare_calls == 0, msg);
+
+    counted_compare_calls = 0;
+    int ok = 1;
+    for (int i = 0; i < N; i++) {
+        if (m->get(m, &keys[i]) != &keys[i]) {
+            ok = 0;
+        }
+    }
+    snprintf(msg, sizeof(msg), "%s: lookups find every key", label);
+    print_test_result(ok, msg);
+    snprintf(msg, sizeof(msg), "%s: each hit costs at most one comparator call", label);
+    print_test_result(counted_compare_calls <= N, msg);
+
+    m->free(m);
+    free(keys);
+}
+
+void test_map_hash64_api(void) {
+    check_hash64_backend(HASH_MAP, "Chained hash64 map");
+    check_hash64_backend(HASH_MAP_FLAT, "Flat hash64 map");
+
+    map *m = create_map_hash64(HASH_TABLE, 10, NULL, string_compare);
+    char key[] = "default";
+    char value[] = "value";
+    m->put(m, key, value);
+    char probe[] = "default";
+    print_test_result(m->get(m, probe) == value, "Hash64 map defaults to hashing C strings");
+    m->free(m);
+
+    char a[] = "abc";
+    print_test_result(fnv1a_hash64(a) == 0xe71fa2190541574bULL && fnv1a_hash64(NULL) == 0,
+                      "fnv1a_hash64 matches the reference value");
+}
+
+static uint64_t identity_hash64(const void *key) {
+    return (uint64_t)(unsigned int)*(const int *)key;
+}
+
+/*
+ * Integer ids hashed by identity leave the high bits zero; the flat map's H2
+ * tag and the concurrent map's segment come from those bits.
+ */
+void test_map_identity_hash64(void) {
+    enum { N = 4096 };
+    int *keys = malloc(N * sizeof(int));
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+    }
+
+    map_hasher hasher = {NULL, identity_hash64};
+    bool tags[128] = {false};
+    bool segments[64] = {false}; /* The concurrent map's top 6 bits */
+    int tag_count = 0;
+    int segment_count = 0;
+    for (int i = 0; i < N; i++) {
+        uint64_t hash = map_hasher_apply(&hasher, &keys[i]);
+        size_t tag = (size_t)(hash >> 57);
+        size_t segment = (size_t)(hash >> 58);
+        tag_count += !tags[tag];
+        segment_count += !segments[segment];
+        tags[tag] = true;
+        segments[segment] = true;
+    }
+    print_test_result(tag_count == 128 && segment_count == 64,
+                      "Identity hash64 results are mixed into the high bits");
+
+    map_type types[] = {HASH_MAP, HASH_MAP_FLAT, HASH_MAP_CONCURRENT};
+    int ok = 1;
+    for (int t = 0; t < 3; t++) {
+        map *m = create_map_hash64(types[t], 16, identity_hash64, int_compare);
+        for (int i = 0; i < N; i++) {
+            ok &= m->put(m, &keys[i], &keys[i]) == OVA_SUCCESS;
+        }
+        for (int i = 0; i < N; i += 2) {
+            ok &= m->remove(m, &keys[i]) == &keys[i];
+        }
+        for (int i = 0; i < N; i++) {
+            ok &= m->get(m, &keys[i]) == (i % 2 ? &keys[i] : NULL);
+        }
+        ok &= m->size(m) == N / 2;
+        m->free(m);
+    }
+    print_test_result(ok, "Chained, flat and concurrent maps work with an identity hash64");
+    free(keys);
+}
+
+typedef struct {
+    map *m;
+    int *keys;
+    int count;
+    int worker;
+    int workers;
+    int mismatches;
+} concurrent_mix_arg;
+
+static void *concurrent_mix_worker(void *arg) {
+    concurrent_mix_arg *a = (concurrent_mix_arg *)arg;
+    for (int round = 0; round < 4; round++) {
+        for (int i = a->worker; i < a->count; i += a->workers) {
+            a->m->put(a->m, &a->keys[i], &a->keys[i]);
+        }
+        for (int i = 0; i < a->count; i++) {
+            void *found = a->m->get(a->m, &a->keys[i]);
+            if (found && found != &a->keys[i]) {
+                a->mismatches++;
+            }
+        }
+        for (int i = a->worker; i < a->count; i += a->workers) {
+            if (round < 3 && a->m->remove(a->m, &a->keys[i]) != &a->keys[i]) {
+                a->mismatches++;
+            }
+        }
+    }
+    return NULL;
+}
+
+void test_concurrent_map_mode(void) {
+    map *m = create_map(HASH_MAP_CONCURRENT, 64, int_hash, int_compare);
+    print_test_result(m != NULL, "Concurrent map creation succeeds");
+
+    enum { COUNT = 4000, WORKERS = 8 };
+    int *keys = malloc(COUNT * sizeof(int));
+    for (int i = 0; i < COUNT; i++) {
+        keys[i] = i;
+    }
+
+    pthread_t threads[WORKERS];
+    concurrent_mix_arg args[WORKERS];
+    for (int w = 0; w < WORKERS; w++) {
+        args[w] = (concurrent_mix_arg){m, keys, COUNT, w, WORKERS, 0};
+        pthread_create(&threads[w], NULL, concurrent_mix_worker, &args[w]);
+    }
+
+    int mismatches = 0;
+    for (int w = 0; w < WORKERS; w++) {
+        pthread_join(threads[w], NULL);
+        mismatches += args[w].mismatches;
+    }
+    print_test_result(mismatches == 0, "Concurrent map readers only see consistent values");
+    print_test_result(m->size(m) == COUNT, "Concurrent map keeps every key written in the last round");
+
+    int ok = 1;
+    for (int i = 0; i < COUNT; i++) {
+        if (m->get(m, &keys[i]) != &keys[i]) {
+            ok = 0;
+        }
+    }
+    print_test_result(ok, "Concurrent map resolves every key after the writers finish");
+
+    map *copy = m->clone_shallow(m);
+    print_test_result(copy && copy->size(copy) == COUNT && copy->get(copy, &keys[7]) == &keys[7],
+                      "Concurrent map clone copies every segment");
+    copy->free(copy);
+
+    m->clear(m);
+    print_test_result(m->size(m) == 0 && m->get(m, &keys[0]) == NULL, "Concurrent map clear empties all segments");
+    m->free(m);
+    free(keys);
+}
+
+void test_incremental_map_matches_chained_map(void) {
+    map *inc = create_map(HASH_MAP_INCREMENTAL, 4, int_hash, int_compare);
+    map *chained = create_map(HASH_MAP, 4, int_hash, int_compare);
+    enum { KEYS = 4096, OPS = 60000 };
+    static int keys[KEYS];
+    for (int i = 0; i < KEYS; i++) {
+        keys[i] = i;
+    }
+
+    int ok = 1;
+    srand(7);
+    for (int op = 0; op < OPS && ok; op++) {
+        int *k = &keys[rand() % KEYS];
+        switch (rand() % 4) {
+            case 0:
+            case 1:
+                inc->put(inc, k, k);
+                chained->put(chained, k, k);
+                break;
+            case 2:
+                ok = inc->remove(inc, k) == chained->remove(chained, k);
+                break;
+            default:
+                ok = inc->get(inc, k) == chained->get(chained, k);
+                break;
+        }
+        if (inc->size(inc) != chained->size(chained)) {
+            ok = 0;
+        }
+    }
+    print_test_result(ok, "Incremental map agrees with chained map under random put/get/remove");
+    inc->free(inc);
+    chained->free(chained);
+}
+
+void test_incremental_map_mid_resize(void) {
+    map *m = create_map(HASH_MAP_INCREMENTAL, 20, int_hash, int_compare);
+    enum { N = 1000 };
+    static int keys[N];
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+        m->put(m, &keys[i], &keys[i]);
+    }
+
+    int found = 0;
+    for (int i = 0; i < N; i++) {
+        if (m->get(m, &keys[i]) == &keys[i]) {
+            found++;
+        }
+    }
+    print_test_result(found == N && m->size(m) == N,
+                      "Incremental map finds every key across resizes");
+
+    map *copy = m->clone_shallow(m);
+    int copied = copy ? copy->size(copy) : 0;
+    int copy_ok = copy && copy->get(copy, &keys[N - 1]) == &keys[N - 1];
+    print_test_result(copied == N && copy_ok, "Incremental map clone sees unmigrated entries");
+    if (copy) {
+        copy->free(copy);
+    }
+
+    m->clear(m);
+    print_test_result(m->size(m) == 0 && m->get(m, &keys[0]) == NULL,
+                      "Incremental map clear releases both tables");
+    m->put(m, &keys[1], &keys[1]);
+    print_test_result(m->get(m, &keys[1]) == &keys[1], "Incremental map is usable after clear");
+    m->free(m);
+}
+
+/*
+ * At a 0.10 load factor the next growth comes after few inserts; each
+ * resize must still be drained by the budgeted steps, never by the
+ * migrate-everything fallback at the start of the next one.
+ */
+void test_incremental_map_low_load_factor(void) {
+    map *m = create_map(HASH_MAP_INCREMENTAL, 16, int_hash, int_compare);
+    enum { N = 20000 };
+    int *keys = malloc(N * sizeof(int));
+    int ok = m->set_max_load_factor(m, 0.10) == OVA_SUCCESS;
+    map_impl *impl = map_impl_from_map(m);
+    int resizes = 0;
+    for (int i = 0; i < N && ok; i++) {
+        keys[i] = i;
+        int capacity = impl->capacity;
+        int pending = impl->old_buckets ? impl->old_capacity - impl->migrate_pos : 0;
+        int budget = impl->migrate_budget;
+        ok = m->put(m, &keys[i], &keys[i]) == OVA_SUCCESS;
+        if (impl->capacity != capacity) {
+            ok &= pending <= budget;
+            resizes++;
+        }
+    }
+    print_test_result(ok && resizes > 5, "Incremental map drains each resize before the next at load 0.10");
+
+    for (int i = 0; i < N && ok; i++) {
+        ok = m->get(m, &keys[i]) == &keys[i];
+    }
+    print_test_result(ok && m->size(m) == N, "Incremental map at load 0.10 finds every key");
+    m->free(m);
+    free(keys);
+}
+
+static void check_pooled_backend(map_type type, memory_pool *pool, const char *label) {
+    map *pooled = create_map_with_pool(type, 8, int_hash, int_compare, pool);
+    map *plain = create_map(HASH_MAP, 8, int_hash, int_compare);
+    enum { KEYS = 1024, OPS = 20000 };
+    static int keys[KEYS];
+    for (int i = 0; i < KEYS; i++) {
+        keys[i] = i;
+    }
+
+    int ok = pooled != NULL;
+    srand(11);
+    for (int op = 0; op < OPS && ok; op++) {
+        int *k = &keys[rand() % KEYS];
+        switch (rand() % 3) {
+            case 0:
+                ok = pooled->put(pooled, k, k) == OVA_SUCCESS;
+                plain->put(plain, k, k);
+                break;
+            case 1:
+                ok = pooled->remove(pooled, k) == plain->remove(plain, k);
+                break;
+            default:
+                ok = pooled->get(pooled, k) == plain->get(plain, k);
+                break;
+        }
+        ok = ok && pooled->size(pooled) == plain->size(plain);
+    }
+
+    map *copy = ok ? pooled->clone_shallow(pooled) : NULL;
+    int copy_ok = copy && copy->size(copy) == plain->size(plain);
+    if (copy) {
+        copy->free(copy);
+    }
+
+    if (pooled) {
+        pooled->clear(pooled);
+        ok = ok && pooled->size(pooled) == 0 && pooled->get(pooled, &keys[0]) == NULL;
+        ok = ok && pooled->put(pooled, &keys[3], &keys[3]) == OVA_SUCCESS &&
+             pooled->get(pooled, &keys[3]) == &keys[3];
+        pooled->free(pooled);
+    }
+    plain->free(plain);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%s: pooled entries behave like malloc'd entries", label);
+    print_test_result(ok && copy_ok, msg);
+}
+
+void test_map_with_pool(void) {
+    check_pooled_backend(HASH_MAP, NULL, "HASH_MAP slab");
+    check_pooled_backend(HASH_TABLE, NULL, "HASH_TABLE slab");
+    check_pooled_backend(HASH_MAP_INCREMENTAL, NULL, "HASH_MAP_INCREMENTAL slab");
+    check_pooled_backend(HASH_MAP_CONCURRENT, NULL, "HASH_MAP_CONCURRENT slab");
+    check_pooled_backend(HASH_MAP_FLAT, NULL, "HASH_MAP_FLAT pool ignored");
+
+    memory_pool *pool = create_memory_pool(64, 32);
+    check_pooled_backend(HASH_MAP, pool, "HASH_MAP caller pool");
+    print_test_result(memory_pool_active_count(pool) == 0,
+                      "Freed map returns every entry to the caller pool");
+    memory_pool_destroy(pool);
+
+    memory_pool *tiny = create_memory_pool(8, 4);
+    map *m = create_map_with_pool(HASH_MAP, 8, int_hash, int_compare, tiny);
+    print_test_result(m == NULL, "create_map_with_pool rejects an undersized pool");
+    memory_pool_destroy(tiny);
+}
+
+void test_map_pool_shrink_to_fit(void) {
+    enum { N = 20000, KEEP = 100 };
+    int *keys = malloc(N * sizeof(int));
+    map *m = create_map_with_pool(HASH_MAP, 8, int_hash, int_compare, NULL);
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+        m->put(m, &keys[i], &keys[i]);
+    }
+    for (int i = KEEP; i < N; i++) {
+        m->remove(m, &keys[i]);
+    }
+
+    /* The slab is replaced by one holding just the survivors. */
+    memory_pool *before = map_impl_from_map(m)->pool;
+    int ok = m->shrink_to_fit(m) == OVA_SUCCESS;
+    memory_pool *after = map_impl_from_map(m)->pool;
+    ok &= after != before && memory_pool_active_count(after) == KEEP && m->size(m) == KEEP;
+    for (int i = 0; i < N; i++) {
+        ok &= m->get(m, &keys[i]) == (i < KEEP ? &keys[i] : NULL);
+    }
+    for (int i = KEEP; i < 2 * KEEP; i++) {
+        ok &= m->put(m, &keys[i], &keys[i]) == OVA_SUCCESS;
+    }
+    ok &= m->size(m) == 2 * KEEP && m->get(m, &keys[KEEP]) == &keys[KEEP];
+    print_test_result(ok, "shrink_to_fit releases a private slab's unused entries");
+
+    /* No free blocks to give back: the slab is kept as is. */
+    before = map_impl_from_map(m)->pool;
+    ok = memory_pool_free_count(before) == 0 && m->shrink_to_fit(m) == OVA_SUCCESS;
+    ok &= map_impl_from_map(m)->pool == before && m->get(m, &keys[0]) == &keys[0];
+    print_test_result(ok, "shrink_to_fit keeps a slab with nothing to release");
+
+    map *c = create_map_with_pool(HASH_MAP_CONCURRENT, 8, int_hash, int_compare, NULL);
+    for (int i = 0; i < N; i++) {
+        c->put(c, &keys[i], &keys[i]);
+    }
+    for (int i = KEEP; i < N; i++) {
+        c->remove(c, &keys[i]);
+    }
+    ok = c->shrink_to_fit(c) == OVA_SUCCESS && c->size(c) == KEEP;
+    for (int i = 0; i < N; i++) {
+        ok &= c->get(c, &keys[i]) == (i < KEEP ? &keys[i] : NULL);
+    }
+    print_test_result(ok, "Concurrent map keeps its entries across a slab compaction");
+
+    c->free(c);
+    m->free(m);
+    free(keys);
+}
+
+static void check_bulk_backend(map_type type, const char *label) {
+    map *m = create_map(type, 8, int_hash, int_compare);
+    enum { N = 1000 };
+    static int keys[2 * N];
+    void *key_ptrs[2 * N];
+    void *values[2 * N];
+    for (int i = 0; i < 2 * N; i++) {
+        keys[i] = i;
+        key_ptrs[i] = &keys[i];
+    }
+
+    /* Even keys are stored; the batch repeats one key to exercise updates. */
+    void *even[N];
+    for (int i = 0; i < N; i++) {
+        even[i] = &keys[2 * i];
+    }
+    even[N - 1] = &keys[0];
+    int ok = m->put_bulk(m, even, even, N) == OVA_SUCCESS && m->size(m) == N - 1;
+
+    ok = ok && m->get_bulk(m, key_ptrs, values, 2 * N) == OVA_SUCCESS;
+    for (int i = 0; i < 2 * N - 2 && ok; i++) {
+        ok = values[i] == m->get(m, key_ptrs[i]) && (values[i] != NULL) == (i % 2 == 0);
+    }
+
+    ok = ok && m->remove_bulk(m, key_ptrs, values, N) == OVA_SUCCESS;
+    for (int i = 0; i < N && ok; i++) {
+        ok = values[i] == ((i % 2 == 0) ? key_ptrs[i] : NULL) && m->get(m, key_ptrs[i]) == NULL;
+    }
+    ok = ok && m->size(m) == N / 2 - 1;
+    ok = ok && m->remove_bulk(m, key_ptrs, NULL, 2 * N) == OVA_SUCCESS && m->size(m) == 0;
+
+    ok = ok && m->get_bulk(m, key_ptrs, NULL, 1) == OVA_ERROR_INVALID_ARG;
+    ok = ok && m->get_bulk(m, NULL, values, 1) == OVA_ERROR_INVALID_ARG;
+    ok = ok && m->remove_bulk(m, key_ptrs, values, 0) == OVA_ERROR_INVALID_ARG;
+    m->free(m);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%s: get_bulk/remove_bulk agree with get/remove", label);
+    print_test_result(ok, msg);
+}
+
+void test_map_bulk_operations(void) {
+    check_bulk_backend(HASH_MAP, "HASH_MAP");
+    check_bulk_backend(HASH_TABLE, "HASH_TABLE");
+    check_bulk_backend(HASH_MAP_INCREMENTAL, "HASH_MAP_INCREMENTAL");
+    check_bulk_backend(HASH_MAP_FLAT, "HASH_MAP_FLAT");
+    check_bulk_backend(HASH_MAP_CONCURRENT, "HASH_MAP_CONCURRENT");
+}
+
+static void check_capacity_controls(map_type type, const char *label) {
+    map *m = create_map(type, 8, int_hash, int_compare);
+    enum { N = 10000, KEEP = 10 };
+    static int keys[N];
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+    }
+
+    int ok = m->reserve(m, N) == OVA_SUCCESS;
+    int reserved = m->capacity(m);
+    ok = ok && reserved >= (int)(N / LOAD_FACTOR);
+    for (int i = 0; i < N && ok; i++) {
+        ok = m->put(m, &keys[i], &keys[i]) == OVA_SUCCESS;
+    }
+    if (type != HASH_MAP_CONCURRENT) {
+        ok = ok && m->capacity(m) == reserved;
+    }
+
+    for (int i = KEEP; i < N; i++) {
+        m->remove(m, &keys[i]);
+    }
+    ok = ok && m->shrink_to_fit(m) == OVA_SUCCESS && m->capacity(m) < reserved / 8;
+    for (int i = 0; i < KEEP && ok; i++) {
+        ok = m->get(m, &keys[i]) == &keys[i];
+    }
+    ok = ok && m->size(m) == KEEP;
+
+    ok = ok && m->set_max_load_factor(m, 0.5) == OVA_SUCCESS && m->max_load_factor(m) == 0.5;
+    for (int i = KEEP; i < N && ok; i++) {
+        ok = m->put(m, &keys[i], &keys[i]) == OVA_SUCCESS;
+    }
+    ok = ok && m->size(m) <= m->capacity(m) / 2 + 64;
+
+    ok = ok && m->set_max_load_factor(m, 0.0) == OVA_ERROR_INVALID_ARG;
+    ok = ok && m->set_max_load_factor(m, 1.5) == OVA_ERROR_INVALID_ARG;
+    ok = ok && m->reserve(m, -1) == OVA_ERROR_INVALID_ARG;
+    ok = ok && m->max_load_factor(m) == 0.5;
+
+    map *copy = m->clone_shallow(m);
+    ok = ok && copy && copy->max_load_factor(copy) == 0.5;
+    if (copy) {
+        copy->free(copy);
+    }
+    m->free(m);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%s: reserve, shrink_to_fit and load factor control", label);
+    print_test_result(ok, msg);
+}
+
+void test_map_capacity_controls(void) {
+    check_capacity_controls(HASH_MAP, "HASH_MAP");
+    check_capacity_controls(HASH_TABLE, "HASH_TABLE");
+    check_capacity_controls(HASH_MAP_INCREMENTAL, "HASH_MAP_INCREMENTAL");
+    check_capacity_controls(HASH_MAP_FLAT, "HASH_MAP_FLAT");
+    check_capacity_controls(HASH_MAP_CONCURRENT, "HASH_MAP_CONCURRENT");
+
+    map *flat = create_map(HASH_MAP_FLAT, 16, int_hash, int_compare);
+    int capacity = flat->capacity(flat);
+    print_test_result(flat->reserve(flat, INT_MAX) == OVA_ERROR_FULL && flat->capacity(flat) == capacity,
+                      "HASH_MAP_FLAT: reserve past the largest table reports OVA_ERROR_FULL");
+    flat->free(flat);
+}
+
+static void count_visitor(void *key, void *value, void *ctx) {
+    (void)key;
+    (void)value;
+    (*(int *)ctx)++;
+}
+
+static void check_map_iteration(map *m, int n, const char *label) {
+    int total = 0;
+    m->for_each(m, count_visitor, &total);
+
+    static int seen[4096];
+    memset(seen, 0, sizeof(seen));
+    int visits = 0;
+    int ok = 1;
+    map_iterator it;
+    m->iter_begin(m, &it);
+    while (m->iter_next(m, &it)) {
+        int k = *(int *)it.key;
+        ok = ok && it.value == it.key;
+        seen[k]++;
+        visits++;
+        if (k % 2 != 0) {
+            ok = ok && m->iter_remove(m, &it) == it.key;
+            ok = ok && m->iter_remove(m, &it) == NULL;
+        }
+    }
+
+    ok = ok && total == n && visits == n && m->size(m) == (n + 1) / 2;
+    for (int i = 0; i < n && ok; i++) {
+        ok = seen[i] == 1;
+    }
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%s: cursor visits each entry once and removes in place", label);
+    print_test_result(ok, msg);
+}
+
+/* Homes keys at key & mask so runs can be steered across the table end. */
+static uint64_t wrap_hash64(const void *key) {
+    return (uint64_t)(unsigned int)*(const int *)key << 7;
+}
+
+void test_map_iteration(void) {
+    enum { N = 3000 };
+    static int keys[N];
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+    }
+
+    const map_type types[] = {HASH_MAP, HASH_TABLE, HASH_MAP_INCREMENTAL, HASH_MAP_FLAT,
+                              HASH_MAP_CONCURRENT};
+    const char *labels[] = {"HASH_MAP", "HASH_TABLE", "HASH_MAP_INCREMENTAL", "HASH_MAP_FLAT",
+                            "HASH_MAP_CONCURRENT"};
+    for (int t = 0; t < 5; t++) {
+        map *m = create_map(types[t], 8, int_hash, int_compare);
+        for (int i = 0; i < N; i++) {
+            m->put(m, &keys[i], &keys[i]);
+        }
+        check_map_iteration(m, N, labels[t]);
+        m->free(m);
+    }
+
+    /* A run that wraps from the last slots of a 32-slot flat table to the
+     * first ones: removal shifts entries backward across the table end. */
+    static int wrap_keys[] = {30, 31, 62, 63, 94, 95, 126};
+    map *flat = create_map_hash64(HASH_MAP_FLAT, 20, wrap_hash64, int_compare);
+    for (int i = 0; i < 7; i++) {
+        flat->put(flat, &wrap_keys[i], &wrap_keys[i]);
+    }
+    int visits = 0;
+    map_iterator it;
+    flat->iter_begin(flat, &it);
+    while (flat->iter_next(flat, &it)) {
+        visits++;
+        flat->iter_remove(flat, &it);
+    }
+    print_test_result(visits == 7 && flat->size(flat) == 0 && flat->capacity(flat) == 32,
+                      "HASH_MAP_FLAT: removal across a wrapped run visits every entry once");
+    flat->free(flat);
+}
+
+/* Deterministic xorshift stream so the quality checks are reproducible. */
+static uint64_t quality_next(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/*
+ * Flip every input bit of many random keys and record how often each output
+ * bit changes. A well-mixed hash flips every output bit with probability
+ * close to one half, whichever input bit moved.
+ */
+static void check_avalanche(size_t len, const char *label) {
+    enum { SAMPLES = 200 };
+    unsigned char input[128];
+    long out_flips[64] = {0};
+    long in_flips[128 * 8] = {0};
+    uint64_t state = 0x243f6a8885a308d3ULL ^ (uint64_t)len;
+    size_t bits = len * 8;
+
+    for (int s = 0; s < SAMPLES; s++) {
+        for (size_t i = 0; i < len; i++) {
+            input[i] = (unsigned char)quality_next(&state);
+        }
+        uint64_t base = hash_bytes64(input, len, 0);
+        for (size_t bit = 0; bit < bits; bit++) {
+            input[bit / 8] ^= (unsigned char)(1u << (bit % 8));
+            uint64_t diff = base ^ hash_bytes64(input, len, 0);
+            input[bit / 8] ^= (unsigned char)(1u << (bit % 8));
+            for (int out = 0; out < 64; out++) {
+                long flipped = (long)((diff >> out) & 1u);
+                out_flips[out] += flipped;
+                in_flips[bit] += flipped;
+            }
+        }
+    }
+
+    double worst = 0.0;
+    double out_trials = (double)SAMPLES * (double)bits;
+    for (int out = 0; out < 64; out++) {
+        double bias = fabs((double)out_flips[out] / out_trials - 0.5);
+        worst = bias > worst ? bias : worst;
+    }
+    double in_trials = (double)SAMPLES * 64.0;
+    for (size_t bit = 0; bit < bits; bit++) {
+        double bias = fabs((double)in_flips[bit] / in_trials - 0.5);
+        worst = bias > worst ? bias : worst;
+    }
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s: every bit avalanches (worst bias %.3f)", label, worst);
+    print_test_result(worst < 0.05, msg);
+}
+
+/*
+ * Pearson chi-square of sequential "key%d" strings over @p buckets buckets.
+ * With buckets - 1 degrees of freedom a uniform hash stays well within six
+ * standard deviations, sqrt(2 * (buckets - 1)), of the mean.
+ */
+static int chi_square_uniform(uint32_t (*bucket_of)(char *, uint32_t), uint32_t buckets) {
+    const int keys = 65536;
+    long *counts = calloc(buckets, sizeof(long));
+    if (!counts) {
+        return 0;
+    }
+
+    char key[32];
+    for (int i = 0; i < keys; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        counts[bucket_of(key, buckets)]++;
+    }
+
+    double expected = (double)keys / (double)buckets;
+    double chi = 0.0;
+    for (uint32_t b = 0; b < buckets; b++) {
+        double delta = (double)counts[b] - expected;
+        chi += delta * delta / expected;
+    }
+    free(counts);
+
+    double dof = (double)(buckets - 1);
+    return chi < dof + 6.0 * sqrt(2.0 * dof);
+}
+
+static uint32_t wyhash_bucket(char *key, uint32_t buckets) {
+    return (uint32_t)(wyhash64(key) % buckets);
+}
+
+static uint32_t bernstein_bucket(char *key, uint32_t buckets) {
+    return (uint32_t)bernstein_hash(key, (int)buckets);
+}
+
+static uint32_t fnv1a_bucket(char *key, uint32_t buckets) {
+    return (uint32_t)fnv1a_hash(key, (int)buckets);
+}
+
+void test_hash_function_quality(void) {
+    check_avalanche(8, "hash_bytes64 8-byte keys");
+    check_avalanche(24, "hash_bytes64 24-byte keys");
+    check_avalanche(100, "hash_bytes64 100-byte keys");
+
+    print_test_result(chi_square_uniform(wyhash_bucket, 1024), "wyhash64 spreads sequential keys uniformly");
+    print_test_result(chi_square_uniform(bernstein_bucket, 1024),
+                      "bernstein_hash reduction spreads sequential keys uniformly");
+    print_test_result(chi_square_uniform(fnv1a_bucket, 1000),
+                      "fnv1a_hash reduction spreads keys over a non power-of-two range");
+
+    const hash_func_t legacy[] = {bernstein_hash, fnv1a_hash, xor_hash, rotational_hash, additive_hash};
+    int in_range = 1;
+    const int capacities[] = {1, 7, 1000, 1 << 20, INT_MAX};
+    char key[32];
+    for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++) {
+        for (int i = 0; i < 1000; i++) {
+            snprintf(key, sizeof(key), "k%d", i);
+            for (size_t f = 0; f < sizeof(legacy) / sizeof(legacy[0]); f++) {
+                int index = legacy[f](key, capacities[c]);
+                in_range &= index >= 0 && index < capacities[c];
+            }
+        }
+    }
+    print_test_result(in_range, "Legacy hashes stay within [0, capacity)");
+
+    unsigned char buffer[4096 + 8];
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (unsigned char)(i * 131u + 7u);
+    }
+    int stable = 1;
+    const size_t lengths[] = {0, 1, 3, 4, 8, 15, 16, 17, 48, 49, 96, 1000, 4096};
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t len = lengths[l];
+        uint64_t aligned = hash_bytes64(buffer, len, 0);
+        for (size_t offset = 1; offset < 8; offset++) {
+            unsigned char copy[4096];
+            memcpy(copy, buffer, len);
+            memmove(buffer + offset, copy, len);
+            stable &= hash_bytes64(buffer + offset, len, 0) == aligned;
+            memmove(buffer, copy, len);
+        }
+        stable &= hash_bytes64(buffer, len, 1) != aligned;
+    }
+    print_test_result(stable, "hash_bytes64 ignores alignment and depends on the seed");
+
+    char text[] = "hello, world";
+    char zeros[4] = {0};
+    print_test_result(wyhash64(text) == hash_bytes64(text, strlen(text), 0) && wyhash64(NULL) == 0 &&
+                          hash_bytes64(zeros, 1, 0) != hash_bytes64(zeros, 2, 0) &&
+                          hash_bytes64(NULL, 0, 0) == hash_bytes64(zeros, 0, 0),
+                      "wyhash64 hashes C strings and length changes the hash");
+}
+
 void run_all_tests(void) {
     test_safe_double_capacity_for_hash_map();
     test_insert_and_retrieve_single_item();
@@ -427,6 +1310,23 @@ void run_all_tests(void) {
     test_map_put_bulk_with_duplicate_keys();
     test_map_put_bulk_edge_cases();
     test_map_put_error_codes();
+    test_flat_map_basic_operations();
+    test_flat_map_growth();
+    test_flat_map_collision_removal();
+    test_flat_map_matches_chained_map();
+    test_flat_map_clone();
+    test_map_hash64_api();
+    test_map_identity_hash64();
+    test_concurrent_map_mode();
+    test_incremental_map_matches_chained_map();
+    test_incremental_map_mid_resize();
+    test_incremental_map_low_load_factor();
+    test_map_with_pool();
+    test_map_pool_shrink_to_fit();
+    test_map_bulk_operations();
+    test_map_capacity_controls();
+    test_map_iteration();
+    test_hash_function_quality();
 }
 
 int main(void) {
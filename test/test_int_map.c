@@ -0,0 +1,181 @@
+#include "base_test.h"
+#include "../include/int_map.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/*  Basic operations                                                   */
+/* ------------------------------------------------------------------ */
+
+static void test_put_get_update_remove(void) {
+    int_map *m = create_int_map(0);
+    assert_not_null(m);
+
+    int a = 1, b = 2;
+    void *out = NULL;
+    int ok = int_map_put(m, 42, &a) == OVA_SUCCESS;
+    ok &= int_map_get(m, 42, &out) && out == &a;
+    ok &= int_map_put(m, 42, &b) == OVA_SUCCESS && int_map_size(m) == 1;
+    ok &= int_map_get(m, 42, &out) && out == &b;
+    ok &= !int_map_contains(m, 43);
+    print_test_result(ok, "int_map stores, updates and looks up by value");
+
+    ok = int_map_remove(m, 42, &out) && out == &b;
+    ok &= !int_map_remove(m, 42, NULL) && int_map_size(m) == 0;
+    print_test_result(ok, "int_map_remove returns the value once");
+
+    int_map_free(m);
+}
+
+static void test_zero_and_extreme_keys(void) {
+    u64_map *m = create_u64_map(4);
+    assert_not_null(m);
+
+    uint64_t out = 0;
+    int ok = u64_map_put(m, 0, 10) == OVA_SUCCESS;
+    ok &= u64_map_put(m, UINT64_MAX, 20) == OVA_SUCCESS;
+    ok &= u64_map_get(m, 0, &out) && out == 10;
+    ok &= u64_map_get(m, UINT64_MAX, &out) && out == 20;
+    ok &= u64_map_size(m) == 2;
+    ok &= u64_map_remove(m, 0, &out) && out == 10 && !u64_map_contains(m, 0);
+    ok &= u64_map_size(m) == 1 && u64_map_contains(m, UINT64_MAX);
+    print_test_result(ok, "u64_map accepts 0 and UINT64_MAX as keys");
+
+    u64_map_free(m);
+}
+
+static void test_null_safety(void) {
+    int ok = int_map_put(NULL, 1, NULL) == OVA_ERROR_INVALID_ARG;
+    ok &= !int_map_get(NULL, 1, NULL) && !int_map_remove(NULL, 1, NULL);
+    ok &= int_map_size(NULL) == 0 && int_map_capacity(NULL) == 0;
+    ok &= int_map_reserve(NULL, 1) == OVA_ERROR_INVALID_ARG;
+    size_t cursor = 0;
+    ok &= !int_map_next(NULL, &cursor, NULL, NULL);
+    int_map_clear(NULL);
+    int_map_free(NULL);
+    print_test_result(ok, "int_map functions tolerate a NULL map");
+}
+
+/* ------------------------------------------------------------------ */
+/*  Growth, removal and iteration                                      */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Random puts and removes over a small key universe, checked against a
+ * direct-indexed model. Keys are spaced out so their low bits collide, which
+ * exercises long probe runs and backward-shift deletion.
+ */
+static void test_matches_model_under_churn(void) {
+    enum { UNIVERSE = 2048, OPS = 200000 };
+    uint64_t model[UNIVERSE];
+    bool present[UNIVERSE];
+    memset(present, 0, sizeof(present));
+    memset(model, 0, sizeof(model));
+
+    u64_map *m = create_u64_map(0);
+    assert_not_null(m);
+
+    uint64_t state = 0x853c49e6748fea9bULL;
+    int ok = 1;
+    int count = 0;
+    for (int op = 0; op < OPS && ok; op++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        unsigned slot = (unsigned)(state >> 33) % UNIVERSE;
+        uint64_t key = (uint64_t)slot << 20;
+        if ((state >> 20) % 3 != 0) {
+            ok &= u64_map_put(m, key, state) == OVA_SUCCESS;
+            count += present[slot] ? 0 : 1;
+            present[slot] = true;
+            model[slot] = state;
+        } else {
+            uint64_t out = 0;
+            bool removed = u64_map_remove(m, key, &out);
+            ok &= removed == present[slot] && (!removed || out == model[slot]);
+            count -= present[slot] ? 1 : 0;
+            present[slot] = false;
+        }
+    }
+
+    for (unsigned slot = 0; slot < UNIVERSE && ok; slot++) {
+        uint64_t out = 0;
+        bool found = u64_map_get(m, (uint64_t)slot << 20, &out);
+        ok &= found == present[slot] && (!found || out == model[slot]);
+    }
+    print_test_result(ok && u64_map_size(m) == count, "u64_map matches a reference model under churn");
+
+    u64_map_free(m);
+}
+
+static void test_reserve_and_clear(void) {
+    int_map *m = create_int_map(0);
+    assert_not_null(m);
+
+    int ok = int_map_reserve(m, 10000) == OVA_SUCCESS;
+    int reserved = int_map_capacity(m);
+    for (uint64_t k = 1; k <= 10000; k++) {
+        ok &= int_map_put(m, k, NULL) == OVA_SUCCESS;
+    }
+    print_test_result(ok && int_map_capacity(m) == reserved && int_map_size(m) == 10000,
+                      "int_map_reserve sizes the table for the requested entries");
+
+    int_map_clear(m);
+    ok = int_map_size(m) == 0 && int_map_capacity(m) == reserved && !int_map_contains(m, 5);
+    ok &= int_map_put(m, 5, NULL) == OVA_SUCCESS && int_map_contains(m, 5);
+    ok &= int_map_reserve(m, -1) == OVA_ERROR_INVALID_ARG;
+    print_test_result(ok, "int_map_clear empties the map and keeps its capacity");
+
+    int_map_free(m);
+}
+
+static void test_iteration_visits_each_entry(void) {
+    enum { N = 1000 };
+    int_map *m = create_int_map(N);
+    assert_not_null(m);
+
+    int values[N];
+    for (int i = 0; i < N; i++) {
+        values[i] = i;
+        int_map_put(m, (uint64_t)i * 7u, &values[i]);
+    }
+
+    int seen[N];
+    memset(seen, 0, sizeof(seen));
+    int ok = 1;
+    int visited = 0;
+    size_t cursor = 0;
+    uint64_t key = 0;
+    void *value = NULL;
+    while (int_map_next(m, &cursor, &key, &value)) {
+        int index = (int)(key / 7u);
+        ok &= key % 7u == 0 && index < N && value == &values[index];
+        if (ok) {
+            seen[index]++;
+        }
+        visited++;
+    }
+    for (int i = 0; i < N; i++) {
+        ok &= seen[i] == 1;
+    }
+    ok &= !int_map_next(m, &cursor, &key, &value);
+    print_test_result(ok && visited == N, "int_map_next visits each entry once, including key 0");
+
+    int_map_free(m);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Runner                                                             */
+/* ------------------------------------------------------------------ */
+
+static void run_all_tests(void) {
+    test_put_get_update_remove();
+    test_zero_and_extreme_keys();
+    test_null_safety();
+    test_matches_model_under_churn();
+    test_reserve_and_clear();
+    test_iteration_visits_each_entry();
+}
+
+int main(void) {
+    run_all_tests();
+    return 0;
+}
@@ -207,6 +207,44 @@ void test_linked_list_sequential_access(void) {
     free(values);
 }
 
+void test_linked_list_range_operations(void) {
+    list *lst = create_list(LINKED_LIST, 0, NULL);
+    int items[10];
+    void *ptrs[10];
+    for (int i = 0; i < 10; i++) {
+        items[i] = i;
+        ptrs[i] = &items[i];
+    }
+
+    int passed = lst->insert_range(lst, 0, ptrs, 3) == OVA_SUCCESS;
+    passed &= lst->insert_range(lst, 3, &ptrs[3], 7) == OVA_SUCCESS;
+    passed &= lst->size(lst) == 10 && lst->get(lst, 9) == ptrs[9];
+    print_test_result(passed, "Linked List insert_range falls back to single inserts");
+
+    /* Middle, tail and head ranges. */
+    passed = lst->remove_range(lst, 3, 5) == OVA_SUCCESS;
+    passed &= lst->remove_range(lst, 6, 8) == OVA_SUCCESS;
+    passed &= lst->remove_range(lst, 0, 1) == OVA_SUCCESS;
+    int expected[] = {1, 2, 5, 6, 7};
+    passed &= lst->size(lst) == 5;
+    for (int i = 0; i < 5 && passed; i++) {
+        passed = *(int *)lst->get(lst, i) == expected[i];
+    }
+    passed &= lst->insert(lst, ptrs[9], 5) == OVA_SUCCESS && lst->get(lst, 5) == ptrs[9];
+    print_test_result(passed, "Linked List remove_range unlinks the run");
+
+    void **span = NULL;
+    int span_len = 0;
+    passed = lst->data_span(lst, &span, &span_len) == OVA_ERROR_INVALID_ARG && !span;
+    passed &= lst->reserve(lst, 100) == OVA_SUCCESS;
+    passed &= lst->remove_range(lst, 2, 7) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    passed &= lst->remove_range(lst, 0, 6) == OVA_SUCCESS && lst->size(lst) == 0;
+    passed &= lst->insert(lst, ptrs[0], 0) == OVA_SUCCESS && lst->get(lst, 0) == ptrs[0];
+    print_test_result(passed, "Linked List has no data_span and reserve is a no-op");
+
+    lst->free(lst);
+}
+
 void run_all_tests(void) {
     test_linked_list_insert_and_get();
     test_linked_list_remove();
@@ -219,6 +257,7 @@ void run_all_tests(void) {
     test_linked_list_insert_error_codes();
     test_linked_list_remove_error_codes();
     test_linked_list_sequential_access();
+    test_linked_list_range_operations();
 }
 
 int main(void) {
@@ -149,6 +149,8 @@ static void test_active_count(void) {
     memory_pool_free(pool, b);
     print_test_result(memory_pool_active_count(pool) == 0,
                       "active count is 0 after freeing all blocks");
+    print_test_result(memory_pool_free_count(pool) == 4 && memory_pool_free_count(NULL) == 0,
+                      "free count covers every block of the chunk");
 
     memory_pool_destroy(pool);
 }
@@ -253,6 +255,31 @@ static void test_many_allocations(void) {
     memory_pool_destroy(pool);
 }
 
+static void test_reset_recycles_all_blocks(void) {
+    memory_pool *pool = create_memory_pool(24, 8);
+    assert_not_null(pool);
+
+    for (int i = 0; i < 20; i++) {
+        assert_not_null(memory_pool_alloc(pool));
+    }
+    memory_pool_reset(pool);
+    print_test_result(memory_pool_active_count(pool) == 0,
+                      "memory_pool_reset returns every block");
+
+    /* 20 blocks needed three chunks; all 24 blocks are reusable again. */
+    int ok = 1;
+    for (int i = 0; i < 24; i++) {
+        ok = ok && memory_pool_alloc(pool) != NULL;
+    }
+    print_test_result(ok && memory_pool_active_count(pool) == 24,
+                      "blocks are reusable after reset");
+    print_test_result(memory_pool_block_size(pool) == 24,
+                      "memory_pool_block_size reports the requested size");
+
+    memory_pool_reset(NULL);
+    memory_pool_destroy(pool);
+}
+
 /* ------------------------------------------------------------------ */
 /*  Runner                                                             */
 /* ------------------------------------------------------------------ */
@@ -271,6 +298,7 @@ static void run_all_tests(void) {
     test_small_block_size();
     test_write_and_read();
     test_many_allocations();
+    test_reset_recycles_all_blocks();
 }
 
 int main(void) {
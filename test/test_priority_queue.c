@@ -89,12 +89,36 @@ void test_priority_queue_high_volume(void) {
     pq->free(pq);
 }
 
+void test_priority_queue_of_values(void) {
+    queue *pq = create_queue_of(QUEUE_TYPE_PRIORITY, sizeof(int), 2, int_compare_binary);
+    int passed = pq != NULL;
+    for (int i = 0; i < 200 && passed; i++) {
+        int value = (i * 37) % 200;
+        passed = pq->enqueue(pq, &value) == OVA_SUCCESS;
+    }
+    queue *copy = pq->clone_shallow(pq);
+    passed &= copy && copy->size(copy) == 200;
+    int previous = *(int *)pq->dequeue(pq);
+    passed &= previous == *(int *)copy->dequeue(copy);
+    for (int i = 1; i < 200 && passed; i++) {
+        int current = *(int *)pq->dequeue(pq);
+        passed = int_compare_binary(&previous, &current) >= 0 && current == *(int *)copy->dequeue(copy);
+        previous = current;
+    }
+    passed &= pq->is_empty(pq) && copy->is_empty(copy);
+    print_test_result(passed, "Priority queue of values dequeues copies in priority order");
+
+    if (copy) copy->free(copy);
+    if (pq) pq->free(pq);
+}
+
 void run_all_priority_queue_tests(void) {
     test_priority_queue_empty_initially();
     test_priority_queue_dequeue_empty();
     test_priority_queue_enqueue_dequeue();
     test_priority_queue_multiple_elements();
     test_priority_queue_high_volume();
+    test_priority_queue_of_values();
 }
 
 int main(void) {
@@ -107,6 +107,31 @@ void test_queue_node_recycle(void) {
     q->free(q);
 }
 
+void test_queue_of_values(void) {
+    queue *q = create_queue_of(QUEUE_TYPE_NORMAL, sizeof(int), 4, NULL);
+    int ok = q != NULL;
+    for (int r = 0; r < 4 && ok; r++) {
+        for (int i = 0; i < 100; i++) {
+            int value = r * 100 + i;
+            if (q->enqueue(q, &value) != OVA_SUCCESS) { ok = 0; break; }
+        }
+        for (int i = 0; i < 50; i++) {
+            int *out = (int *)q->dequeue(q);
+            if (!out || *out != r * 50 + i) { ok = 0; break; }
+        }
+    }
+    queue *copy = q->clone_shallow(q);
+    ok &= q->size(q) == 200 && copy && copy->size(copy) == 200;
+    for (int i = 0; i < 200 && ok; i++) {
+        ok = *(int *)q->dequeue(q) == 200 + i && *(int *)copy->dequeue(copy) == 200 + i;
+    }
+    ok &= q->is_empty(q) && q->dequeue(q) == NULL;
+    print_test_result(ok, "Queue of values keeps FIFO order of copied values");
+
+    if (copy) copy->free(copy);
+    q->free(q);
+}
+
 void run_all_queue_tests(void) {
     test_queue_empty_initially();
     test_queue_dequeue_empty();
@@ -116,6 +141,7 @@ void run_all_queue_tests(void) {
     test_queue_with_string_data();
     test_queue_enqueue_error_codes();
     test_queue_node_recycle();
+    test_queue_of_values();
 }
 
 int main(void) {
@@ -272,6 +272,348 @@ static void test_set_add_bulk_edge_cases(void) {
     if (s) { s->free(s); }
 }
 
+static void sum_visitor(void *element, void *ctx) {
+    *(long *)ctx += *(int *)element;
+}
+
+static void check_set_iteration(set_type type, const char *label) {
+    set *s = create_set(type, int_comparator, type == SET_HASH ? int_hash : NULL);
+    enum { N = 200 };
+    static int values[N];
+    for (int i = 0; i < N; i++) {
+        values[i] = i;
+        s->add(s, &values[i]);
+    }
+
+    long sum = 0;
+    s->for_each(s, sum_visitor, &sum);
+
+    /* Drop the odd elements through the cursor while walking. */
+    int seen[N] = {0};
+    int visits = 0;
+    int ordered = 1;
+    int last = -1;
+    set_iterator it;
+    s->iter_begin(s, &it);
+    while (s->iter_next(s, &it)) {
+        int v = *(int *)it.element;
+        seen[v]++;
+        visits++;
+        ordered = ordered && v > last;
+        last = v;
+        if (v % 2 != 0) {
+            s->iter_remove(s, &it);
+        }
+    }
+
+    int ok = sum == (long)N * (N - 1) / 2 && visits == N && s->size(s) == N / 2;
+    for (int i = 0; i < N && ok; i++) {
+        ok = seen[i] == 1 && set_contains_int(s, i) == (i % 2 == 0);
+    }
+    if (type == SET_TREE) {
+        ok = ok && ordered;
+    }
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%s: cursor visits each element once and removes in place", label);
+    print_test_result(ok, msg);
+    s->free(s);
+}
+
+static void test_set_iteration(void) {
+    check_set_iteration(SET_HASH, "Hash set");
+    check_set_iteration(SET_TREE, "Tree set");
+}
+
+enum { ALGEBRA_UNIVERSE = 1200 };
+static int algebra_values[ALGEBRA_UNIVERSE];
+
+static set *multiples_set(set_type type, int step, int limit) {
+    set *s = create_set(type, int_comparator, type == SET_HASH ? int_hash : NULL);
+    for (int i = 0; i < limit; i += step) {
+        s->add(s, &algebra_values[i]);
+    }
+    return s;
+}
+
+/* Membership matches @p expect for every value, and tree sets iterate in order. */
+static int set_matches(set *s, set_type type, int (*expect)(int, int, int), int a_lim, int b_lim) {
+    if (!s) {
+        return 0;
+    }
+    int count = 0;
+    for (int i = 0; i < ALGEBRA_UNIVERSE; i++) {
+        int want = expect(i, a_lim, b_lim);
+        if (set_contains_int(s, i) != want) {
+            return 0;
+        }
+        count += want;
+    }
+
+    int last = -1;
+    int ordered = 1;
+    set_iterator it;
+    s->iter_begin(s, &it);
+    while (s->iter_next(s, &it)) {
+        int v = *(int *)it.element;
+        ordered = ordered && v > last;
+        last = v;
+    }
+    return s->size(s) == count && (type != SET_TREE || ordered);
+}
+
+static int in_a(int i, int a_lim) {
+    return i % 2 == 0 && i < a_lim;
+}
+
+static int in_b(int i, int b_lim) {
+    return i % 3 == 0 && i < b_lim;
+}
+
+static int expect_union(int i, int a_lim, int b_lim) {
+    return in_a(i, a_lim) || in_b(i, b_lim);
+}
+
+static int expect_intersection(int i, int a_lim, int b_lim) {
+    return in_a(i, a_lim) && in_b(i, b_lim);
+}
+
+static int expect_difference(int i, int a_lim, int b_lim) {
+    return in_a(i, a_lim) && !in_b(i, b_lim);
+}
+
+static int expect_reverse_difference(int i, int a_lim, int b_lim) {
+    return in_b(i, b_lim) && !in_a(i, a_lim);
+}
+
+/* Removing everything proves a built tree is still structurally sound. */
+static int drain_set(set *s) {
+    for (int i = 0; i < ALGEBRA_UNIVERSE; i++) {
+        set_remove_int(s, i);
+    }
+    int ok = s->size(s) == 0;
+    ok = ok && s->add(s, &algebra_values[7]) && set_contains_int(s, 7);
+    return ok;
+}
+
+static void check_set_algebra_sizes(set_type type, const char *label, int a_lim, int b_lim) {
+    set *a = multiples_set(type, 2, a_lim);
+    set *b = multiples_set(type, 3, b_lim);
+
+    set *u = a->union_with(a, b);
+    set *n = a->intersection_with(a, b);
+    set *nb = b->intersection_with(b, a);
+    set *d = a->difference_with(a, b);
+    set *db = b->difference_with(b, a);
+    int ok = set_matches(u, type, expect_union, a_lim, b_lim);
+    ok = ok && set_matches(n, type, expect_intersection, a_lim, b_lim);
+    ok = ok && set_matches(nb, type, expect_intersection, a_lim, b_lim);
+    ok = ok && set_matches(d, type, expect_difference, a_lim, b_lim);
+    ok = ok && set_matches(db, type, expect_reverse_difference, a_lim, b_lim);
+    ok = ok && u && drain_set(u) && d && drain_set(d);
+
+    set *ua = a->clone_shallow(a);
+    set *na = a->clone_shallow(a);
+    ok = ok && ua->union_into(ua, b) == OVA_SUCCESS && set_matches(ua, type, expect_union, a_lim, b_lim);
+    ok = ok && na->intersect_into(na, b) == OVA_SUCCESS &&
+         set_matches(na, type, expect_intersection, a_lim, b_lim);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s (%d vs %d elements): union, intersection, difference and in-place forms agree",
+             label, a->size(a), b->size(b));
+    print_test_result(ok, msg);
+
+    set *sets[] = {u, n, nb, d, db, ua, na, a, b};
+    for (size_t i = 0; i < sizeof(sets) / sizeof(sets[0]); i++) {
+        if (sets[i]) {
+            sets[i]->free(sets[i]);
+        }
+    }
+}
+
+static void test_set_algebra_sizes(void) {
+    for (int i = 0; i < ALGEBRA_UNIVERSE; i++) {
+        algebra_values[i] = i;
+    }
+
+    const set_type types[] = {SET_HASH, SET_TREE};
+    const char *labels[] = {"Hash set", "Tree set"};
+    for (int t = 0; t < 2; t++) {
+        check_set_algebra_sizes(types[t], labels[t], 1000, 1100);
+        check_set_algebra_sizes(types[t], labels[t], 1200, 12);
+        check_set_algebra_sizes(types[t], labels[t], 6, 1200);
+        check_set_algebra_sizes(types[t], labels[t], 0, 300);
+    }
+
+    set *h = multiples_set(SET_HASH, 2, 20);
+    set *t = multiples_set(SET_TREE, 2, 20);
+    int ok = h->union_into(h, t) == OVA_ERROR_INVALID_ARG && h->intersect_into(h, t) == OVA_ERROR_INVALID_ARG;
+    ok = ok && h->union_into(h, h) == OVA_SUCCESS && h->intersect_into(h, h) == OVA_SUCCESS && h->size(h) == 10;
+    ok = ok && t->intersect_into(t, t) == OVA_SUCCESS && t->size(t) == 10;
+    print_test_result(ok, "In-place set algebra rejects incompatible sets and tolerates aliasing");
+    h->free(h);
+    t->free(t);
+}
+
+static int fixed_hash_value;
+
+/* Every element shares one home slot, so probe runs are long and may wrap. */
+static int fixed_hash(void *key, int capacity) {
+    (void)key;
+    (void)capacity;
+    return fixed_hash_value;
+}
+
+static void test_hash_set_probe_runs(void) {
+    static int values[12];
+    int ok = 1;
+    for (int c = 0; c < 16 && ok; c++) {
+        fixed_hash_value = c;
+        set *s = create_set(SET_HASH, int_comparator, fixed_hash);
+        for (int i = 0; i < 11; i++) {
+            values[i] = i;
+            ok = ok && s->add(s, &values[i]) && !s->add(s, &values[i]);
+        }
+
+        int seen[11] = {0};
+        set_iterator it;
+        s->iter_begin(s, &it);
+        while (s->iter_next(s, &it)) {
+            int v = *(int *)it.element;
+            seen[v]++;
+            if (v % 2 == 0) {
+                ok = ok && s->iter_remove(s, &it);
+            }
+        }
+        for (int i = 0; i < 11; i++) {
+            ok = ok && seen[i] == 1 && set_contains_int(s, i) == (i % 2 != 0);
+        }
+        ok = ok && s->size(s) == 5 && set_remove_int(s, 3) && !set_contains_int(s, 3) && set_contains_int(s, 5);
+        s->free(s);
+    }
+    print_test_result(ok, "Hash set handles colliding probe runs, including wrapped ones");
+}
+
+static void test_hash_set_matches_model(void) {
+    enum { UNIVERSE = 3000, OPS = 100000 };
+    static int values[UNIVERSE];
+    static bool present[UNIVERSE];
+    for (int i = 0; i < UNIVERSE; i++) {
+        values[i] = i;
+        present[i] = false;
+    }
+
+    set *s = create_set(SET_HASH, int_comparator, int_hash);
+    uint32_t state = 12345u;
+    int ok = 1;
+    int count = 0;
+    for (int op = 0; op < OPS && ok; op++) {
+        state = state * 1103515245u + 12345u;
+        int v = (int)((state >> 8) % UNIVERSE);
+        if ((state >> 4) % 3 != 0) {
+            ok = s->add(s, &values[v]) == !present[v];
+            count += present[v] ? 0 : 1;
+            present[v] = true;
+        } else {
+            ok = s->remove(s, &values[v]) == present[v];
+            count -= present[v] ? 1 : 0;
+            present[v] = false;
+        }
+    }
+    for (int i = 0; i < UNIVERSE && ok; i++) {
+        ok = set_contains_int(s, i) == present[i];
+    }
+    print_test_result(ok && s->size(s) == count, "Hash set add reports novelty and matches a model under churn");
+    s->free(s);
+}
+
+static void test_bitmap_set(void) {
+    set *a = create_set(SET_BITMAP, NULL, NULL);
+    set *b = create_set(SET_BITMAP, NULL, NULL);
+    assert_not_null(a);
+    assert_not_null(b);
+
+    int ok = a->add(a, SET_INT(0)) && !a->add(a, SET_INT(0)) && a->contains(a, NULL);
+    for (int i = 1; i < 300; i++) {
+        a->add(a, SET_INT(i * 2));
+        b->add(b, SET_INT(i * 3));
+    }
+    ok &= a->size(a) == 300 && b->size(b) == 299;
+    print_test_result(ok, "Bitmap set stores integers, including 0");
+
+    set *u = a->union_with(a, b);
+    set *x = a->intersection_with(a, b);
+    set *d = a->difference_with(a, b);
+    ok = u && x && d;
+    for (int v = 0; ok && v < 1000; v++) {
+        bool in_a = v < 600 && v % 2 == 0;
+        bool in_b = v > 0 && v < 900 && v % 3 == 0;
+        ok &= u->contains(u, SET_INT(v)) == (in_a || in_b);
+        ok &= x->contains(x, SET_INT(v)) == (in_a && in_b);
+        ok &= d->contains(d, SET_INT(v)) == (in_a && !in_b);
+    }
+    ok &= a->size(a) == 300 && b->size(b) == 299;
+    print_test_result(ok, "Bitmap set algebra matches the expected members");
+
+    ok = b->intersect_into(b, a) == OVA_SUCCESS && b->size(b) == x->size(x);
+    ok &= a->union_into(a, u) == OVA_SUCCESS && a->size(a) == u->size(u);
+    ok &= u->is_subset_of(u, a) && x->is_subset_of(x, a) && !a->is_subset_of(a, x);
+    print_test_result(ok, "Bitmap set updates in place through union_into and intersect_into");
+
+    size_t prev = 0;
+    int visited = 0;
+    ok = 1;
+    set_iterator it;
+    x->iter_begin(x, &it);
+    while (x->iter_next(x, &it)) {
+        size_t v = SET_INT_VALUE(it.element);
+        ok &= visited == 0 || v > prev;
+        prev = v;
+        visited++;
+        x->iter_remove(x, &it);
+    }
+    ok &= visited == 99 && x->size(x) == 0;
+    print_test_result(ok, "Bitmap set iterates in ascending order and removes through the cursor");
+
+    set *h = create_set(SET_HASH, NULL, NULL);
+    ok = a->union_with(a, h) == NULL && a->union_into(a, h) == OVA_ERROR_INVALID_ARG;
+    print_test_result(ok, "Bitmap set rejects algebra with other backends");
+
+    h->free(h);
+    u->free(u);
+    x->free(x);
+    d->free(d);
+    a->free(a);
+    b->free(b);
+}
+
+static void *deref_copier(void *element) {
+    int *dup = malloc(sizeof(int));
+    if (dup) {
+        *dup = *(const int *)element;
+    }
+    return dup;
+}
+
+static void test_bitmap_set_clone_deep(void) {
+    set *s = create_set(SET_BITMAP, NULL, NULL);
+    assert_not_null(s);
+    for (int i = 0; i < 200; i += 7) {
+        s->add(s, SET_INT(i));
+    }
+
+    /* The copier would dereference the integers; a bitmap must not call it. */
+    set *copy = s->clone_deep(s, deref_copier);
+    int ok = copy != NULL && copy->size(copy) == s->size(s) && copy->contains(copy, SET_INT(0));
+    for (int i = 0; ok && i < 200; i++) {
+        ok = copy->contains(copy, SET_INT(i)) == (i % 7 == 0);
+    }
+    print_test_result(ok, "Bitmap set clone_deep copies integers, including 0, without the copier");
+
+    if (copy) copy->free(copy);
+    s->free(s);
+}
+
 static void run_all_tests(void) {
     test_hash_set_basic_ops();
     test_set_algebra_hash();
@@ -281,6 +623,12 @@ static void run_all_tests(void) {
     test_tree_set_add_bulk();
     test_set_add_bulk_with_duplicates();
     test_set_add_bulk_edge_cases();
+    test_set_iteration();
+    test_set_algebra_sizes();
+    test_hash_set_probe_runs();
+    test_hash_set_matches_model();
+    test_bitmap_set();
+    test_bitmap_set_clone_deep();
 }
 
 int main(void) {
@@ -0,0 +1,131 @@
+#include "base_test.h"
+#include "../include/list.h"
+
+static int int_comparator(const void *a, const void *b) {
+    int lhs = *(const int *)a;
+    int rhs = *(const int *)b;
+    if (lhs < rhs) return -1;
+    if (lhs > rhs) return 1;
+    return 0;
+}
+
+/* Enough items for many block splits and merges. */
+enum { COUNT = 20000 };
+
+static int matches_model(list *lst, const int *model, int n) {
+    if (lst->size(lst) != n) {
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        int *value = (int *)lst->get(lst, i);
+        if (!value || *value != model[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void model_insert(int *model, int *n, int value) {
+    int pos = 0;
+    while (pos < *n && model[pos] < value) {
+        pos++;
+    }
+    for (int i = *n; i > pos; i--) {
+        model[i] = model[i - 1];
+    }
+    model[pos] = value;
+    (*n)++;
+}
+
+static void model_remove(int *model, int *n, int index) {
+    for (int i = index; i + 1 < *n; i++) {
+        model[i] = model[i + 1];
+    }
+    (*n)--;
+}
+
+static void test_sorted_block_list_matches_flat_order(void) {
+    int *data = malloc(COUNT * sizeof(int));
+    int *model = malloc(COUNT * sizeof(int));
+    list *lst = create_list(SORTED_BLOCK_LIST, 0, int_comparator);
+    assert_not_null(lst);
+
+    unsigned int state = 12345u;
+    int n = 0;
+    for (int i = 0; i < COUNT; i++) {
+        state = state * 1103515245u + 12345u;
+        data[i] = (int)((state >> 8) % 5000u);
+        lst->insert(lst, &data[i], 0);
+        model_insert(model, &n, data[i]);
+    }
+    print_test_result(matches_model(lst, model, n), "Sorted block list keeps random inserts ordered");
+
+    int ok = 1;
+    for (int i = 0; i < 200 && ok; i++) {
+        state = state * 1103515245u + 12345u;
+        int index = (int)((state >> 8) % (unsigned int)n);
+        ok = *(int *)lst->get(lst, index) == model[index];
+    }
+    ok &= lst->get(lst, -1) == NULL && lst->get(lst, n) == NULL;
+    print_test_result(ok, "Sorted block list get works at random indices");
+
+    /* Remove most items from the front, back and middle to force merges. */
+    ok = 1;
+    while (n > 100 && ok) {
+        state = state * 1103515245u + 12345u;
+        int index = (int)((state >> 8) % 3u) == 0 ? 0 : (int)((state >> 8) % (unsigned int)n);
+        ok = lst->remove(lst, index) == OVA_SUCCESS;
+        model_remove(model, &n, index);
+    }
+    ok &= matches_model(lst, model, n);
+    ok &= lst->remove(lst, n) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    print_test_result(ok, "Sorted block list removes keep order and indexing");
+
+    while (n > 0) {
+        lst->remove(lst, 0);
+        model_remove(model, &n, 0);
+    }
+    ok = lst->size(lst) == 0 && lst->get(lst, 0) == NULL;
+    ok &= lst->insert(lst, &data[0], 0) == OVA_SUCCESS && lst->get(lst, 0) == &data[0];
+    print_test_result(ok, "Sorted block list is reusable after removing everything");
+
+    lst->free(lst);
+    free(model);
+    free(data);
+}
+
+static void test_sorted_block_list_clear_and_clone(void) {
+    int data[3000];
+    list *lst = create_list(SORTED_BLOCK_LIST, 0, int_comparator);
+    assert_not_null(lst);
+    for (int i = 0; i < 3000; i++) {
+        data[i] = 2999 - i;
+        lst->insert(lst, &data[i], i);
+    }
+
+    list *copy = lst->clone_shallow(lst);
+    int ok = copy != NULL && copy->size(copy) == 3000;
+    for (int i = 0; ok && i < 3000; i++) {
+        ok = *(int *)copy->get(copy, i) == i && copy->get(copy, i) == lst->get(lst, i);
+    }
+    print_test_result(ok, "Sorted block list clone_shallow copies order and pointers");
+
+    lst->clear(lst);
+    ok = lst->size(lst) == 0 && copy->size(copy) == 3000;
+    ok &= lst->insert(lst, &data[5], 0) == OVA_SUCCESS && lst->size(lst) == 1;
+    ok &= create_list(SORTED_BLOCK_LIST, 0, NULL) == NULL;
+    print_test_result(ok, "Sorted block list clear empties it and a comparator is required");
+
+    copy->free(copy);
+    lst->free(lst);
+}
+
+static void run_all_tests(void) {
+    test_sorted_block_list_matches_flat_order();
+    test_sorted_block_list_clear_and_clone();
+}
+
+int main(void) {
+    run_all_tests();
+    return 0;
+}
@@ -92,10 +92,102 @@ static void test_sorted_list_remove(void) {
     lst->free(lst);
 }
 
+static void test_sorted_list_insert_bulk(void) {
+    enum { EXISTING = 3000, BATCH = 2000, SMALL = 50, TOTAL = EXISTING + 2 * BATCH + SMALL };
+    static int values[TOTAL];
+    static int expected[TOTAL];
+    void *batch[BATCH];
+    unsigned int state = 77u;
+    for (int i = 0; i < TOTAL; i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = (int)((state >> 8) % 4000u);
+        expected[i] = values[i];
+    }
+
+    list *lst = create_list(SORTED_LIST, 4, int_comparator);
+    if (!lst) {
+        print_test_result(0, "Failed to create sorted list for bulk insert test");
+        return;
+    }
+    for (int i = 0; i < EXISTING; i++) {
+        lst->insert(lst, &values[i], 0);
+    }
+
+    /* An unsorted batch, an already sorted one, then one small enough to be
+     * placed by binary search. */
+    for (int i = 0; i < BATCH; i++) {
+        batch[i] = &values[EXISTING + i];
+    }
+    int passed = lst->insert_bulk(lst, batch, BATCH) == OVA_SUCCESS;
+    qsort(&values[EXISTING + BATCH], BATCH, sizeof(int), int_comparator);
+    for (int i = 0; i < BATCH; i++) {
+        batch[i] = &values[EXISTING + BATCH + i];
+    }
+    passed &= lst->insert_bulk(lst, batch, BATCH) == OVA_SUCCESS;
+    for (int i = 0; i < SMALL; i++) {
+        batch[i] = &values[EXISTING + 2 * BATCH + i];
+    }
+    passed &= lst->insert_bulk(lst, batch, SMALL) == OVA_SUCCESS;
+
+    qsort(expected, TOTAL, sizeof(int), int_comparator);
+    passed &= lst->size(lst) == TOTAL;
+    for (int i = 0; i < TOTAL && passed; i++) {
+        passed = *(int *)lst->get(lst, i) == expected[i];
+    }
+    print_test_result(passed, "Sorted list insert_bulk merges sorted and unsorted batches");
+
+    int key = 5;
+    int dup_a = 5;
+    int dup_b = 5;
+    list *dups = create_list(SORTED_LIST, 1, int_comparator);
+    dups->insert(dups, &key, 0);
+    void *equal[] = {&dup_a, &dup_b};
+    passed = dups->insert_bulk(dups, equal, 2) == OVA_SUCCESS;
+    passed &= dups->get(dups, 0) == &dup_a && dups->get(dups, 1) == &dup_b && dups->get(dups, 2) == &key;
+    passed &= dups->insert_bulk(dups, NULL, 2) == OVA_ERROR_INVALID_ARG;
+    passed &= dups->insert_bulk(dups, equal, 0) == OVA_ERROR_INVALID_ARG;
+    print_test_result(passed, "Sorted list insert_bulk places a batch before equal items in batch order");
+
+    dups->free(dups);
+    lst->free(lst);
+}
+
+static void test_sorted_list_range_operations(void) {
+    int data[] = {7, 3, 9, 1, 5, 8, 2};
+    void *ptrs[7];
+    for (int i = 0; i < 7; ++i) {
+        ptrs[i] = &data[i];
+    }
+
+    list *lst = create_list(SORTED_LIST, 2, int_comparator);
+    if (!lst) {
+        print_test_result(0, "Failed to create sorted list for range test");
+        return;
+    }
+
+    int passed = lst->reserve(lst, 64) == OVA_SUCCESS;
+    passed &= lst->insert_range(lst, 5, ptrs, 7) == OVA_SUCCESS; // index ignored
+    passed &= lst->remove_range(lst, 1, 4) == OVA_SUCCESS; // drops 2, 3, 5
+
+    int expected[] = {1, 7, 8, 9};
+    void **span = NULL;
+    int span_len = 0;
+    passed &= lst->data_span(lst, &span, &span_len) == OVA_SUCCESS && span_len == 4;
+    for (int i = 0; i < span_len && passed; ++i) {
+        passed = *(int *)span[i] == expected[i];
+    }
+    passed &= lst->remove_range(lst, 2, 5) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    print_test_result(passed, "Sorted list range operations keep ordering");
+
+    lst->free(lst);
+}
+
 static void run_all_tests(void) {
     test_sorted_list_insertion_order();
     test_sorted_list_lookup();
     test_sorted_list_remove();
+    test_sorted_list_insert_bulk();
+    test_sorted_list_range_operations();
 }
 
 int main(void) {
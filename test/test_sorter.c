@@ -2,6 +2,7 @@
 #include "../include/types.h"
 #include "../include/sort.h"
 #include <time.h>
+#include <string.h>
 
 #include <stddef.h>  // Para usar o tipo NULL
 
@@ -304,6 +305,554 @@ void test_merge_sort_large(void) {
     s->free(s);
 }
 
+/*
+ * Many duplicate keys over distinct payloads: the parallel sorter must
+ * reproduce the merge sorter's stable order pointer for pointer.
+ */
+void test_parallel_sort_matches_merge_sort(void) {
+    const int MAX = 200000;
+    int *values = malloc((size_t)MAX * sizeof(int));
+    list *expected = create_list(ARRAY_LIST, MAX, NULL);
+    list *actual = create_list(LINKED_LIST, MAX, NULL);
+    sorter *merge_sorter = create_merge_sorter(int_compare);
+    sorter *parallel = create_parallel_sorter(int_compare, 4);
+    if (!values || !expected || !actual || !merge_sorter || !parallel) {
+        print_test_result(0, "Parallel sort matches merge sort");
+        return;
+    }
+
+    unsigned int state = 12345u;
+    for (int i = 0; i < MAX; i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = (int)((state >> 8) % 1000u);
+        expected->insert(expected, &values[i], i);
+        actual->insert(actual, &values[i], i);
+    }
+    merge_sorter->sort(merge_sorter, expected);
+    parallel->sort(parallel, actual);
+
+    int same = actual->size(actual) == MAX;
+    for (int i = 0; same && i < MAX; i++) {
+        same = actual->get(actual, i) == expected->get(expected, i);
+    }
+    print_test_result(same, "Parallel sort matches merge sort, including the order of equal keys");
+
+    expected->free(expected);
+    actual->free(actual);
+    merge_sorter->free(merge_sorter);
+    parallel->free(parallel);
+    free(values);
+}
+
+void test_parallel_sort_small_and_default_threads(void) {
+    sorter *s = create_parallel_sorter(int_compare, 0);
+    list *lst = create_list(ARRAY_LIST, 5, NULL);
+    int items[] = {3, 1, 2};
+    s->sort(s, lst);
+    int passed = lst->size(lst) == 0;
+    for (int i = 0; i < 3; i++) {
+        lst->insert(lst, &items[i], i);
+    }
+    s->sort(s, lst);
+    for (int i = 0; i < 3; i++) {
+        passed &= *(int *)lst->get(lst, i) == i + 1;
+    }
+    print_test_result(passed, "Parallel sorter handles empty and small lists with default threads");
+    lst->free(lst);
+    s->free(s);
+}
+
+/*
+ * Inputs that drive a naive quicksort to O(n^2): each must sort correctly
+ * and quickly.
+ */
+void test_sorter_adversarial_patterns(void) {
+    const int MAX = 100000;
+    const char *names[] = {"sorted", "reversed", "sawtooth", "all-equal", "organ-pipe"};
+    int *values = malloc((size_t)MAX * sizeof(int));
+    sorter *s = create_sorter(int_compare);
+    if (!values || !s) {
+        print_test_result(0, "Sorter handles adversarial patterns");
+        free(values);
+        return;
+    }
+
+    for (int p = 0; p < 5; p++) {
+        list *lst = create_list(ARRAY_LIST, MAX, NULL);
+        for (int i = 0; i < MAX; i++) {
+            switch (p) {
+                case 0: values[i] = i; break;
+                case 1: values[i] = MAX - i; break;
+                case 2: values[i] = i % 1000; break;
+                case 3: values[i] = 42; break;
+                default: values[i] = i < MAX / 2 ? i : MAX - i; break;
+            }
+            lst->insert(lst, &values[i], i);
+        }
+
+        clock_t start = clock();
+        s->sort(s, lst);
+        double elapsed_ms = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1000.0;
+        int sorted = lst->size(lst) == MAX;
+        for (int i = 1; sorted && i < MAX; i++) {
+            sorted = *(int *)lst->get(lst, i - 1) <= *(int *)lst->get(lst, i);
+        }
+        char label[96];
+        snprintf(label, sizeof(label), "Sorter sorts %s input of %d elements within time limit", names[p], MAX);
+        print_test_result(sorted && elapsed_ms < 1500.0, label);
+        lst->free(lst);
+    }
+
+    s->free(s);
+    free(values);
+}
+
+static uint64_t int_key(const void *item) {
+    return (uint64_t)(int64_t)*(const int *)item ^ ((uint64_t)1 << 63);
+}
+
+static int string_compare(const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+}
+
+static const char *string_key(const void *item) {
+    return (const char *)item;
+}
+
+/* Radix sorts and TimSort are stable, so they must agree with merge sort exactly. */
+static int same_order_as_merge_sort(sorter *s, comparator cmp, void **items, int n) {
+    list *expected = create_list(ARRAY_LIST, n, NULL);
+    list *actual = create_list(ARRAY_LIST, n, NULL);
+    sorter *merge_sorter = create_merge_sorter(cmp);
+    for (int i = 0; i < n; i++) {
+        expected->insert(expected, items[i], i);
+        actual->insert(actual, items[i], i);
+    }
+    merge_sorter->sort(merge_sorter, expected);
+    s->sort(s, actual);
+
+    int same = actual->size(actual) == n;
+    for (int i = 0; same && i < n; i++) {
+        same = actual->get(actual, i) == expected->get(expected, i);
+    }
+    expected->free(expected);
+    actual->free(actual);
+    merge_sorter->free(merge_sorter);
+    return same;
+}
+
+void test_radix_sorter_integer_keys(void) {
+    const int MAX = 50000;
+    int *values = malloc((size_t)MAX * sizeof(int));
+    void **items = malloc((size_t)MAX * sizeof(void *));
+    sorter *s = create_radix_sorter(int_compare, int_key);
+    unsigned int state = 777u;
+    for (int i = 0; i < MAX; i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = (int)(state >> 4) - (1 << 27);
+        if (i % 7 == 0) {
+            values[i] = values[i / 2];
+        }
+        items[i] = &values[i];
+    }
+
+    int ok = same_order_as_merge_sort(s, int_compare, items, MAX);
+    ok &= same_order_as_merge_sort(s, int_compare, items, 10);
+    for (int i = 0; i < MAX; i++) {
+        values[i] = i % 200;
+    }
+    ok &= same_order_as_merge_sort(s, int_compare, items, MAX);
+    ok &= create_radix_sorter(int_compare, NULL) == NULL;
+    print_test_result(ok, "Radix sorter orders signed integer keys stably");
+
+    s->free(s);
+    free(items);
+    free(values);
+}
+
+/* A radix sorter built without a comparator still sorts; the comparator-based
+ * operations must fail cleanly instead of calling through NULL. */
+void test_radix_sorter_without_comparator(void) {
+    int values[] = {5, 3, 9, 1, 7};
+    list *lst = create_list(ARRAY_LIST, 8, NULL);
+    for (int i = 0; i < 5; i++) {
+        lst->insert(lst, &values[i], i);
+    }
+    sorter *s = create_radix_sorter(NULL, int_key);
+    s->sort(s, lst);
+    int ok = *(int *)lst->get(lst, 0) == 1 && *(int *)lst->get(lst, 4) == 9;
+
+    int key = 7;
+    int out[1] = {0};
+    void *top[2] = {NULL, NULL};
+    ok &= s->binary_search(s, lst, &key) == -1;
+    ok &= s->binary_search_batch(s, lst, (void *const *)top, 1, out) == -1;
+    ok &= s->min(s, lst) == NULL && s->max(s, lst) == NULL;
+    ok &= s->top_k(s, lst, 2, top) == 0;
+    s->partial_sort(s, lst, 2);
+    s->nth_element(s, lst, 2);
+    ok &= lst->size(lst) == 5;
+    print_test_result(ok, "Radix sorter without a comparator rejects comparator-based operations");
+
+    sorter *merge = create_merge_sorter(NULL);
+    merge->sort(merge, lst);
+    print_test_result(lst->size(lst) == 5 && *(int *)lst->get(lst, 0) == 1,
+                      "Merge sorter without a comparator leaves the list unchanged");
+
+    merge->free(merge);
+    s->free(s);
+    lst->free(lst);
+}
+
+void test_tim_sorter_matches_merge_sort(void) {
+    const int MAX = 40000;
+    int *values = malloc((size_t)MAX * sizeof(int));
+    void **items = malloc((size_t)MAX * sizeof(void *));
+    sorter *s = create_tim_sorter(int_compare);
+    unsigned int state = 4242u;
+    for (int i = 0; i < MAX; i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = (int)((state >> 8) % 5000u);
+        items[i] = &values[i];
+    }
+    int ok = same_order_as_merge_sort(s, int_compare, items, MAX);
+    ok &= same_order_as_merge_sort(s, int_compare, items, 0);
+    ok &= same_order_as_merge_sort(s, int_compare, items, 1);
+    ok &= same_order_as_merge_sort(s, int_compare, items, 50);
+    print_test_result(ok, "TimSort matches merge sort on random keys with duplicates");
+
+    /* Concatenated sorted batches, then descending runs broken by ties. */
+    for (int i = 0; i < MAX; i++) {
+        values[i] = (i % 3000) * 2;
+    }
+    ok = same_order_as_merge_sort(s, int_compare, items, MAX);
+    for (int i = 0; i < MAX; i++) {
+        values[i] = (MAX - i) / 3;
+    }
+    ok &= same_order_as_merge_sort(s, int_compare, items, MAX);
+    for (int i = 0; i < MAX; i++) {
+        values[i] = i % 997 == 0 ? (int)(i * 7919 % 1000) : i;
+    }
+    ok &= same_order_as_merge_sort(s, int_compare, items, MAX);
+    print_test_result(ok, "TimSort keeps stability on sorted batches, descending and nearly sorted runs");
+
+    s->free(s);
+    free(items);
+    free(values);
+}
+
+/* Every sorter must leave array and linked lists in merge-sort order. */
+void test_sorters_on_array_and_linked_lists(void) {
+    enum { COUNT = 5000 };
+    int *values = malloc(COUNT * sizeof(int));
+    unsigned int state = 31337u;
+    for (int i = 0; i < COUNT; i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = (int)((state >> 8) % 700u);
+    }
+    sorter *sorters[] = {
+        create_sorter(int_compare),
+        create_merge_sorter(int_compare),
+        create_tim_sorter(int_compare),
+        create_parallel_sorter(int_compare, 2),
+        create_radix_sorter(int_compare, int_key),
+    };
+    const int sorter_count = (int)(sizeof(sorters) / sizeof(sorters[0]));
+    list *expected = create_list(ARRAY_LIST, COUNT, NULL);
+    for (int i = 0; i < COUNT; i++) {
+        expected->insert(expected, &values[i], i);
+    }
+    sorters[1]->sort(sorters[1], expected);
+
+    int ok = 1;
+    ListType types[] = {ARRAY_LIST, LINKED_LIST};
+    for (int t = 0; t < 2; t++) {
+        for (int k = 0; k < sorter_count; k++) {
+            list *lst = create_list(types[t], 4, NULL);
+            for (int i = 0; i < COUNT; i++) {
+                lst->insert(lst, &values[i], i);
+            }
+            sorters[k]->sort(sorters[k], lst);
+            /* pdqsort is the one unstable sorter. */
+            int stable = k != 0;
+            /* Walk from the back too, so both node links are checked. */
+            for (int i = COUNT - 1; i >= 0; i--) {
+                void *got = lst->get(lst, i);
+                void *want = expected->get(expected, i);
+                ok &= stable ? got == want : int_compare(got, want) == 0;
+            }
+            int *sentinel = &values[0];
+            ok &= lst->insert(lst, sentinel, COUNT) == OVA_SUCCESS;
+            ok &= lst->get(lst, COUNT) == sentinel && lst->size(lst) == COUNT + 1;
+            ok &= lst->remove(lst, COUNT) == OVA_SUCCESS && lst->size(lst) == COUNT;
+            ok &= lst->remove(lst, 0) == OVA_SUCCESS && int_compare(lst->get(lst, 0), expected->get(expected, 1)) == 0;
+            lst->free(lst);
+        }
+    }
+    print_test_result(ok, "Sorters give merge-sort order on array and linked lists");
+
+    list *linked = create_list(LINKED_LIST, 4, NULL);
+    for (int i = 0; i < COUNT; i++) {
+        linked->insert(linked, &values[i], i);
+    }
+    sorters[0]->reverse(sorters[0], linked);
+    ok = 1;
+    for (int i = 0; i < COUNT; i++) {
+        ok &= linked->get(linked, i) == &values[COUNT - 1 - i];
+    }
+    sorters[0]->shuffle(sorters[0], linked);
+    sorters[0]->sort(sorters[0], linked);
+    ok &= linked->size(linked) == COUNT;
+    for (int i = 1; i < COUNT; i++) {
+        ok &= int_compare(linked->get(linked, i - 1), linked->get(linked, i)) <= 0;
+    }
+    print_test_result(ok, "Reverse, shuffle and sort keep a linked list intact");
+
+    linked->free(linked);
+    expected->free(expected);
+    for (int k = 0; k < sorter_count; k++) {
+        sorters[k]->free(sorters[k]);
+    }
+    free(values);
+}
+
+/* Value lists hold the ints themselves, so sorters must move bytes, not pointers. */
+void test_sorters_on_value_lists(void) {
+    enum { COUNT = 3000 };
+    int *values = malloc(COUNT * sizeof(int));
+    unsigned int state = 2718u;
+    for (int i = 0; i < COUNT; i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = (int)((state >> 8) % 500u);
+    }
+    sorter *sorters[] = {
+        create_sorter(int_compare),
+        create_merge_sorter(int_compare),
+        create_tim_sorter(int_compare),
+        create_parallel_sorter(int_compare, 2),
+        create_radix_sorter(int_compare, int_key),
+    };
+    const int sorter_count = (int)(sizeof(sorters) / sizeof(sorters[0]));
+
+    int ok = 1;
+    for (int k = 0; k < sorter_count; k++) {
+        list *lst = create_list_of(ARRAY_LIST, sizeof(int), 4);
+        for (int i = 0; i < COUNT; i++) {
+            lst->insert(lst, &values[i], i);
+        }
+        sorters[k]->sort(sorters[k], lst);
+        long long sum = 0;
+        for (int i = 0; i < COUNT; i++) {
+            sum += *(int *)lst->get(lst, i) - values[i];
+            if (i > 0) {
+                ok &= int_compare(lst->get(lst, i - 1), lst->get(lst, i)) <= 0;
+            }
+        }
+        ok &= lst->size(lst) == COUNT && sum == 0;
+        ok &= sorters[k]->binary_search(sorters[k], lst, &values[7]) >= 0;
+        lst->free(lst);
+    }
+    print_test_result(ok, "Sorters sort value lists in place");
+
+    list *lst = create_list_of(ARRAY_LIST, sizeof(int), COUNT);
+    for (int i = 0; i < COUNT; i++) {
+        lst->insert(lst, &values[i], i);
+    }
+    sorters[0]->reverse(sorters[0], lst);
+    ok = 1;
+    for (int i = 0; i < COUNT; i++) {
+        ok &= *(int *)lst->get(lst, i) == values[COUNT - 1 - i];
+    }
+    sorters[0]->shuffle(sorters[0], lst);
+    sorters[0]->sort(sorters[0], lst);
+    for (int i = 1; i < COUNT; i++) {
+        ok &= int_compare(lst->get(lst, i - 1), lst->get(lst, i)) <= 0;
+    }
+    print_test_result(ok && lst->size(lst) == COUNT, "Reverse, shuffle and sort keep a value list intact");
+
+    lst->free(lst);
+    for (int k = 0; k < sorter_count; k++) {
+        sorters[k]->free(sorters[k]);
+    }
+    free(values);
+}
+
+void test_selection_primitives(void) {
+    enum { COUNT = 3000, K = 25 };
+    int *values = malloc(COUNT * sizeof(int));
+    int *sorted = malloc(COUNT * sizeof(int));
+    unsigned int state = 2024u;
+    for (int i = 0; i < COUNT; i++) {
+        state = state * 1103515245u + 12345u;
+        values[i] = (int)((state >> 8) % 1000u);
+        sorted[i] = values[i];
+    }
+    qsort(sorted, COUNT, sizeof(int), int_compare);
+    sorter *s = create_sorter(int_compare);
+
+    int ok = 1;
+    ListType types[] = {ARRAY_LIST, LINKED_LIST};
+    for (int t = 0; t < 2; t++) {
+        list *lst = create_list(types[t], COUNT, NULL);
+        for (int i = 0; i < COUNT; i++) {
+            lst->insert(lst, &values[i], i);
+        }
+        s->partial_sort(s, lst, K);
+        for (int i = 0; i < K; i++) {
+            ok &= *(int *)lst->get(lst, i) == sorted[i];
+        }
+        ok &= lst->size(lst) == COUNT;
+
+        for (int nth = 0; nth < COUNT; nth += 599) {
+            s->nth_element(s, lst, nth);
+            int pivot = *(int *)lst->get(lst, nth);
+            ok &= pivot == sorted[nth];
+            for (int i = 0; i < COUNT; i++) {
+                int v = *(int *)lst->get(lst, i);
+                ok &= i < nth ? v <= pivot : v >= pivot;
+            }
+        }
+
+        void *top[K];
+        ok &= s->top_k(s, lst, K, top) == K;
+        for (int i = 0; i < K; i++) {
+            ok &= *(int *)top[i] == sorted[COUNT - 1 - i];
+        }
+        lst->free(lst);
+    }
+    print_test_result(ok, "partial_sort, nth_element and top_k agree with a full sort");
+
+    list *small = create_list(ARRAY_LIST, 4, NULL);
+    int few[] = {3, 1, 2};
+    for (int i = 0; i < 3; i++) {
+        small->insert(small, &few[i], i);
+    }
+    void *top[8];
+    ok = s->top_k(s, small, 8, top) == 3 && *(int *)top[0] == 3 && *(int *)top[2] == 1;
+    ok &= s->top_k(s, small, 0, top) == 0;
+    s->nth_element(s, small, 3);
+    s->partial_sort(s, small, 0);
+    ok &= small->get(small, 0) == &few[0];
+    s->partial_sort(s, small, 10);
+    ok &= *(int *)small->get(small, 0) == 1 && *(int *)small->get(small, 2) == 3;
+    print_test_result(ok, "Selection primitives handle k past the size and out-of-range indices");
+
+    small->free(small);
+    s->free(s);
+    free(sorted);
+    free(values);
+}
+
+void test_binary_search_batch(void) {
+    enum { COUNT = 4000, KEYS = 1001 };
+    int *values = malloc(COUNT * sizeof(int));
+    int *probes = malloc(KEYS * sizeof(int));
+    void **keys = malloc(KEYS * sizeof(void *));
+    int *out = malloc(KEYS * sizeof(int));
+    for (int i = 0; i < COUNT; i++) {
+        values[i] = (i / 3) * 2;  /* even keys, three copies each */
+    }
+    for (int i = 0; i < KEYS; i++) {
+        probes[i] = i * 3 - 5;
+        keys[i] = &probes[i];
+    }
+    sorter *s = create_sorter(int_compare);
+
+    int ok = 1;
+    ListType types[] = {ARRAY_LIST, LINKED_LIST};
+    for (int t = 0; t < 2; t++) {
+        list *lst = create_list(types[t], COUNT, NULL);
+        for (int i = 0; i < COUNT; i++) {
+            lst->insert(lst, &values[i], i);
+        }
+        int expected_found = 0;
+        int found = s->binary_search_batch(s, lst, keys, KEYS, out);
+        for (int i = 0; i < KEYS; i++) {
+            int expected = -1;
+            for (int j = 0; j < COUNT; j++) {
+                if (values[j] == probes[i]) {
+                    expected = j;
+                    break;
+                }
+            }
+            expected_found += expected >= 0;
+            ok &= out[i] == expected;
+        }
+        ok &= found == expected_found && found > 0;
+        lst->free(lst);
+    }
+    print_test_result(ok, "binary_search_batch returns the first match or -1 for every key");
+
+    list *empty = create_list(ARRAY_LIST, 1, NULL);
+    out[0] = 7;
+    ok = s->binary_search_batch(s, empty, keys, 1, out) == 0 && out[0] == -1;
+    ok &= s->binary_search_batch(s, empty, keys, 0, out) == 0;
+    ok &= s->binary_search_batch(s, empty, NULL, 1, out) == -1;
+    print_test_result(ok, "binary_search_batch handles empty lists and invalid arguments");
+
+    empty->free(empty);
+    s->free(s);
+    free(out);
+    free(keys);
+    free(probes);
+    free(values);
+}
+
+static int comparisons;
+
+static int counting_compare(const void *a, const void *b) {
+    comparisons++;
+    return int_compare(a, b);
+}
+
+void test_min_max_comparison_count(void) {
+    enum { COUNT = 1001 };
+    int values[COUNT];
+    list *lst = create_list(ARRAY_LIST, COUNT, NULL);
+    for (int i = 0; i < COUNT; i++) {
+        values[i] = (i * 7919) % COUNT;
+        lst->insert(lst, &values[i], i);
+    }
+    sorter *s = create_sorter(counting_compare);
+    void *min = NULL;
+    void *max = NULL;
+    comparisons = 0;
+    s->min_max(s, lst, &min, &max);
+    int ok = *(int *)min == 0 && *(int *)max == COUNT - 1;
+    ok &= comparisons <= 3 * COUNT / 2;
+    print_test_result(ok, "min_max needs at most 3n/2 comparisons");
+    s->free(s);
+    lst->free(lst);
+}
+
+void test_radix_sorter_string_keys(void) {
+    enum { COUNT = 3000, LEN = 48 };
+    char (*words)[LEN] = malloc(sizeof(char[LEN]) * COUNT);
+    void **items = malloc(COUNT * sizeof(void *));
+    sorter *s = create_string_radix_sorter(string_compare, string_key);
+    unsigned int state = 99u;
+    for (int i = 0; i < COUNT; i++) {
+        state = state * 1103515245u + 12345u;
+        int len = (int)((state >> 16) % 12);
+        int shared = i % 3 == 0 ? 30 : 0;
+        memset(words[i], 'p', (size_t)shared);
+        for (int j = 0; j < len; j++) {
+            state = state * 1103515245u + 12345u;
+            words[i][shared + j] = (char)(0x61 + (state >> 20) % 4 + (j == 2 ? 0x60 : 0));
+        }
+        words[i][shared + len] = '\0';
+        items[i] = words[i];
+    }
+
+    int ok = same_order_as_merge_sort(s, string_compare, items, COUNT);
+    ok &= same_order_as_merge_sort(s, string_compare, items, 20);
+    print_test_result(ok, "String radix sorter matches strcmp order, including shared prefixes");
+
+    s->free(s);
+    free(items);
+    free(words);
+}
+
 void run_all_tests(void) {
     test_sorter_sort();
     test_sorter_shuffle();
@@ -313,11 +862,23 @@ void run_all_tests(void) {
     test_sorter_large_sort();
     test_sorter_copy();
     test_sorter_min_max();
+    test_sorter_adversarial_patterns();
     test_merge_sorter_sort();
     test_merge_sort_empty_list();
     test_merge_sort_single_element();
     test_merge_sort_already_sorted();
     test_merge_sort_large();
+    test_parallel_sort_matches_merge_sort();
+    test_parallel_sort_small_and_default_threads();
+    test_radix_sorter_integer_keys();
+    test_radix_sorter_string_keys();
+    test_radix_sorter_without_comparator();
+    test_tim_sorter_matches_merge_sort();
+    test_sorters_on_array_and_linked_lists();
+    test_sorters_on_value_lists();
+    test_selection_primitives();
+    test_binary_search_batch();
+    test_min_max_comparison_count();
 }
 
 int main(void) {
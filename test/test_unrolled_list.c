@@ -0,0 +1,132 @@
+#include "base_test.h"
+#include "../include/list.h"
+
+/* Enough items for many node splits and merges. */
+enum { COUNT = 20000 };
+
+static int matches_model(list *lst, int *const *model, int n) {
+    if (lst->size(lst) != n) {
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        if (lst->get(lst, i) != model[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void model_insert(int **model, int *n, int index, int *value) {
+    for (int i = *n; i > index; i--) {
+        model[i] = model[i - 1];
+    }
+    model[index] = value;
+    (*n)++;
+}
+
+static void model_remove(int **model, int *n, int index) {
+    for (int i = index; i + 1 < *n; i++) {
+        model[i] = model[i + 1];
+    }
+    (*n)--;
+}
+
+static void test_unrolled_list_matches_array_model(void) {
+    int *data = malloc(COUNT * sizeof(int));
+    int **model = malloc(COUNT * sizeof(int *));
+    list *lst = create_list(UNROLLED_LIST, 0, NULL);
+    assert_not_null(lst);
+
+    /* Appends, then inserts at the front, back and random positions. */
+    unsigned int state = 4242u;
+    int n = 0;
+    int ok = 1;
+    for (int i = 0; i < COUNT && ok; i++) {
+        data[i] = i;
+        state = state * 1103515245u + 12345u;
+        int index = i < COUNT / 4 ? n : (int)((state >> 8) % (unsigned int)(n + 1));
+        if (i % 97 == 0) {
+            index = 0;
+        }
+        ok = lst->insert(lst, &data[i], index) == OVA_SUCCESS;
+        model_insert(model, &n, index, &data[i]);
+    }
+    print_test_result(ok && matches_model(lst, model, n), "Unrolled list inserts match an array model");
+
+    ok = 1;
+    for (int i = 0; i < 500 && ok; i++) {
+        state = state * 1103515245u + 12345u;
+        int index = (int)((state >> 8) % (unsigned int)n);
+        ok = lst->get(lst, index) == model[index];
+    }
+    ok &= lst->get(lst, -1) == NULL && lst->get(lst, n) == NULL;
+    ok &= lst->insert(lst, &data[0], n + 1) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    ok &= lst->insert(lst, &data[0], -1) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    print_test_result(ok, "Unrolled list get works at random indices and bounds are checked");
+
+    /* Remove most items from the front, back and middle to force merges,
+     * with inserts mixed in. */
+    ok = 1;
+    for (int step = 0; n > 100 && ok; step++) {
+        state = state * 1103515245u + 12345u;
+        unsigned int pick = (state >> 8) % 4u;
+        int index = pick == 0 ? 0 : pick == 1 ? n - 1 : (int)((state >> 12) % (unsigned int)n);
+        ok = lst->remove(lst, index) == OVA_SUCCESS;
+        model_remove(model, &n, index);
+        if (step % 5 == 0) {
+            ok &= lst->insert(lst, &data[n], n / 2) == OVA_SUCCESS;
+            model_insert(model, &n, n / 2, &data[n]);
+        }
+    }
+    ok &= matches_model(lst, model, n);
+    ok &= lst->remove(lst, n) == OVA_ERROR_INDEX_OUT_OF_BOUNDS;
+    print_test_result(ok, "Unrolled list removes keep order and indexing");
+
+    ok = lst->remove_range(lst, 10, n - 10) == OVA_SUCCESS;
+    while (n > 20) {
+        model_remove(model, &n, 10);
+    }
+    ok &= matches_model(lst, model, n);
+    ok &= lst->remove_range(lst, 0, n) == OVA_SUCCESS && lst->size(lst) == 0 && lst->get(lst, 0) == NULL;
+    ok &= lst->insert(lst, &data[0], 0) == OVA_SUCCESS && lst->get(lst, 0) == &data[0];
+    print_test_result(ok, "Unrolled list is reusable after removing everything");
+
+    lst->free(lst);
+    free(model);
+    free(data);
+}
+
+static void test_unrolled_list_clear_and_clone(void) {
+    int data[3000];
+    list *lst = create_list(UNROLLED_LIST, 0, NULL);
+    assert_not_null(lst);
+    for (int i = 0; i < 3000; i++) {
+        data[i] = i;
+        lst->insert(lst, &data[i], i);
+    }
+
+    list *copy = lst->clone_shallow(lst);
+    int ok = copy != NULL && copy->size(copy) == 3000;
+    for (int i = 0; ok && i < 3000; i++) {
+        ok = copy->get(copy, i) == &data[i];
+    }
+    print_test_result(ok, "Unrolled list clone_shallow copies order and pointers");
+
+    lst->clear(lst);
+    ok = lst->size(lst) == 0 && copy->size(copy) == 3000;
+    ok &= lst->insert(lst, &data[5], 0) == OVA_SUCCESS && lst->size(lst) == 1;
+    print_test_result(ok, "Unrolled list clear empties it");
+
+    copy->free(copy);
+    lst->free(lst);
+}
+
+static void run_all_tests(void) {
+    test_unrolled_list_matches_array_model();
+    test_unrolled_list_clear_and_clone();
+}
+
+int main(void) {
+    run_all_tests();
+    return 0;
+}